@@ -45,9 +45,25 @@ struct AssetManagerEnv
 struct AssetManagerInfo
 {
     AssetManagerEnv env; // initial environment
+    FS::Path packPath;   // optional asset pack file, asset files are read from the pack instead of the storage directory
     bool watchAssets;    // whether to watch asset files in project
 };
 
+/// @brief Handle to a group of asset load jobs. Each batch tracks only its own jobs,
+///        so batches may overlap with each other and with unrelated jobs.
+struct AssetLoadBatch : Handle<struct AssetLoadBatchObj>
+{
+    /// @brief Check if all load jobs in the batch have completed. Does not block.
+    bool is_complete();
+
+    /// @brief Get normalized progress of load jobs in the batch. Does not block.
+    /// @return Progress in [0, 1], 1 if the batch has no load jobs.
+    float get_progress();
+
+    /// @brief Get assets of the batch that are successfully loaded so far. Does not block.
+    void get_loaded_assets(Vector<Asset>& outAssets);
+};
+
 /// @brief Asset manager singleton, main thread only.
 struct AssetManager : Handle<struct AssetManagerObj>
 {
@@ -73,15 +89,27 @@ struct AssetManager : Handle<struct AssetManagerObj>
     /// @brief Append a load job to current patch.
     void load_asset(AssetID id);
 
-    /// @brief Begin asset load batch.
+    /// @brief Begin asset load batch, load jobs are appended to this batch until it is submitted or ended.
     void begin_load_batch();
 
-    /// @brief End asset load batch.
+    /// @brief Close the current batch without blocking. Another batch may begin while this one is in flight.
+    /// @return Handle to poll the batch, must be passed to end_load_batch later.
+    AssetLoadBatch submit_load_batch();
+
+    /// @brief End current asset load batch, blocks until its load jobs complete.
     bool end_load_batch(Vector<AssetLoadStatus>& outErrors);
 
-    /// @brief Check if there are any load jobs in progress. Does not block.
+    /// @brief End a submitted asset load batch, blocks until its load jobs complete.
+    ///        The batch handle is invalidated.
+    bool end_load_batch(AssetLoadBatch batch, Vector<AssetLoadStatus>& outErrors);
+
+    /// @brief Check if there are any load jobs in progress across all batches. Does not block.
     bool has_load_job();
 
+    /// @brief Get normalized progress of load jobs across all batches. Does not block.
+    /// @return Progress in [0, 1], 1 if there are no load jobs.
+    float get_load_progress();
+
     /// @brief Get asset ID from name
     AssetID get_id_from_name(const char* name, AssetType* outType);
 
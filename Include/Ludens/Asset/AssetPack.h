@@ -0,0 +1,83 @@
+#pragma once
+
+#include <Ludens/Asset/AssetDef.h>
+#include <Ludens/DSA/String.h>
+#include <Ludens/Header/Handle.h>
+#include <Ludens/Header/View.h>
+#include <Ludens/System/FileSystem.h>
+
+#include <cstdint>
+
+// first four bytes of any Ludens Asset Pack file.
+#define LD_ASSET_PACK_MAGIC "LDP."
+#define LD_ASSET_PACK_VERSION 1
+#define LD_ASSET_PACK_ALIGNMENT 64
+#define LD_ASSET_PACK_DEFAULT_FILE_NAME "assets.ldp"
+
+namespace LD {
+
+enum AssetPackCompression : uint32_t
+{
+    ASSET_PACK_COMPRESSION_NONE = 0,
+    ASSET_PACK_COMPRESSION_LZ4,
+    ASSET_PACK_COMPRESSION_ZSTD,
+};
+
+/// @brief Table of contents entry, one per asset file.
+///        Files of an asset are keyed by their asset registry file path key.
+struct AssetPackEntry
+{
+    AssetID id;
+    uint32_t keyHash;                  /// FNV-1a hash of the file path key
+    AssetPackCompression compression;  /// how the payload is stored
+    uint64_t offset;                   /// payload byte offset from start of pack, aligned to LD_ASSET_PACK_ALIGNMENT
+    uint64_t size;                     /// stored payload size
+    uint64_t rawSize;                  /// payload size after decompression
+};
+
+/// @brief Read-only asset pack backed by a single file mapping.
+///        Entries are sorted by asset ID and key hash for binary search.
+struct AssetPack : Handle<struct AssetPackObj>
+{
+    /// @brief Map and validate an asset pack file.
+    /// @return Pack handle on success, or a null handle with error message.
+    static AssetPack create(const FS::Path& path, String& err);
+
+    /// @brief Unmap asset pack, views into the pack are invalidated.
+    static void destroy(AssetPack pack);
+
+    /// @brief Find a file of an asset.
+    /// @param key Asset registry file path key, such as LD_ASSET_DEFAULT_BINARY_FILE_KEY.
+    /// @return Entry of the file, or null if the asset does not have such file.
+    const AssetPackEntry* find(AssetID id, const char* key);
+
+    /// @brief Get stored payload of an entry, valid until the pack is destroyed.
+    ///        Compressed payloads must go through unpack instead.
+    View get_payload(const AssetPackEntry* entry);
+
+    /// @brief Decompress or copy payload of an entry.
+    /// @param dst Destination of at least entry rawSize bytes.
+    /// @return False with error message if the payload does not decompress to entry rawSize bytes.
+    bool unpack(const AssetPackEntry* entry, MutView dst, String& err);
+
+    /// @brief Get number of files in pack.
+    size_t get_entry_count();
+};
+
+/// @brief Collects asset files in memory and writes them as a single pack file.
+struct AssetPackWriter : Handle<struct AssetPackWriterObj>
+{
+    static AssetPackWriter create();
+    static void destroy(AssetPackWriter writer);
+
+    /// @brief Add a file of an asset, data is compressed or copied immediately.
+    ///        Files that do not shrink under compression are stored uncompressed.
+    /// @param key Asset registry file path key, unique within the asset.
+    void add_file(AssetID id, const char* key, View data, AssetPackCompression compression);
+
+    /// @brief Sort table of contents and write pack file, payloads are streamed to the
+    ///        file after the table of contents without another copy in memory.
+    bool write(const FS::Path& path, String& err);
+};
+
+} // namespace LD
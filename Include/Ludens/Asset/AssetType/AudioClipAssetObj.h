@@ -10,7 +10,7 @@ struct AudioClipAssetObj : AssetObj
 {
     AudioData data = {};
 
-    bool load_from_binary(AssetLoadJob& job, const FS::Path& filePath);
+    bool load_from_binary(AssetLoadJob& job);
 
     static void create(AssetObj* base);
     static void destroy(AssetObj* base);
@@ -13,7 +13,7 @@ struct FontAssetObj : AssetObj
     FontAtlas fontAtlas = {};
     float fontSize = 0.0f;
 
-    bool load_from_binary(AssetLoadJob& job, const FS::Path& filePath);
+    bool load_from_binary(AssetLoadJob& job);
 
     static void create(AssetObj* base);
     static void destroy(AssetObj* base);
@@ -25,7 +25,11 @@ struct LuaScriptAsset : Asset
     /// @brief Get Lua script source string.
     View get_source();
 
-    /// @brief Set Lua script source string.
+    /// @brief Get LuaJIT bytecode baked from source by the asset builder.
+    /// @return Bytecode view, or an empty view if the script should be compiled from source.
+    View get_bytecode();
+
+    /// @brief Set Lua script source string, discarding any baked bytecode.
     /// @note This only modifies the asset in RAM.
     void set_source(View source);
 };
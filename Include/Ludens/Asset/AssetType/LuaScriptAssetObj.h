@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Ludens/Asset/AssetType/LuaScriptAsset.h>
+#include <Ludens/DSA/Buffer.h>
 
 namespace LD {
 
@@ -10,9 +11,10 @@ struct LuaScriptAssetObj : AssetObj
 {
     String sourcePath;           /// lua script file path
     String source;               /// lua source code string, if found
+    Buffer bytecode;             /// LuaJIT bytecode baked from source, empty if not baked or out of date
     LuaScriptDomain domain = {}; /// intended script domain
 
-    bool load_from_binary(AssetLoadJob& job, const FS::Path& filePath);
+    bool load_from_binary(AssetLoadJob& job);
 
     static void create(AssetObj* base);
     static void destroy(AssetObj* base);
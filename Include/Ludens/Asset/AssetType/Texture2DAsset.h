@@ -13,6 +13,9 @@ enum TextureCompression
 {
     /// @brief LZ4 compressed bitmap
     TEXTURE_COMPRESSION_LZ4 = 0,
+
+    /// @brief Uncompressed bitmap, larger on disk but copied as is
+    TEXTURE_COMPRESSION_NONE,
 };
 
 extern struct TypeMeta gTexture2DPropMetaTable;
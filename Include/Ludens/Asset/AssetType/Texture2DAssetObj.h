@@ -16,13 +16,15 @@ struct Texture2DAssetObj : AssetObj
 {
     RSamplerInfo samplerHint = {};
     Bitmap bitmap = {};
-    Vector<byte> serialData; // entire LDA file mapped
+    FS::FileMapping fileMapping = {}; // entire LDA file mapped, owns fileView after loading
+    byte* unpackData = nullptr;       // decompressed LDA file from asset pack, owns fileView after loading
     View fileView = {};
 
-    bool load_from_binary(AssetLoadJob& job, const FS::Path& filePath);
+    bool load_from_binary(AssetLoadJob& job);
 
     static bool serialize(Serializer& serial, const Texture2DAssetObj& obj);
     static void serialize_sampler_info(Serializer& serial, const RSamplerInfo& sampler);
+    static void serialize_mip_chain(Serializer& serial, Bitmap base, BitmapCompression compression);
     static bool deserialize(Deserializer& serial, Texture2DAssetObj& obj);
     static void create(AssetObj* base);
     static void destroy(AssetObj* base);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Ludens/DSA/HeapStorage.h>
+#include <Ludens/Memory/Allocator.h>
 
 #include <utility>
 #include <vector>
@@ -10,6 +11,10 @@ namespace LD {
 template <typename T>
 using Vector = std::vector<T>;
 
+/// @brief Transient vector allocated from the frame arena, valid until the end of the next frame.
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
 #if 0
 /// @brief small vector optimization via local storage
 /// @tparam T element type, must be default-constructable
@@ -86,6 +86,9 @@ struct DataRegistry : Handle<struct DataRegistryObj>
     /// @brief Get an iterator to traverse all components of a specific type.
     PoolAllocator::Iterator get_components(ComponentType type);
 
+    /// @brief Get the number of components of a specific type.
+    size_t get_component_count(ComponentType type);
+
     /// @brief Get a path of sibling indices.
     /// @return True on success.
     /// @note Slower code path intended for editor, sibling indices are calculated on the fly.
@@ -107,6 +110,22 @@ struct DataRegistry : Handle<struct DataRegistryObj>
     /// @return True on success.
     bool set_component_transform_2d(CUID compID, const Transform2D& transform);
 
+    /// @brief Copy the local transforms of many data components into contiguous storage.
+    /// @param compIDs Data component IDs, count entries.
+    /// @param transforms Output transforms, entries of components without a 2D transform are left untouched.
+    /// @return Number of transforms copied.
+    size_t get_component_transforms_2d(const CUID* compIDs, Transform2D* transforms, size_t count);
+
+    /// @brief Write back the local transforms of many data components and mark them dirty in bulk.
+    /// @param compIDs Data component IDs, count entries.
+    /// @param transforms Input transforms, entries of components without a 2D transform are skipped.
+    /// @return Number of transforms written.
+    size_t set_component_transforms_2d(const CUID* compIDs, const Transform2D* transforms, size_t count);
+
+    /// @brief Mark the local transform of a data component as modified through its raw address,
+    ///        so the world matrices of the component and its descendants are recomputed.
+    void mark_component_transform_dirty(CUID compID);
+
     /// @brief Get the Mat4 model matrix of a data component.
     /// @param compID Component ID to query.
     /// @param mat4 Output world space model matrix.
@@ -115,8 +134,12 @@ struct DataRegistry : Handle<struct DataRegistryObj>
 
     bool get_component_world_transform_2d(CUID compID, Transform2D& transform);
 
+    /// @brief Recompute world matrices of transforms modified since the last invalidation.
     void invalidate_transforms();
 
+    /// @brief Get the number of world matrices recomputed by the last invalidate_transforms().
+    size_t get_transform_recomputed_count();
+
     String print_hierarchy();
 };
 
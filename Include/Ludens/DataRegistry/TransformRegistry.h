@@ -4,6 +4,7 @@
 #include <Ludens/DSA/IDRegistry.h>
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/Header/Math/Mat4.h>
+#include <Ludens/Header/SIMD.h>
 #include <Ludens/Memory/Allocator.h>
 
 namespace LD {
@@ -21,8 +22,39 @@ public:
 
     Transform2DRegistry& operator=(const Transform2DRegistry&) = delete;
 
+    /// @brief Propagate world matrices depth by depth. Only entries marked dirty since the
+    ///        last invalidation and their descendants are recomputed. Depth levels at least
+    ///        as wide as the parallel threshold are split across JobSystem workers, with a barrier
+    ///        between levels since children read the world matrix of their parents.
     void invalidate_transforms();
 
+    /// @brief Mark the local transform of an entry as modified, the entry and all of its
+    ///        descendants are recomputed in the next invalidation.
+    /// @note Required after writing through the Transform2D address returned by create().
+    void mark_dirty(ID id);
+
+    /// @brief Get the number of world matrices recomputed in the last invalidation.
+    inline size_t get_recomputed_count() const
+    {
+        return mRecomputedCount;
+    }
+
+    /// @brief Set the minimum depth level width to propagate on JobSystem workers,
+    ///        narrower levels stay on the calling thread to avoid dispatch overhead.
+    inline void set_parallel_threshold(size_t threshold)
+    {
+        mParallelThreshold = threshold;
+    }
+
+    /// @brief Set the instruction set of world matrix kernels, clamped to what the CPU supports.
+    ///        Defaults to the highest supported level, SIMD_LEVEL_SCALAR selects the Mat4 reference path.
+    void set_simd_level(SIMDLevel level);
+
+    inline SIMDLevel get_simd_level() const
+    {
+        return mSIMDLevel;
+    }
+
     bool has_transform(ID id);
     void set_transform(ID id, const Transform2D& transform);
 
@@ -56,16 +88,26 @@ private:
     struct Depth
     {
         Vector<Entry> local;
+        Vector<float> laneF32;    // SIMD staging, 6 float lanes as wide as the depth level
+        Vector<uint32_t> laneU32; // SIMD staging, 2 sparse index lanes as wide as the depth level
     };
 
     void reserve_depth(int depth);
+    size_t invalidate_depth_range(size_t depthLevel, size_t begin, size_t end);
+    size_t invalidate_depth_range_lanes(size_t depthLevel, size_t begin, size_t end);
     Transform2D* swap_and_pop(ID popID);
 
 private:
     Vector<Depth*> mDepth;
     Vector<Sparse> mSparse;
     Vector<Mat4> mWorldMat4;
+    Vector<uint32_t> mDirtyEpoch; // entry is dirty if equal to mEpoch
     PoolAllocator mTransformPA{};
+    size_t mParallelThreshold;
+    SIMDLevel mSIMDLevel;
+    size_t mDirtyCount = 0;
+    size_t mRecomputedCount = 0;
+    uint32_t mEpoch = 1;
 };
 
 } // namespace LD
\ No newline at end of file
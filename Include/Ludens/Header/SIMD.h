@@ -19,4 +19,53 @@
 # include <xmmintrin.h>
 #endif
 
+// functions using instruction sets above the compile time baseline,
+// callers must check get_cpu_simd_level() before calling them.
+#if defined(_MSC_VER) && !defined(__clang__)
+# define LD_TARGET_AVX2
+#else
+# define LD_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+#if defined(LD_ARCH_X64) && defined(_MSC_VER)
+# include <intrin.h>
+#endif
+
 // clang-format on
+
+namespace LD {
+
+/// @brief Instruction set levels selectable at runtime, in ascending order.
+enum SIMDLevel
+{
+    SIMD_LEVEL_SCALAR = 0,
+    SIMD_LEVEL_SSE2,
+    SIMD_LEVEL_AVX2,
+};
+
+/// @brief Detect the highest instruction set level supported by the running CPU and OS.
+inline SIMDLevel get_cpu_simd_level()
+{
+#if defined(LD_ARCH_X64) && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    int maxLeaf = info[0];
+
+    __cpuid(info, 1);
+    bool hasOSXSAVE = (info[2] & (1 << 27)) != 0;
+    bool hasAVX = (info[2] & (1 << 28)) != 0;
+
+    // OS must save YMM registers on context switch
+    if (maxLeaf < 7 || !hasOSXSAVE || !hasAVX || (_xgetbv(0) & 0x6) != 0x6)
+        return SIMD_LEVEL_SSE2;
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) ? SIMD_LEVEL_AVX2 : SIMD_LEVEL_SSE2;
+#elif defined(LD_ARCH_X64)
+    return __builtin_cpu_supports("avx2") ? SIMD_LEVEL_AVX2 : SIMD_LEVEL_SSE2;
+#else
+    return SIMD_LEVEL_SCALAR;
+#endif
+}
+
+} // namespace LD
@@ -1,8 +1,10 @@
 #pragma once
 
 #include <Ludens/Header/Handle.h>
+#include <atomic>
 #include <cstdint>
 #include <cstdlib>
+#include <type_traits>
 
 namespace LD {
 
@@ -14,22 +16,51 @@ enum JobDispatchType
 
 typedef void (*JobFn)(void* user);
 
+/// @brief Range callback for JobSystem::parallel_for, processes indices in [begin, end).
+typedef void (*JobRangeFn)(size_t begin, size_t end, void* user);
+
+/// @brief Counts outstanding jobs of a group. Jobs submitted with JobHeader::counter
+///        increment the counter upon submission and decrement it after completion.
+///        Continuations registered on a counter are submitted once it reaches zero.
+/// @warning Address of the counter must not change until all jobs and continuations
+///          referring to it have completed.
+struct JobCounter
+{
+    std::atomic<uint32_t> value{0};                              // number of outstanding jobs
+    std::atomic<uint32_t> signaling{0};                          // threads still accessing the counter after a decrement
+    std::atomic<struct JobContinuation*> continuations{nullptr}; // jobs to submit once value reaches zero
+
+    /// @brief check if all jobs in the group have completed and the counter is no longer accessed
+    inline bool is_zero() const
+    {
+        return value.load(std::memory_order_acquire) == 0 && signaling.load(std::memory_order_acquire) == 0;
+    }
+};
+
 struct JobHeader
 {
     uint32_t type;
-    JobFn onExecute;  // job body, runs on worker thread
-    JobFn onComplete; // optional hook, runs on worker thread after job body
-    void* user;       // dependency injection during callbacks
+    JobFn onExecute;     // job body, runs on worker thread
+    JobFn onComplete;    // optional hook, runs on worker thread after job body
+    void* user;          // dependency injection during callbacks
+    JobCounter* counter; // optional counter, decremented after onComplete
 };
 
 struct JobSystemInfo
 {
     size_t immediateQueueCapacity;
     size_t standardQueueCapacity;
+    size_t workerDequeCapacity; /// capacity of each per-worker deque in work stealing mode, defaults to standardQueueCapacity
+    bool enableWorkStealing;    /// jobs submitted from worker threads go to per-worker lock-free deques, idle workers steal from others
+    size_t workerThreadCount;   /// number of worker threads, defaults to hardware concurrency minus the main thread
 };
 
 /// @brief Thread-based Job System, using one main thread and multiple worker threads.
-///        All threads may create new jobs, but only the main thread can wait for jobs to finish.
+///        All threads may create new jobs, but only the main thread can wait for all jobs to finish.
+///        Any thread may wait on a JobCounter, executing other pending jobs in the meantime.
+///        In work stealing mode, jobs submitted from the main thread still go through the shared
+///        immediate and standard queues, while jobs submitted from worker threads are pushed
+///        to the worker's own deque. Immediate jobs are always searched before standard jobs.
 struct JobSystem : Handle<struct JobSystemObj>
 {
     static void init(const JobSystemInfo& info);
@@ -48,10 +79,49 @@ struct JobSystem : Handle<struct JobSystemObj>
     ///          lead to deadlocks.
     void wait_all();
 
+    /// @brief wait until the counter reaches zero, the calling thread executes
+    ///        other pending jobs instead of blocking. Safe to call from worker threads.
+    void wait(JobCounter* counter);
+
     void submit(const JobHeader* job, JobDispatchType type);
 
+    /// @brief Submit a job once the dependency counter reaches zero, the job is submitted
+    ///        right away if the dependency is already zero. For fan-in dependencies, submit
+    ///        jobs A1..An with the same counter, then register job B as its continuation.
+    ///        The job's own counter is incremented immediately, so waiting on it also
+    ///        waits for the continuation to complete.
+    /// @param job the continuation job, copied upon registration
+    /// @param type dispatch type used once the dependency is satisfied
+    /// @param dependency counter to wait on
+    void submit_continuation(const JobHeader* job, JobDispatchType type, JobCounter* dependency);
+
+    /// @brief Split [begin, end) into contiguous chunks processed by worker threads.
+    ///        The calling thread processes the first chunk and helps with other pending jobs
+    ///        until the whole range is complete. Safe to call from worker threads.
+    ///        Ranges no larger than grain are processed inline without touching any queue.
+    /// @param begin first index of the range
+    /// @param end one past the last index of the range
+    /// @param grain minimum number of indices per chunk, clamped to at least 1
+    /// @param fn range callback, invoked once per chunk, possibly concurrently
+    /// @param user user data supplied to the callback
+    void parallel_for(size_t begin, size_t end, size_t grain, JobRangeFn fn, void* user);
+
+    /// @brief Convenience overload for callables with signature void(size_t begin, size_t end).
+    template <typename TFn>
+    void parallel_for(size_t begin, size_t end, size_t grain, TFn&& fn)
+    {
+        using TCallable = std::remove_reference_t<TFn>;
+
+        JobRangeFn trampoline = [](size_t chunkBegin, size_t chunkEnd, void* user) {
+            (*(TCallable*)user)(chunkBegin, chunkEnd);
+        };
+
+        parallel_for(begin, end, grain, trampoline, (void*)&fn);
+    }
+
     /// @brief Move jobs of the specified type to the very front of each job queue.
     ///        Note that the immediate queue still takes priority over other queues.
+    ///        Worker deques are reordered lazily by their owning worker thread.
     /// @param type the job type to prioritize
     void prioritize(uint32_t type);
 };
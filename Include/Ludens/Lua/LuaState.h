@@ -79,8 +79,9 @@ public:
     /// @brief Dump lua source code to bytecode. Does not modify stack.
     /// @param str Null-terminated Lua 5.1 source code.
     /// @param buffer Output lua chunk bytecode.
+    /// @param name Chunk name recorded in debug info, or null to use the source string.
     /// @return True on success.
-    bool dump(const char* str, Buffer& buffer);
+    bool dump(const char* str, Buffer& buffer, const char* name = nullptr);
 
     /// @brief Load chunk from buffer.
     /// @param buf Buffer to read bytes from.
@@ -99,6 +100,35 @@ public:
     /// @return true on success
     bool do_file(const char* filepath);
 
+    /// @brief Stop the automatic garbage collector, memory is then only reclaimed by gc_step() or gc_collect().
+    void gc_stop();
+
+    /// @brief Restart the automatic garbage collector.
+    void gc_restart();
+
+    /// @brief Perform a full garbage collection cycle.
+    void gc_collect();
+
+    /// @brief Perform an incremental garbage collection step.
+    /// @param stepKB Step size, larger steps do more work. Zero performs a single basic step.
+    /// @return True if the step finished a collection cycle.
+    bool gc_step(int stepKB);
+
+    /// @brief Set the collector pause in percent, the collector waits for memory
+    ///        to grow by this ratio after a cycle before starting a new one.
+    /// @return Previous pause.
+    int gc_set_pause(int pause);
+
+    /// @brief Set the collector step multiplier in percent, the speed of the collector relative to allocation.
+    /// @return Previous step multiplier.
+    int gc_set_step_multiplier(int stepMultiplier);
+
+    /// @brief Get byte size currently allocated by this state.
+    size_t get_memory_size();
+
+    /// @brief Get peak byte size allocated by this state since creation.
+    size_t get_peak_memory_size();
+
     /// @brief pushes onto the stack the value of the global
     /// @param name name of the global
     void get_global(const char* name);
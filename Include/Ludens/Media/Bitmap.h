@@ -25,6 +25,9 @@ enum BitmapCompression
 {
     /// @brief Use LZ4 for serialization
     BITMAP_COMPRESSION_LZ4 = 0,
+
+    /// @brief Serialize raw pixels
+    BITMAP_COMPRESSION_NONE,
 };
 
 /// @brief Read only view of bitmap data.
@@ -49,6 +52,11 @@ struct Bitmap : Handle<struct BitmapObj>
     static Bitmap create_from_file_data(uint32_t fileSize, const void* fileData);
     static inline Bitmap create_from_file_data(View fileView) { return create_from_file_data((uint32_t)fileView.size, fileView.data); }
 
+    /// @brief Create bitmap of half width and height with a 2x2 box filter,
+    ///        odd dimensions are rounded down with a minimum of one pixel.
+    ///        Only supports formats with uint8_t channels.
+    static Bitmap create_half_size(const Bitmap& src);
+
     /// @brief create 6 layered bitmap from 6 paths to each face
     /// @param paths an array of 6 paths
     static Bitmap create_cubemap_from_paths(const char** paths);
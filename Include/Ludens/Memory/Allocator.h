@@ -4,6 +4,11 @@
 #include <Ludens/Header/Types.h>
 #include <Ludens/Memory/Memory.h>
 
+#include <cstddef>
+#include <source_location>
+
+#define SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE 512
+
 namespace LD {
 
 struct LinearAllocatorInfo
@@ -17,20 +22,23 @@ struct LinearAllocator : Handle<struct LinearAllocatorObj>
 {
     /// @brief create a linear allocator
     /// @param info linear allocator configuration info
+    /// @param site call site recorded by heap tracking, defaults to the caller
     /// @return allocator handle
-    static LinearAllocator create(const LinearAllocatorInfo& info);
+    static LinearAllocator create(const LinearAllocatorInfo& info, std::source_location site = std::source_location::current());
 
     /// @brief destroy the linear allocator, previous calls to allocate() are all freed.
     static void destroy(LinearAllocator allocator);
 
     /// @brief allocate bytes
     /// @param size number of bytes requested
-    void* allocate(size_t size);
+    /// @param site call site recorded by heap tracking if a new page is allocated
+    void* allocate(size_t size, std::source_location site = std::source_location::current());
 
     /// @brief Allocate bytes with alignment.
     /// @param size Byte size requested.
     /// @param alignment Byte alignment.
-    void* allocate_aligned(size_t size, size_t alignment);
+    /// @param site Call site recorded by heap tracking if a new page is allocated.
+    void* allocate_aligned(size_t size, size_t alignment, std::source_location site = std::source_location::current());
 
     /// @brief frees all previous allocate() calls in one go.
     void free();
@@ -62,15 +70,17 @@ struct PoolAllocator : Handle<struct PoolAllocatorObj>
 {
     /// @brief create a pool allocator
     /// @param info pool allocator configuration info
+    /// @param site call site recorded by heap tracking, defaults to the caller
     /// @return allocator handle
-    static PoolAllocator create(const PoolAllocatorInfo& info);
+    static PoolAllocator create(const PoolAllocatorInfo& info, std::source_location site = std::source_location::current());
 
     /// @brief destroy the pool allocator, all block allocations by allocate() will be freed.
     static void destroy(PoolAllocator allocator);
 
     /// @brief allocate a block
+    /// @param site call site recorded by heap tracking if a new page is allocated
     /// @return a new block of memory
-    void* allocate();
+    void* allocate(std::source_location site = std::source_location::current());
 
     /// @brief free a block
     /// @param block a block returned from allocate()
@@ -79,6 +89,9 @@ struct PoolAllocator : Handle<struct PoolAllocatorObj>
     /// @brief number of pages allocated
     size_t page_count() const;
 
+    /// @brief number of blocks allocated across all pages
+    size_t block_count() const;
+
     /// @brief Iterator to traverse all allocated blocks linearly.
     /// @warning Do not allocate or free blocks when iterating through the pool.
     class Iterator
@@ -108,4 +121,134 @@ struct PoolAllocator : Handle<struct PoolAllocatorObj>
     Iterator begin();
 };
 
+struct SizeClassAllocatorInfo
+{
+    MemoryUsage usage; /// the usage space of all pages and large blocks
+    size_t pageSize;   /// page capacity in bytes, small blocks of all size classes are carved from pages
+};
+
+/// @brief Pools of headerless blocks in 16-byte size classes, for callers that know the
+///        size of a block when freeing it. Blocks up to SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE
+///        are recycled through per-class free lists, larger blocks go to the general heap.
+///        All blocks are 16-byte aligned. Not thread safe.
+struct SizeClassAllocator : Handle<struct SizeClassAllocatorObj>
+{
+    /// @brief create a size class allocator
+    /// @param info size class allocator configuration info
+    /// @param site call site recorded by heap tracking, defaults to the caller
+    /// @return allocator handle
+    static SizeClassAllocator create(const SizeClassAllocatorInfo& info, std::source_location site = std::source_location::current());
+
+    /// @brief Destroy the allocator, all blocks are released wholesale without being freed individually.
+    static void destroy(SizeClassAllocator allocator);
+
+    /// @brief Allocate a block.
+    /// @param size Byte size requested, must not be zero.
+    /// @param site Call site recorded by heap tracking if a page or large block is allocated.
+    void* allocate(size_t size, std::source_location site = std::source_location::current());
+
+    /// @brief Resize a block, the contents are preserved up to the smaller size.
+    /// @param block A block from allocate(), or null to allocate.
+    /// @param oldSize Byte size the block was allocated or last resized with.
+    /// @param newSize New byte size, must not be zero.
+    /// @param site Call site recorded by heap tracking if a page or large block is allocated.
+    void* reallocate(void* block, size_t oldSize, size_t newSize, std::source_location site = std::source_location::current());
+
+    /// @brief Free a block.
+    /// @param block A block from allocate().
+    /// @param size Byte size the block was allocated or last resized with.
+    void free(void* block, size_t size);
+
+    /// @brief number of pages allocated
+    size_t page_count() const;
+
+    /// @brief Currently allocated byte size, as requested by callers.
+    size_t size() const;
+
+    /// @brief Peak allocated byte size since creation.
+    size_t peak_size() const;
+};
+
+struct FrameArenaInfo
+{
+    MemoryUsage usage; /// the usage space of arena pages
+    size_t pageSize;   /// page capacity in bytes, larger requests get a dedicated page for the frame
+};
+
+/// @brief Double-buffered, per-thread scratch arena singleton for transient per-frame data.
+///        Each thread allocates from its own buffer without locking. An allocation stays valid
+///        until the end of the frame after the one it was made in, so data produced in a frame
+///        may still be consumed during the next one. Pages are retained across frames.
+struct FrameArena : Handle<struct FrameArenaObj>
+{
+    /// @brief Create frame arena singleton.
+    /// @param info Frame arena configuration info.
+    /// @param site Call site recorded by heap tracking, defaults to the caller.
+    static FrameArena create(const FrameArenaInfo& info, std::source_location site = std::source_location::current());
+
+    /// @brief Destroy frame arena singleton, all allocations from all threads are freed.
+    static void destroy();
+
+    /// @brief Get singleton handle, null if the arena does not exist.
+    static FrameArena get();
+
+    /// @brief Begin the next frame, called once per frame by the main loop.
+    ///        Buffers from two frames ago are recycled by their threads on their next allocation.
+    void next_frame();
+
+    /// @brief Index of the current frame, starting from zero.
+    uint64_t frame_index() const;
+
+    /// @brief Allocate bytes from the calling thread's buffer of the current frame.
+    /// @param size Byte size requested.
+    /// @param alignment Byte alignment, must be a power of two.
+    /// @param site Call site recorded by heap tracking if a new page is allocated.
+    void* allocate(size_t size, size_t alignment = alignof(std::max_align_t), std::source_location site = std::source_location::current());
+
+    /// @brief Total bytes served by the arena instead of the general heap.
+    size_t bytes_saved() const;
+};
+
+/// @brief STL allocator adapter over the frame arena singleton. Falls back to the general
+///        heap if no frame arena exists, arena memory is never freed individually.
+/// @warning Containers using this allocator must not outlive the next frame.
+template <typename T>
+struct FrameAllocator
+{
+    using value_type = T;
+
+    FrameArena arena;
+
+    FrameAllocator()
+        : arena(FrameArena::get())
+    {
+    }
+
+    template <typename U>
+    FrameAllocator(const FrameAllocator<U>& other)
+        : arena(other.arena)
+    {
+    }
+
+    T* allocate(size_t n)
+    {
+        if (arena)
+            return (T*)arena.allocate(sizeof(T) * n, alignof(T));
+
+        return (T*)heap_malloc(sizeof(T) * n, MEMORY_USAGE_MISC);
+    }
+
+    void deallocate(T* ptr, size_t)
+    {
+        if (!arena)
+            heap_free(ptr);
+    }
+
+    template <typename U>
+    bool operator==(const FrameAllocator<U>& other) const
+    {
+        return (const FrameArenaObj*)arena == (const FrameArenaObj*)other.arena;
+    }
+};
+
 } // namespace LD
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <cstdint>
 #include <cstdlib>
 #include <new>
+#include <source_location>
 #include <utility>
 
 namespace LD {
@@ -34,10 +35,63 @@ struct MemoryProfile
     std::size_t current;
 };
 
+/// @brief Memory usage with the call site of a heap allocation. Converts implicitly from
+///        MemoryUsage, so the call site is captured where heap functions are called.
+struct MemoryUsageSite
+{
+    MemoryUsage usage;
+    std::source_location site;
+
+    MemoryUsageSite(MemoryUsage usage, std::source_location site = std::source_location::current())
+        : usage(usage), site(site)
+    {
+    }
+};
+
+/// @brief Live heap allocation recorded by call site tracking.
+struct MemoryAllocation
+{
+    MemoryUsage usage;
+    std::size_t size;
+    const char* file;   // source file of the call site
+    uint32_t line;      // source line of the call site
+    uint64_t timestamp; // steady clock microseconds at allocation
+};
+
+/// @brief Backend serving heap_malloc.
+enum HeapBackend : uint32_t
+{
+    HEAP_BACKEND_SYSTEM = 0, /// std::malloc for every allocation
+    HEAP_BACKEND_SLAB,       /// thread local size class slabs for allocations up to 4 KiB, std::malloc for larger ones
+};
+
+/// @brief Select the backend of subsequent heap_malloc calls, the default is HEAP_BACKEND_SYSTEM.
+///        Intended to be called once during startup. Each allocation remembers its backend,
+///        so heap_free stays valid for allocations made before switching.
+///        The editor and runtime select the backend with the --heap=slab or --heap=system option.
+void heap_set_backend(HeapBackend backend);
+
+/// @brief get the backend of subsequent heap_malloc calls
+HeapBackend heap_get_backend();
+
+/// @brief Return empty slabs of HEAP_BACKEND_SLAB to the system, slabs with live blocks are kept.
+///        Empty slabs of a thread are also returned when the thread exits.
+void heap_trim();
+
+/// @brief Enable or disable call site tracking of subsequent heap allocations, disabled by default.
+///        Setting the LD_MEMORY_TRACKING environment variable enables tracking at startup and
+///        prints the largest live allocations of each usage at exit, the variable value is the
+///        number of allocations printed per usage. Blocks allocated while tracking is disabled
+///        are never tracked, disabled tracking costs a single flag check per allocation.
+void heap_set_tracking(bool enable);
+
+/// @brief check if heap allocations are tracked
+bool heap_get_tracking();
+
 /// @brief heap allocation
 /// @param size number of bytes
-/// @param usage intended usage
-void* heap_malloc(std::size_t size, MemoryUsage usage);
+/// @param usage intended usage, implicitly carries the call site
+void* heap_malloc(std::size_t size, MemoryUsageSite usage);
 
 /// @brief free a heap allocation
 void heap_free(void* ptr);
@@ -46,10 +100,14 @@ void heap_free(void* ptr);
 /// @param cstr a null terminated c string to copy from
 /// @param usage intended usage
 /// @return a copy of input cstr, must be freed with heap_free
-char* heap_strdup(const char* cstr, MemoryUsage usage);
-char* heap_strdup(const void* data, size_t len, MemoryUsage usage);
+char* heap_strdup(const char* cstr, MemoryUsageSite usage);
+char* heap_strdup(const void* data, size_t len, MemoryUsageSite usage);
 
-/// @brief examine memory profile for a given usage
+/// @brief Examine memory profile for a given usage. Threads account allocations locally
+///        and publish once they hold more than 64 KiB per usage, the profile aggregates
+///        unpublished bytes lazily so current is exact once threads are idle.
+///        Peak is sampled on publish and on query, it differs from the exact peak
+///        by at most 64 KiB per thread that allocates with this usage.
 const MemoryProfile& get_memory_profile(MemoryUsage usage);
 
 /// @brief Examine memory leaks for all usages
@@ -57,11 +115,18 @@ const MemoryProfile& get_memory_profile(MemoryUsage usage);
 /// @return Number of memory profiles that still have allocations not freed.
 int get_memory_leaks(MemoryProfile* leaks);
 
+/// @brief Examine the largest live tracked allocations of a usage, sorted by descending size.
+/// @param usage Memory usage to examine.
+/// @param maxCount Maximum number of allocations to output.
+/// @param allocs Outputs at most maxCount allocations.
+/// @return Number of allocations written to allocs.
+int get_memory_allocations(MemoryUsage usage, int maxCount, MemoryAllocation* allocs);
+
 /// @brief get static C string for memory usage
 const char* get_memory_usage_cstr(MemoryUsage usage);
 
 template <typename T, typename... TArgs>
-T* heap_new(MemoryUsage usage, TArgs&&... args)
+T* heap_new(MemoryUsageSite usage, TArgs&&... args)
 {
     T* ptr = (T*)heap_malloc(sizeof(T), usage);
     new (ptr) T(std::forward<TArgs>(args)...);
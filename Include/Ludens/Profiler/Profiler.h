@@ -5,4 +5,5 @@
 
 #define LD_PROFILE_SCOPE ZoneScoped
 #define LD_PROFILE_SCOPE_NAME ZoneScopedN
-#define LD_PROFILE_FRAME_MARK FrameMark
\ No newline at end of file
+#define LD_PROFILE_FRAME_MARK FrameMark
+#define LD_PROFILE_PLOT TracyPlot
\ No newline at end of file
@@ -142,6 +142,21 @@ struct RImage : RHandle<struct RImageObj>
     uint64_t size() const;
 };
 
+/// @brief memory requirements of a resource, as reported by the render backend
+struct RMemoryRequirements
+{
+    uint64_t size;      /// byte size of memory required
+    uint64_t alignment; /// required alignment of the offset into memory
+    uint32_t typeBits;  /// bit mask of backend memory types that can hold the resource
+};
+
+/// @brief device memory handle, images can be placed into memory at an offset
+struct RMemory : RHandle<struct RMemoryObj>
+{
+    /// @brief byte size of the memory
+    uint64_t size() const;
+};
+
 /// @brief description of how a color attachment is used in a render pass
 struct RPassColorAttachment
 {
@@ -489,6 +504,9 @@ struct RCommandList : RHandle<struct RCommandListObj>
     /// @brief add an image memory barrier
     void cmd_image_memory_barrier(RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RImageMemoryBarrier& barrier);
 
+    /// @brief add multiple image memory barriers sharing the same stages in a single pipeline barrier
+    void cmd_image_memory_barriers(RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, uint32_t barrierCount, const RImageMemoryBarrier* barriers);
+
     /// @brief a transfer command to copy from buffer to buffer
     void cmd_copy_buffer(RBuffer srcBuffer, RBuffer dstBuffer, uint32_t regionCount, const RBufferCopy* regions);
 
@@ -510,7 +528,9 @@ struct RCommandPoolInfo
     bool listResettable; /// whether or not command lists allocated from this pool can be reset individually.
 };
 
-/// @brief command pool handle, used to allocate command lists
+/// @brief command pool handle, used to allocate command lists.
+///        With the Vulkan backend, lists allocated from different pools may be recorded
+///        on different threads, while lists of the same pool are recorded on one thread at a time.
 struct RCommandPool : RHandle<struct RCommandPoolObj>
 {
     /// @brief allocate a command list
@@ -577,6 +597,19 @@ struct RDeviceInfo
 {
     RDeviceBackend backend;
     bool vsync;
+    const char* cacheDirectory; /// optional directory for compiled shaders and pipeline cache data, created if it does not exist
+};
+
+/// @brief Persistent shader and pipeline cache counters since device creation.
+struct RDeviceCacheStats
+{
+    uint32_t shaderHitCount;        /// shaders loaded from the SPIR-V cache
+    uint32_t shaderMissCount;       /// shaders compiled from GLSL
+    uint32_t shaderRejectCount;     /// SPIR-V cache entries discarded as corrupt or outdated
+    uint32_t shaderWriteCount;      /// SPIR-V cache entries written to disk
+    uint32_t pipelineHitCount;      /// pipelines the driver created from the pipeline cache
+    uint32_t pipelineMissCount;     /// pipelines the driver compiled without a cache hit
+    uint64_t pipelineCacheLoadSize; /// bytes of pipeline cache data loaded at device creation
 };
 
 /// @brief Render device handle, main thread only.
@@ -597,6 +630,18 @@ struct RDevice : RHandle<struct RDeviceObj>
     RImage create_image(const RImageInfo& imageI);
     void destroy_image(RImage image);
 
+    /// @brief Query memory requirements of an image without creating it.
+    RMemoryRequirements get_image_memory_requirements(const RImageInfo& imageI);
+
+    /// @brief Allocate device local memory that images can be placed into.
+    RMemory create_memory(const RMemoryRequirements& req);
+    void destroy_memory(RMemory memory);
+
+    /// @brief Create an image placed in existing memory, images with disjoint lifetimes may alias
+    ///        the same memory range. The user synchronizes between aliasing images, and destroys
+    ///        the image with destroy_image before the memory is destroyed.
+    RImage create_placed_image(const RImageInfo& imageI, RMemory memory, uint64_t offset);
+
     RCommandPool create_command_pool(const RCommandPoolInfo& poolI);
     void destroy_command_pool(RCommandPool pool);
 
@@ -638,6 +683,11 @@ struct RDevice : RHandle<struct RDeviceObj>
 
     uint32_t get_frames_in_flight_count();
 
+    RDeviceBackend get_backend();
+
+    /// @brief Get shader and pipeline cache counters, all zero if the device has no cache directory.
+    RDeviceCacheStats get_cache_stats();
+
     /// @brief get a frame index in the half open range [0, frames_in_flight_count)
     uint32_t get_frame_index();
 
@@ -101,20 +101,48 @@ struct RGraphSwapchainInfo
 };
 
 /// @brief Render graph creation info, each frame specifies the destination swapchain images.
+///        If pass lists are supplied, the sorted passes are split into contiguous ranges that are
+///        recorded into the pass lists on job system threads, then submitted in pass order
+///        before the main list, pass callbacks of different ranges may run concurrently.
+///        Otherwise all passes are recorded into the main list on the calling thread.
+///        The OpenGL backend always records on the calling thread.
 struct RGraphInfo
 {
     RDevice device;
-    RCommandList list;
+    RCommandList list;                     /// main command list, records swapchain blits
+    RCommandList* passLists;               /// optional command lists for parallel pass recording, each allocated from a different pool
     RFence frameComplete;
     RGraphSwapchainInfo* swapchains;
-    RGraphCommandListCallback prePassCB;
-    RGraphCommandListCallback preSubmitCB;
+    RGraphCommandListCallback prePassCB;   /// called at the beginning of each command list that passes are recorded into
+    RGraphCommandListCallback preSubmitCB; /// called on the calling thread before submission
     void* user;
+    uint32_t passListCount;                /// number of pass lists, zero to record passes on the calling thread
     uint32_t swapchainCount;
     uint32_t screenWidth;
     uint32_t screenHeight;
 };
 
+/// @brief Transient image memory of the last submission.
+///        Private images that are fully written within a frame are placed in shared memory,
+///        images with disjoint lifetimes in the pass order alias the same memory range.
+struct RGraphMemoryReport
+{
+    uint32_t transientImageCount; /// number of private images placed in shared memory
+    uint32_t heapCount;           /// number of shared memory allocations
+    uint64_t unaliasedSize;       /// bytes required if each transient image had dedicated memory
+    uint64_t aliasedSize;         /// bytes of all shared memory allocations
+};
+
+/// @brief Graph compilation counters since startup. A graph is compiled when the declared
+///        structure differs from the last submission, otherwise the compiled graph is reused.
+struct RGraphCompileStats
+{
+    uint64_t compileCount;        /// submissions that sorted passes and placed transient images
+    uint64_t reuseCount;          /// submissions that reused the compiled pass order
+    uint64_t replayCount;         /// submissions that also replayed recorded barriers
+    uint64_t parallelRecordCount; /// submissions that recorded passes on job system threads
+};
+
 /// @brief render graph handle
 struct RGraph : RHandle<struct RGraphObj>
 {
@@ -136,6 +164,12 @@ struct RGraph : RHandle<struct RGraphObj>
     /// @brief component implementations may add a callback that will be called at RGraph::release to release resources.
     static void add_release_callback(void* user, OnReleaseCallback onRelease);
 
+    /// @brief Get transient image memory of the last submission, before and after aliasing.
+    static RGraphMemoryReport get_memory_report();
+
+    /// @brief Get graph compilation counters since startup.
+    static RGraphCompileStats get_compile_stats();
+
     /// @brief get the render device this graph is created with
     RDevice get_device();
 
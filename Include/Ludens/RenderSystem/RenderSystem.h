@@ -71,6 +71,7 @@ struct RenderSystemInfo
     RDevice device;             /// render device handle
     FontAtlas defaultFontAtlas; /// default font atlas used for text rendering
     FontAtlas monoFontAtlas;    /// monospace font atlas
+    bool parallelPassRecording; /// record render graph passes on job system threads, render components must tolerate concurrent pass callbacks
 };
 
 /// @brief Info for the system to start a new frame
@@ -124,7 +125,7 @@ struct RenderSystemScreenPass
         // TODO: ScreenLayer mask per-region
     };
 
-    RenderSystemMat4Callback mat4Callback; /// callback for system to grab the model matrix of 2D objects
+    RenderSystemMat4Callback mat4Callback; /// callback for system to grab the model matrix of 2D objects, may be invoked from worker threads concurrently
     uint32_t regionCount;                  /// non-overlapping regions to draw ScreenLayer items
     Region* regions;                       /// number of screen regions
     void* user;                            /// user of the screen pass
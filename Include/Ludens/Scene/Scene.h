@@ -28,6 +28,24 @@ struct SceneRenderSystem : Handle<struct SceneObj>
     void configure_screen_layers(size_t count, SUID* ids, String* names);
 };
 
+/// @brief Lua garbage collector tuning, applied to the Lua state of each loaded scene.
+struct SceneLuaGCInfo
+{
+    int pause = 200;          /// collector pause in percent, see LuaState::gc_set_pause
+    int stepMultiplier = 200; /// collector step multiplier in percent, see LuaState::gc_set_step_multiplier
+    int stepKB = 0;           /// if positive, automatic collection is stopped and replaced by a
+                              /// bounded step of this size after script updates every frame
+};
+
+/// @brief Scene transition request. The next scene is populated across frames
+///        while the active scene keeps updating.
+struct SceneTransitionInfo
+{
+    SceneLoadFn loadFn;         /// populates the next scene on main thread once its assets are loaded
+    Vector<AssetID> assets;     /// assets required by the next scene, loaded on worker threads first
+    float frameBudgetMS = 2.0f; /// main thread time per frame spent starting up components of the next scene
+};
+
 /// @brief Scene creation info, connects to external asset manager and subsystems.
 struct SceneInfo
 {
@@ -36,6 +54,7 @@ struct SceneInfo
     UIFont uiFont = {};
     UITheme uiTheme = {};
     SUIDRegistry suidRegistry = {};
+    SceneLuaGCInfo luaGC = {};
 };
 
 /// @brief Scene singleton, main thread only. A scene is a hierarchy of components driven by scripts.
@@ -77,8 +96,24 @@ public:
     void update(const SceneUpdateTick& tick);
 
     /// @brief Non-blocking request to begin a transition to another scene.
+    /// @return False if another transition is already in progress.
     bool request_transition(const SceneLoadFn& loadFn);
 
+    /// @brief Non-blocking request to begin a transition to another scene.
+    ///        Assets are loaded on worker threads, then the next scene is loaded and its
+    ///        components are started up within a per-frame budget. The next scene replaces
+    ///        the active scene during the update after its last component starts up.
+    /// @return False if another transition is already in progress.
+    bool request_transition(const SceneTransitionInfo& transitionI);
+
+    /// @brief Cancel the transition in progress, the partially loaded next scene is discarded.
+    ///        Asset loads already submitted are completed during later updates.
+    void cancel_transition();
+
+    /// @brief Get normalized progress of the transition in progress.
+    /// @return Progress in [0, 1], or a negative value if no transition is in progress.
+    float get_transition_progress();
+
     /// @brief Render screen UI contents.
     void render_screen_ui(ScreenRenderComponent renderer);
 
@@ -132,7 +167,9 @@ public:
     ComponentView get_component(CUID compID);
 
     /// @brief Get components by type.
-    Vector<ComponentView> get_components(ComponentType type);
+    /// @warning The result is allocated from the FrameArena and is only valid until the end
+    ///          of the frame after the current one, do not store it across frames.
+    FrameVector<ComponentView> get_components(ComponentType type);
 
     /// @brief Get data component from ID and expected type, fails upon type mismatch.
     inline ComponentView get_component(CUID compID, ComponentType expectedType)
@@ -8,12 +8,16 @@ size_t zstd_compress_bound(size_t srcSize);
 
 size_t zstd_compress(void* dst, size_t dstCapacity, const void* src, size_t srcSize, int compressionLevel);
 
-void zstd_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize);
+/// @brief Decompress a zstd frame.
+/// @return Number of bytes written to dst, or 0 if the input is malformed or does not fit in dst.
+size_t zstd_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize);
 
 size_t lz4_compress_bound(size_t srcSize);
 
 size_t lz4_compress(void* dst, size_t dstCapacity, const void* src, size_t srcSize);
 
-void lz4_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize);
+/// @brief Decompress an lz4 block.
+/// @return Number of bytes written to dst, or 0 if the input is malformed or does not fit in dst.
+size_t lz4_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize);
 
 } // namespace LD
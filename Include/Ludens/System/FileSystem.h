@@ -2,6 +2,7 @@
 
 #include <Ludens/DSA/String.h>
 #include <Ludens/DSA/Vector.h>
+#include <Ludens/Header/Handle.h>
 #include <Ludens/Header/Types.h>
 #include <Ludens/Header/View.h>
 
@@ -66,6 +67,22 @@ bool read_file_to_vector(const FS::Path& path, Vector<byte>& v, String& err);
 /// @warning User needs to heap_free the returned allocation.
 char* read_file_to_cstr(const FS::Path& path, String& err);
 
+/// @brief Read-only memory mapping of a whole file. Pages are loaded by the OS
+///        on first access, so reading through the view avoids copying the file
+///        into an intermediate buffer.
+struct FileMapping : Handle<struct FileMappingObj>
+{
+    /// @brief Map whole file for reading, empty files can not be mapped.
+    /// @return Mapping handle on success, or a null handle with error message.
+    static FileMapping create(const Path& path, String& err);
+
+    /// @brief Unmap file, views into the mapping are invalidated.
+    static void destroy(FileMapping mapping);
+
+    /// @brief Get mapped file bytes.
+    View view();
+};
+
 /// @brief Write bytes to a file.
 bool write_file(const Path& path, View view, String& err);
 
@@ -78,6 +95,13 @@ bool write_file(const Path& path, View view, Diagnostics& diag);
 /// @return True if all steps of the protocol succeeded.
 bool write_file_and_swap_backup(const Path& path, View view, String& err);
 
+/// @brief Get a temporary file path next to path, unique to the calling process and thread.
+///        Write to the temporary file and rename it to path, so readers never observe a partial file.
+Path get_unique_tmp_path(const Path& path);
+
+/// @brief Rename or move a file, an existing file at dst is replaced.
+bool rename(const Path& src, const Path& dst, String& err);
+
 /// @brief Check if path exists in filesystem.
 bool exists(const Path& path);
 
@@ -13,6 +13,9 @@ namespace LD {
 /// 	     ensure input originates from a trusted source.
 void shell_open(const FS::Path& path);
 
+/// @brief Get the ID of the calling process.
+uint32_t get_process_id();
+
 typedef void (*ProcessLineFn)(const String& line, void* user);
 
 struct ProcessInfo
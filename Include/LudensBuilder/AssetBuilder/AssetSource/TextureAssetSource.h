@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Ludens/Asset/AssetType/Texture2DAsset.h>
 #include <Ludens/RenderBackend/RBackend.h>
 #include <LudensBuilder/AssetBuilder/AssetBuilderDef.h>
 
@@ -7,8 +8,10 @@ namespace LD {
 
 struct Texture2DAssetImportInfo : AssetImportInfo
 {
-    FS::Path srcFile;              /// absolute path to load the source texture
-    RSamplerInfo samplerHint = {}; /// desired texture sampler mode
+    FS::Path srcFile;                                         /// absolute path to load the source texture
+    RSamplerInfo samplerHint = {};                            /// desired texture sampler mode
+    bool preDecode = true;                                    /// store decoded pixels with a mip chain instead of the encoded source file
+    TextureCompression compression = TEXTURE_COMPRESSION_LZ4; /// compression of pre-decoded pixels
 
     Texture2DAssetImportInfo()
         : AssetImportInfo(ASSET_TYPE_TEXTURE_2D) {}
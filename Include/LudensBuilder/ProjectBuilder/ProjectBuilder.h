@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Ludens/Asset/AssetPack.h>
 #include <Ludens/DSA/String.h>
 #include <Ludens/Header/Handle.h>
 #include <Ludens/Header/Status.h>
@@ -21,6 +22,8 @@ struct ProjectBuildConfig
 {
     FS::Path srcProjectSchema;
     FS::Path dstRootDirectory;
+    bool packAssets = true;                                          /// emit a single asset pack instead of loose asset files
+    AssetPackCompression packCompression = ASSET_PACK_COMPRESSION_LZ4; /// per-file compression of the asset pack
 };
 
 struct ProjectBuildResult
@@ -1,4 +1,5 @@
 #include <Ludens/Asset/AssetType/Texture2DAssetObj.h>
+#include <Ludens/DSA/Vector.h>
 #include <Ludens/Media/Bitmap.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/Serial/Serial.h>
@@ -18,7 +19,12 @@ void texture_2d_asset_import(void* user)
     const auto& info = *(const Texture2DAssetImportInfo*)job.info;
 
     obj->samplerHint = info.samplerHint;
-    obj->serialData.clear();
+
+    if (obj->fileMapping)
+    {
+        FS::FileMapping::destroy(obj->fileMapping);
+        obj->fileMapping = {};
+    }
 
     Serializer serial;
     asset_header_write(serial, ASSET_TYPE_TEXTURE_2D);
@@ -32,6 +38,25 @@ void texture_2d_asset_import(void* user)
         return;
     }
 
+    if (info.preDecode)
+    {
+        // decode once at import time, runtime loads copy pixels without touching the image codec
+        Vector<byte> fileData(fileSize);
+        if (!job.read_src_file(info.srcFile, MutView(fileData.data(), fileData.size())))
+            return;
+
+        obj->fileView = {};
+        obj->bitmap = Bitmap::create_from_file_data(View(fileData.data(), fileData.size()));
+        if (!job.require(obj->bitmap, "failed to create Bitmap"))
+            return;
+
+        BitmapCompression compression = info.compression == TEXTURE_COMPRESSION_LZ4 ? BITMAP_COMPRESSION_LZ4 : BITMAP_COMPRESSION_NONE;
+        Texture2DAssetObj::serialize_mip_chain(serial, obj->bitmap, compression);
+
+        (void)job.write_binary_dst_file(serial.view());
+        return;
+    }
+
     obj->fileView.size = fileSize;
 
     size_t fileDataOffset = serial.write_chunk_begin("FILE");
@@ -1,5 +1,6 @@
 #include <Ludens/Asset/AssetType/LuaScriptAssetObj.h>
 #include <Ludens/DSA/ViewUtil.h>
+#include <Ludens/Lua/LuaState.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/Serial/Serial.h>
 #include <LudensBuilder/AssetBuilder/AssetState/LuaScriptAssetState.h>
@@ -40,6 +41,15 @@ void lua_script_asset_import(void* user)
     if (!job.write_dst_file("source", obj->sourcePath.c_str(), view(obj->source)))
         return;
 
+    // Bake LuaJIT bytecode so scripts are not compiled at scene startup.
+    // Scripts that fail to compile ship source only and report the error at runtime.
+    String chunkName = "@";
+    chunkName += obj->sourcePath;
+    LuaState L = LuaState::create({.openLibs = false});
+    if (!L.dump(obj->source.c_str(), obj->bytecode, chunkName.c_str()))
+        obj->bytecode.clear();
+    LuaState::destroy(L);
+
     Serializer serial;
     asset_header_write(serial, ASSET_TYPE_LUA_SCRIPT);
 
@@ -47,6 +57,13 @@ void lua_script_asset_import(void* user)
     serial.write_u32((uint32_t)obj->domain);
     serial.write_chunk_end();
 
+    if (obj->bytecode.size() > 0)
+    {
+        serial.write_chunk_begin("BCOD");
+        serial.write(obj->bytecode.data(), obj->bytecode.size());
+        serial.write_chunk_end();
+    }
+
     (void)job.write_binary_dst_file(serial.view());
 }
 
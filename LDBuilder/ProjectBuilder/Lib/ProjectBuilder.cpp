@@ -1,3 +1,4 @@
+#include <Ludens/Asset/AssetPack.h>
 #include <Ludens/Asset/AssetRegistry.h>
 #include <Ludens/Asset/AssetSchema.h>
 #include <Ludens/DSA/Diagnostics.h>
@@ -115,6 +116,99 @@ private:
     std::atomic_uint32_t mStatus{ASYNC_STATUS_IDLE};
 };
 
+/// @brief Packs asset files of the project into a single asset pack.
+class PackAssetsJob
+{
+public:
+    struct File
+    {
+        AssetID id;
+        String key;
+        FS::Path srcPath;
+    };
+
+    Vector<File> files;
+    FS::Path dstPath;
+    AssetPackCompression compression;
+
+public:
+    void submit()
+    {
+        mJob.user = this;
+        mJob.onExecute = &PackAssetsJob::execute;
+        JobSystem::get().submit(&mJob, JOB_DISPATCH_STANDARD);
+    }
+
+    bool has_completed(bool& success)
+    {
+        AsyncStatus status = (AsyncStatus)mStatus.load();
+
+        if (status == ASYNC_STATUS_IDLE || status == ASYNC_STATUS_IN_PROGRESS)
+            return false;
+
+        success = status == ASYNC_STATUS_SUCCESS;
+        return true;
+    }
+
+private:
+    static void execute(void* user)
+    {
+        LD_PROFILE_SCOPE;
+
+        auto* obj = (PackAssetsJob*)user;
+        obj->mStatus.store(ASYNC_STATUS_IN_PROGRESS);
+
+        bool success = obj->pack();
+        if (!success)
+            sLog.error("{}", obj->mError);
+        obj->mStatus.store(success ? ASYNC_STATUS_SUCCESS : ASYNC_STATUS_FAILURE);
+    }
+
+    bool pack()
+    {
+        AssetPackWriter writer = AssetPackWriter::create();
+        bool success = true;
+
+        for (const File& file : files)
+        {
+            uint64_t fileSize;
+            if (!FS::get_file_size(file.srcPath, fileSize, mError))
+            {
+                mError = std::format("failed to pack asset file [{}]: {}", file.srcPath.string(), mError);
+                success = false;
+                break;
+            }
+
+            // empty files can not be mapped
+            if (fileSize == 0)
+            {
+                writer.add_file(file.id, file.key.c_str(), View{}, compression);
+                continue;
+            }
+
+            FS::FileMapping mapping = FS::FileMapping::create(file.srcPath, mError);
+            if (!mapping)
+            {
+                mError = std::format("failed to pack asset file [{}]: {}", file.srcPath.string(), mError);
+                success = false;
+                break;
+            }
+
+            writer.add_file(file.id, file.key.c_str(), mapping.view(), compression);
+            FS::FileMapping::destroy(mapping);
+        }
+
+        success = success && writer.write(dstPath, mError);
+        AssetPackWriter::destroy(writer);
+
+        return success;
+    }
+
+    JobHeader mJob{};
+    String mError;
+    std::atomic_uint32_t mStatus{ASYNC_STATUS_IDLE};
+};
+
 struct ProjectBuildAsyncObj
 {
     ProjectContext projectCtx = {};
@@ -125,6 +219,7 @@ struct ProjectBuildAsyncObj
     WriteFileJob writeAssetSchemaJob;
     Vector<CopyFileJob*> copyAssetJobs;
     Vector<CopyFileJob*> copySceneSchemaJobs;
+    PackAssetsJob packAssetsJob;
     String dstAssetSchemaTOML;
     String dstProjectSchemaTOML;
     bool hasCompleted;
@@ -225,6 +320,34 @@ bool ProjectBuildAsyncObj::configure_dst_asset_schema(ProjectBuildStatus& err)
         return false;
     }
 
+    // asset files are looked up by asset ID and file path key in the pack,
+    // the registry keeps its file paths and no loose files are copied.
+    if (config.packAssets)
+    {
+        const FS::Path srcStorageDirectory = srcRootDirectory / project.get_storage_dir_rel_path();
+        packAssetsJob.files.clear();
+        packAssetsJob.dstPath = config.dstRootDirectory / FS::Path(LD_ASSET_PACK_DEFAULT_FILE_NAME);
+        packAssetsJob.compression = config.packCompression;
+
+        for (AssetEntry entry : assets)
+        {
+            keys = entry.get_file_path_keys();
+            for (const String& key : keys)
+            {
+                PackAssetsJob::File file;
+                file.id = entry.get_id();
+                file.key = key;
+                file.srcPath = srcStorageDirectory / FS::Path(entry.get_id().to_string()) / FS::Path(entry.get_file_path(key).c_str());
+                packAssetsJob.files.push_back(file);
+            }
+        }
+
+        if (!AssetSchema::save_registry_to_string(assetRegistry, dstAssetSchemaTOML, err.str))
+            return false;
+
+        return true;
+    }
+
     // flatten assets in build dst directory, copy files over
     for (AssetEntry entry : assets)
     {
@@ -302,6 +425,12 @@ bool ProjectBuildAsyncObj::begin(const ProjectBuildConfig& cfg, ProjectBuildStat
     for (CopyFileJob* job : copySceneSchemaJobs)
         job->submit();
 
+    if (config.packAssets)
+    {
+        sLog.debug("Begin pack {} asset files to [{}]", packAssetsJob.files.size(), packAssetsJob.dstPath.string());
+        packAssetsJob.submit();
+    }
+
     result.reset();
     hasCompleted = false;
     return true;
@@ -381,6 +510,14 @@ bool ProjectBuildAsync::has_completed()
         success = success && jobSuccess;
     }
 
+    if (mObj->config.packAssets)
+    {
+        if (!mObj->packAssetsJob.has_completed(jobSuccess))
+            return false;
+
+        success = success && jobSuccess;
+    }
+
     // all completed
     mObj->result.success = success;
 
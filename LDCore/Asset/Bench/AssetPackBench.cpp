@@ -0,0 +1,196 @@
+#include <Ludens/Asset/AssetPack.h>
+#include <Ludens/Header/Platform.h>
+#include <Ludens/System/FileSystem.h>
+#include <Ludens/System/Timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+#ifdef LD_PLATFORM_LINUX
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+using namespace LD;
+
+constexpr uint32_t ASSET_COUNT = 4000;
+constexpr size_t MIN_ASSET_SIZE = 512;
+constexpr size_t MAX_ASSET_SIZE = 128 * 1024;
+constexpr int ITERATIONS = 5;
+
+/// drop cached pages of a file so the next read goes to disk, approximates a cold start
+static void evict_file(const FS::Path& path)
+{
+#ifdef LD_PLATFORM_LINUX
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return;
+
+    (void)fdatasync(fd);
+    (void)posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+    close(fd);
+#else
+    (void)path;
+#endif
+}
+
+/// touch one byte per page, similar to a loader deserializing the whole binary
+static uint64_t touch(View view)
+{
+    uint64_t sum = 0;
+
+    for (size_t i = 0; i < view.size; i += 4096)
+        sum += view.data[i];
+
+    return sum + view.data[view.size - 1];
+}
+
+static FS::Path get_loose_path(const FS::Path& root, uint32_t id)
+{
+    return root / "storage" / FS::Path(AssetID(id).to_string()) / LD_ASSET_DEFAULT_BINARY_FILE_NAME;
+}
+
+static bool generate(const FS::Path& root, const FS::Path& packPath, const FS::Path& packLZ4Path)
+{
+    String err;
+    AssetPackWriter writer = AssetPackWriter::create();
+    AssetPackWriter writerLZ4 = AssetPackWriter::create();
+    std::vector<byte> data(MAX_ASSET_SIZE);
+    uint32_t seed = 12345;
+
+    for (uint32_t id = 1; id <= ASSET_COUNT; id++)
+    {
+        seed = seed * 1664525u + 1013904223u;
+        size_t size = MIN_ASSET_SIZE + seed % (MAX_ASSET_SIZE - MIN_ASSET_SIZE);
+
+        // half random, half repeated bytes, roughly what serialized asset binaries look like
+        for (size_t i = 0; i < size; i++)
+            data[i] = i < size / 2 ? (byte)((seed >> (i % 24)) + i) : (byte)(i / 64);
+
+        FS::Path path = get_loose_path(root, id);
+        if (!FS::create_directories(path.parent_path(), err) || !FS::write_file(path, View(data.data(), size), err))
+        {
+            printf("failed to write %s: %s\n", path.string().c_str(), err.c_str());
+            AssetPackWriter::destroy(writer);
+            AssetPackWriter::destroy(writerLZ4);
+            return false;
+        }
+
+        writer.add_file(AssetID(id), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View(data.data(), size), ASSET_PACK_COMPRESSION_NONE);
+        writerLZ4.add_file(AssetID(id), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View(data.data(), size), ASSET_PACK_COMPRESSION_LZ4);
+    }
+
+    bool success = writer.write(packPath, err) && writerLZ4.write(packLZ4Path, err);
+    AssetPackWriter::destroy(writer);
+    AssetPackWriter::destroy(writerLZ4);
+
+    return success;
+}
+
+static float load_loose(const FS::Path& root, bool cold, uint64_t& checksum)
+{
+    if (cold)
+    {
+        for (uint32_t id = 1; id <= ASSET_COUNT; id++)
+            evict_file(get_loose_path(root, id));
+    }
+
+    size_t us;
+    String err;
+    checksum = 0;
+    {
+        ScopeTimer timer(&us);
+
+        for (uint32_t id = 1; id <= ASSET_COUNT; id++)
+        {
+            FS::Path path = get_loose_path(root, id);
+
+            if (!FS::exists(path))
+                continue;
+
+            FS::FileMapping mapping = FS::FileMapping::create(path, err);
+            checksum += touch(mapping.view());
+            FS::FileMapping::destroy(mapping);
+        }
+    }
+
+    return us / 1000.0f;
+}
+
+static float load_pack(const FS::Path& packPath, bool cold, uint64_t& checksum)
+{
+    if (cold)
+        evict_file(packPath);
+
+    size_t us;
+    String err;
+    std::vector<byte> unpacked(MAX_ASSET_SIZE);
+    checksum = 0;
+    {
+        ScopeTimer timer(&us);
+
+        AssetPack pack = AssetPack::create(packPath, err);
+
+        for (uint32_t id = 1; id <= ASSET_COUNT; id++)
+        {
+            const AssetPackEntry* entry = pack.find(AssetID(id), LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+
+            if (entry->compression == ASSET_PACK_COMPRESSION_NONE)
+            {
+                checksum += touch(pack.get_payload(entry));
+                continue;
+            }
+
+            if (!pack.unpack(entry, MutView(unpacked.data(), (size_t)entry->rawSize), err))
+                continue;
+
+            checksum += touch(View(unpacked.data(), (size_t)entry->rawSize));
+        }
+
+        AssetPack::destroy(pack);
+    }
+
+    return us / 1000.0f;
+}
+
+static float median(std::vector<float> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+int main(int argc, char** argv)
+{
+    FS::Path root = FS::temp_directory_path() / "ld_asset_pack_bench";
+    FS::Path packPath = root / LD_ASSET_PACK_DEFAULT_FILE_NAME;
+    FS::Path packLZ4Path = root / "assets_lz4.ldp";
+
+    std::filesystem::remove_all(root);
+
+    if (!generate(root, packPath, packLZ4Path))
+        return 1;
+
+    printf("%u assets of %zu to %zu bytes, median of %d runs\n", ASSET_COUNT, MIN_ASSET_SIZE, MAX_ASSET_SIZE, ITERATIONS);
+
+    for (int cold = 1; cold >= 0; cold--)
+    {
+        std::vector<float> looseMS, packMS, packLZ4MS;
+        uint64_t looseSum, packSum, packLZ4Sum;
+
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            looseMS.push_back(load_loose(root, cold, looseSum));
+            packMS.push_back(load_pack(packPath, cold, packSum));
+            packLZ4MS.push_back(load_pack(packLZ4Path, cold, packLZ4Sum));
+        }
+
+        if (looseSum != packSum || looseSum != packLZ4Sum)
+            printf("checksum mismatch\n");
+
+        printf("%s: loose files %8.3f ms, pack %8.3f ms, pack lz4 %8.3f ms\n", cold ? "cold" : "warm", median(looseMS), median(packMS), median(packLZ4MS));
+    }
+
+    std::filesystem::remove_all(root);
+}
@@ -0,0 +1,206 @@
+#include <Ludens/Asset/AssetType/Texture2DAssetObj.h>
+#include <Ludens/Media/Bitmap.h>
+#include <Ludens/Serial/Serial.h>
+#include <Ludens/System/FileSystem.h>
+#include <Ludens/System/Timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <vector>
+
+using namespace LD;
+
+constexpr uint32_t SYNTHETIC_COUNT = 6;
+constexpr uint32_t SYNTHETIC_SIZE = 2048;
+constexpr int ITERATIONS = 5;
+
+enum TextureLayout
+{
+    TEXTURE_LAYOUT_FILE = 0,  // encoded source file, decoded on every load
+    TEXTURE_LAYOUT_MIPS_NONE, // pre-decoded mip chain, uncompressed
+    TEXTURE_LAYOUT_MIPS_LZ4,  // pre-decoded mip chain, LZ4 compressed
+    TEXTURE_LAYOUT_ENUM_COUNT,
+};
+
+static const char* sLayoutNames[] = {"file", "mips", "mips_lz4"};
+
+/// smooth gradients with some noise, compresses like a typical photo or painted texture
+static bool generate_sources(const FS::Path& dir, std::vector<FS::Path>& sources)
+{
+    std::vector<uint32_t> pixels(SYNTHETIC_SIZE * SYNTHETIC_SIZE);
+    uint32_t seed = 12345;
+
+    for (uint32_t i = 0; i < SYNTHETIC_COUNT; i++)
+    {
+        for (uint32_t y = 0; y < SYNTHETIC_SIZE; y++)
+        {
+            for (uint32_t x = 0; x < SYNTHETIC_SIZE; x++)
+            {
+                seed = seed * 1664525u + 1013904223u;
+                uint32_t noise = (seed >> 28);
+                uint32_t r = ((x + i * 97) / 8 + noise) & 0xFF;
+                uint32_t g = ((y + i * 31) / 8 + noise) & 0xFF;
+                uint32_t b = ((x + y) / 16) & 0xFF;
+                pixels[y * SYNTHETIC_SIZE + x] = 0xFF000000 | (b << 16) | (g << 8) | r;
+            }
+        }
+
+        FS::Path path = dir / FS::Path("source_" + std::to_string(i) + ".png");
+        BitmapView view{SYNTHETIC_SIZE, SYNTHETIC_SIZE, BITMAP_FORMAT_RGBA8U, (const char*)pixels.data()};
+
+        if (!Bitmap::save_to_disk(view, path.string().c_str()))
+            return false;
+
+        sources.push_back(path);
+    }
+
+    return true;
+}
+
+static FS::Path get_binary_path(const FS::Path& dir, size_t index, TextureLayout layout)
+{
+    return dir / FS::Path(std::string(sLayoutNames[layout]) + "_" + std::to_string(index) + ".lda");
+}
+
+/// write the texture binary in every layout the importer can produce
+static bool build_binaries(const FS::Path& dir, size_t index, const FS::Path& source, uint64_t sizes[TEXTURE_LAYOUT_ENUM_COUNT])
+{
+    String err;
+    Vector<byte> file;
+    if (!FS::read_file_to_vector(source, file, err))
+    {
+        printf("failed to read %s: %s\n", source.string().c_str(), err.c_str());
+        return false;
+    }
+
+    Texture2DAssetObj obj{};
+    obj.bitmap = Bitmap::create_from_file_data(View(file.data(), file.size()));
+    if (!obj.bitmap)
+    {
+        printf("failed to decode %s\n", source.string().c_str());
+        return false;
+    }
+
+    for (int layout = 0; layout < TEXTURE_LAYOUT_ENUM_COUNT; layout++)
+    {
+        Serializer serial;
+        asset_header_write(serial, ASSET_TYPE_TEXTURE_2D);
+        Texture2DAssetObj::serialize_sampler_info(serial, obj.samplerHint);
+
+        if (layout == TEXTURE_LAYOUT_FILE)
+        {
+            serial.write_chunk_begin("FILE");
+            serial.write(file.data(), file.size());
+            serial.write_chunk_end();
+        }
+        else
+        {
+            BitmapCompression compression = layout == TEXTURE_LAYOUT_MIPS_LZ4 ? BITMAP_COMPRESSION_LZ4 : BITMAP_COMPRESSION_NONE;
+            Texture2DAssetObj::serialize_mip_chain(serial, obj.bitmap, compression);
+        }
+
+        sizes[layout] += serial.size();
+
+        if (!FS::write_file(get_binary_path(dir, index, (TextureLayout)layout), serial.view(), err))
+        {
+            printf("failed to write binary: %s\n", err.c_str());
+            Texture2DAssetObj::unload(&obj);
+            return false;
+        }
+    }
+
+    Texture2DAssetObj::unload(&obj);
+    return true;
+}
+
+/// same steps as Texture2DAssetObj::load_from_binary, minus the asset manager
+static float load_binaries(const FS::Path& dir, size_t count, TextureLayout layout, uint64_t& checksum)
+{
+    size_t us;
+    String err;
+    checksum = 0;
+    {
+        ScopeTimer timer(&us);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            FS::FileMapping mapping = FS::FileMapping::create(get_binary_path(dir, i, layout), err);
+            View view = mapping.view();
+            Deserializer serial(view.data, view.size);
+
+            AssetType type;
+            uint16_t major, minor, patch;
+            Texture2DAssetObj obj{};
+
+            if (asset_header_read(serial, major, minor, patch, type) && Texture2DAssetObj::deserialize(serial, obj))
+            {
+                if (!obj.bitmap)
+                    obj.bitmap = Bitmap::create_from_file_data(obj.fileView);
+
+                checksum += obj.bitmap.data()[obj.bitmap.width() * obj.bitmap.height() * 2];
+            }
+
+            obj.fileView = {};
+            Texture2DAssetObj::unload(&obj);
+            FS::FileMapping::destroy(mapping);
+        }
+    }
+
+    return us / 1000.0f;
+}
+
+static float median(std::vector<float> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/// usage: LDTexture2DLoadBench [directory of PNG or JPEG textures]
+int main(int argc, char** argv)
+{
+    FS::Path root = FS::temp_directory_path() / "ld_texture_2d_load_bench";
+    std::vector<FS::Path> sources;
+
+    std::filesystem::remove_all(root);
+    std::filesystem::create_directories(root);
+
+    if (argc > 1)
+    {
+        for (const auto& entry : std::filesystem::directory_iterator(argv[1]))
+        {
+            std::string ext = entry.path().extension().string();
+            if (ext == ".png" || ext == ".jpg" || ext == ".jpeg")
+                sources.push_back(entry.path());
+        }
+    }
+    else if (!generate_sources(root, sources))
+        return 1;
+
+    uint64_t sizes[TEXTURE_LAYOUT_ENUM_COUNT]{};
+
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        if (!build_binaries(root, i, sources[i], sizes))
+            return 1;
+    }
+
+    printf("%zu textures, median of %d runs\n", sources.size(), ITERATIONS);
+
+    uint64_t checksums[TEXTURE_LAYOUT_ENUM_COUNT];
+
+    for (int layout = 0; layout < TEXTURE_LAYOUT_ENUM_COUNT; layout++)
+    {
+        std::vector<float> samples;
+
+        for (int i = 0; i < ITERATIONS; i++)
+            samples.push_back(load_binaries(root, sources.size(), (TextureLayout)layout, checksums[layout]));
+
+        printf("%-8s: %8.3f ms, %8.2f MB on disk\n", sLayoutNames[layout], median(samples), sizes[layout] / (1024.0 * 1024.0));
+    }
+
+    if (checksums[TEXTURE_LAYOUT_FILE] != checksums[TEXTURE_LAYOUT_MIPS_NONE] || checksums[TEXTURE_LAYOUT_FILE] != checksums[TEXTURE_LAYOUT_MIPS_LZ4])
+        printf("checksum mismatch\n");
+
+    std::filesystem::remove_all(root);
+}
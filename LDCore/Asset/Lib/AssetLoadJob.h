@@ -1,10 +1,14 @@
 #pragma once
 
 #include <Ludens/Asset/AssetManager.h>
+#include <Ludens/Asset/AssetPack.h>
 #include <Ludens/DSA/String.h>
+#include <Ludens/Header/Assert.h>
 #include <Ludens/JobSystem/JobSystem.h>
+#include <Ludens/Memory/Memory.h>
 
 #include <atomic>
+#include <format>
 
 namespace LD {
 
@@ -18,8 +22,11 @@ struct AssetLoadJob
     AssetEntry assetEntry;          /// accessed by job thread, src asset to load
     AssetLoadStatus status;         /// load status
     FS::Path assetDirPath;          /// absolute path to asset directory
+    AssetPack assetPack;            /// if valid, asset files are read from the pack instead of the asset directory
     std::atomic_bool jobInProgress; /// read by main thread
     std::atomic<float> jobProgress; /// read by main thread, normalized job progress estimate
+    FS::FileMapping fileMapping;    /// binary file mapping, released after load unless the asset takes ownership
+    byte* unpackData;               /// decompressed binary from pack, released after load unless the asset takes ownership
 
     /// @brief Check predicate or update status with an error.
     inline bool require(bool pred, const char* str)
@@ -34,6 +41,111 @@ struct AssetLoadJob
         return true;
     }
 
+    /// @brief Try mapping file for reading, updates status upon failure.
+    ///        The view is valid until the load job completes, assets that reference the
+    ///        view afterwards should take ownership of fileMapping.
+    inline bool map_file(const FS::Path& path, View& view)
+    {
+        LD_ASSERT(!fileMapping);
+
+        fileMapping = FS::FileMapping::create(path, status.str);
+        if (!fileMapping)
+        {
+            status.type = ASSET_LOAD_ERROR_FILE_PATH;
+            return false;
+        }
+
+        view = fileMapping.view();
+        return true;
+    }
+
+    /// @brief Check if the asset binary exists in the asset pack or the asset directory.
+    inline bool has_binary()
+    {
+        if (assetPack)
+            return assetPack.find(assetEntry.get_id(), LD_ASSET_DEFAULT_BINARY_FILE_KEY) != nullptr;
+
+        return FS::exists(assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME);
+    }
+
+    /// @brief Try mapping asset binary for reading, updates status upon failure.
+    ///        Uncompressed pack payloads are referenced in place. The view is valid until
+    ///        the load job completes, assets that reference the view afterwards should take_binary.
+    inline bool map_binary(View& view)
+    {
+        if (!assetPack)
+            return map_file(assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME, view);
+
+        const AssetPackEntry* entry = find_pack_entry(LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+        if (!entry)
+            return false;
+
+        if (entry->compression == ASSET_PACK_COMPRESSION_NONE)
+        {
+            view = assetPack.get_payload(entry);
+            return true;
+        }
+
+        LD_ASSERT(!unpackData);
+        unpackData = (byte*)heap_malloc((size_t)entry->rawSize, MEMORY_USAGE_ASSET);
+
+        if (!assetPack.unpack(entry, MutView(unpackData, (size_t)entry->rawSize), status.str))
+        {
+            heap_free(unpackData);
+            unpackData = nullptr;
+            status.type = ASSET_LOAD_ERROR;
+            return false;
+        }
+
+        view = View(unpackData, (size_t)entry->rawSize);
+        return true;
+    }
+
+    /// @brief Transfer storage behind the view of map_binary to the asset, so the view remains valid
+    ///        after the load job completes. Either output may be null if the storage is owned elsewhere.
+    inline void take_binary(FS::FileMapping& outMapping, byte*& outData)
+    {
+        outMapping = fileMapping;
+        outData = unpackData;
+        fileMapping = {};
+        unpackData = nullptr;
+    }
+
+    /// @brief Try reading an asset file by its registry file path key, updates status upon failure.
+    inline bool read_asset_file_to_str(const char* key, String& str)
+    {
+        if (!assetPack)
+            return read_file_to_str(assetDirPath / FS::Path(assetEntry.get_file_path(key).c_str()), str);
+
+        const AssetPackEntry* entry = find_pack_entry(key);
+        if (!entry)
+            return false;
+
+        str.resize((size_t)entry->rawSize);
+
+        if (!assetPack.unpack(entry, MutView((byte*)str.data(), str.size()), status.str))
+        {
+            status.type = ASSET_LOAD_ERROR;
+            return false;
+        }
+
+        return true;
+    }
+
+    /// @brief Find asset file in pack, updates status upon failure.
+    inline const AssetPackEntry* find_pack_entry(const char* key)
+    {
+        const AssetPackEntry* entry = assetPack.find(assetEntry.get_id(), key);
+
+        if (!entry)
+        {
+            status.str = std::format("asset pack is missing file [{}] of asset {}", key, assetEntry.get_id().to_string());
+            status.type = ASSET_LOAD_ERROR_FILE_PATH;
+        }
+
+        return entry;
+    }
+
     /// @brief Try reading file to vector, updates status upon failure.
     inline bool read_file_to_vector(const FS::Path& path, Vector<byte>& v)
     {
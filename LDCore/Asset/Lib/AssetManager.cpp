@@ -13,6 +13,7 @@
 #include <Ludens/RenderComponent/Layout/RMaterial.h>
 #include <Ludens/RenderComponent/Layout/RMesh.h>
 
+#include <algorithm>
 #include <string>
 
 #include "AssetLoadJob.h"
@@ -64,6 +65,17 @@ AssetManagerObj::AssetManagerObj(const AssetManagerInfo& info)
         mWatcher.startup(watcherI);
     }
 
+    if (!info.packPath.empty())
+    {
+        String err;
+        mPack = AssetPack::create(info.packPath, err);
+
+        if (mPack)
+            sLog.info("reading assets from pack [{}], {} files", info.packPath.string(), mPack.get_entry_count());
+        else
+            sLog.error("failed to open asset pack [{}]: {}", info.packPath.string(), err);
+    }
+
     PoolAllocatorInfo paI{};
     paI.blockSize = sizeof(AssetLoadJob);
     paI.isMultiPage = true;
@@ -76,11 +88,19 @@ AssetManagerObj::~AssetManagerObj()
 {
     LD_PROFILE_SCOPE;
 
-    free_load_jobs();
+    Vector<AssetLoadStatus> errors;
+
+    while (!mLoadBatches.empty())
+        end_load_batch(mLoadBatches.back(), errors);
+
     PoolAllocator::destroy(mLoadJobPA);
 
     unload_all_assets();
 
+    // assets may reference pack payloads in place
+    if (mPack)
+        AssetPack::destroy(mPack);
+
     for (auto pa : mAssetPA)
     {
         if (pa)
@@ -164,6 +184,10 @@ AssetLoadJob* AssetManagerObj::allocate_load_job(AssetEntry entry, AssetObj* ass
     job->jobHeader.onComplete = &AssetManagerObj::on_asset_load_complete;
     job->jobHeader.type = (uint32_t)0; // TODO: job type for asset loading
     job->jobHeader.user = (void*)job;
+    job->jobHeader.counter = nullptr;
+    job->assetPack = mPack;
+    job->fileMapping = {};
+    job->unpackData = nullptr;
 
     // NOTE: job is already considered in-progress before its submission
     job->jobInProgress.store(true, std::memory_order_release);
@@ -172,28 +196,46 @@ AssetLoadJob* AssetManagerObj::allocate_load_job(AssetEntry entry, AssetObj* ass
     return job;
 }
 
-void AssetManagerObj::free_load_jobs()
+void AssetManagerObj::free_load_jobs(AssetLoadBatchObj* batch)
 {
-    for (AssetLoadJob* job : mLoadJobs)
+    LD_ASSERT(batch->counter.is_zero());
+
+    for (AssetLoadJob* job : batch->jobs)
     {
         job->~AssetLoadJob();
         mLoadJobPA.free(job);
     }
 
-    mLoadJobs.clear();
+    batch->jobs.clear();
 }
 
 bool AssetManagerObj::has_load_job()
 {
-    for (AssetLoadJob* job : mLoadJobs)
+    for (AssetLoadBatchObj* batch : mLoadBatches)
     {
-        if (job->jobInProgress.load(std::memory_order_acquire))
+        if (!batch->counter.is_zero())
             return true;
     }
 
     return false;
 }
 
+float AssetManagerObj::get_load_progress()
+{
+    float progress = 0.0f;
+    size_t jobCount = 0;
+
+    for (AssetLoadBatchObj* batch : mLoadBatches)
+    {
+        for (AssetLoadJob* job : batch->jobs)
+            progress += job->jobProgress.load(std::memory_order_acquire);
+
+        jobCount += batch->jobs.size();
+    }
+
+    return jobCount == 0 ? 1.0f : progress / (float)jobCount;
+}
+
 void AssetManagerObj::poll()
 {
     if (mWatcher)
@@ -202,43 +244,59 @@ void AssetManagerObj::poll()
 
 void AssetManagerObj::begin_load_batch()
 {
-    LD_ASSERT(!mInLoadBatch);
+    LD_ASSERT(!mLoadBatch);
+
+    mLoadBatch = heap_new<AssetLoadBatchObj>(MEMORY_USAGE_ASSET);
+    mLoadBatches.push_back(mLoadBatch);
+}
+
+AssetLoadBatchObj* AssetManagerObj::submit_load_batch()
+{
+    LD_ASSERT(mLoadBatch);
 
-    mInLoadBatch = true;
+    AssetLoadBatchObj* batch = mLoadBatch;
+    mLoadBatch = nullptr;
 
-    // just sanity checking
-    free_load_jobs();
+    return batch;
 }
 
-bool AssetManagerObj::end_load_batch(Vector<AssetLoadStatus>& outErrors)
+bool AssetManagerObj::end_load_batch(AssetLoadBatchObj* batch, Vector<AssetLoadStatus>& outErrors)
 {
-    LD_ASSERT(mInLoadBatch);
+    LD_PROFILE_SCOPE;
 
-    mInLoadBatch = false;
+    auto it = std::find(mLoadBatches.begin(), mLoadBatches.end(), batch);
+    LD_ASSERT(it != mLoadBatches.end());
+    mLoadBatches.erase(it);
 
-    // TODO: wait for asset load jobs only
-    JobSystem::get().wait_all();
+    if (batch == mLoadBatch)
+        mLoadBatch = nullptr;
+
+    // only waits on jobs of this batch, the main thread helps with pending jobs meanwhile
+    JobSystem::get().wait(&batch->counter);
 
-    std::string err;
     outErrors.clear();
 
-    for (AssetLoadJob* job : mLoadJobs)
+    for (AssetLoadJob* job : batch->jobs)
     {
         if (!job->status)
             outErrors.push_back(job->status);
-
-        job->~AssetLoadJob();
-        mLoadJobPA.free(job);
     }
 
-    mLoadJobs.clear();
+    free_load_jobs(batch);
+    heap_delete<AssetLoadBatchObj>(batch);
 
     return outErrors.empty();
 }
 
+void AssetManagerObj::wait_load_batches()
+{
+    for (AssetLoadBatchObj* batch : mLoadBatches)
+        JobSystem::get().wait(&batch->counter);
+}
+
 void AssetManagerObj::load_asset(AssetEntry entry)
 {
-    LD_ASSERT(mInLoadBatch);
+    LD_ASSERT(mLoadBatch);
     LD_ASSERT(!env.rootPath.empty());
 
     if (!entry)
@@ -259,7 +317,8 @@ void AssetManagerObj::load_asset(AssetEntry entry)
 
     AssetObj* obj = allocate_asset(entry);
     AssetLoadJob* job = allocate_load_job(entry, obj, dirPath);
-    mLoadJobs.push_back(job);
+    job->jobHeader.counter = &mLoadBatch->counter;
+    mLoadBatch->jobs.push_back(job);
 
     // We need to guarantee that the address of the job header does not change.
     // method 1. allocations from a PoolAllocator do not migrate
@@ -269,6 +328,9 @@ void AssetManagerObj::load_asset(AssetEntry entry)
 
 void AssetManagerObj::unload_all_assets()
 {
+    // worker threads may still be writing to assets of in-flight batches
+    wait_load_batches();
+
     std::vector<AssetObj*> assets;
     assets.reserve(mAssets.size());
 
@@ -338,6 +400,19 @@ void AssetManagerObj::on_asset_load_complete(void* user)
 {
     auto* job = (AssetLoadJob*)user;
 
+    // transient mapping of the asset binary, unless the asset took ownership
+    if (job->fileMapping)
+    {
+        FS::FileMapping::destroy(job->fileMapping);
+        job->fileMapping = {};
+    }
+
+    if (job->unpackData)
+    {
+        heap_free(job->unpackData);
+        job->unpackData = nullptr;
+    }
+
     job->jobInProgress.store(false, std::memory_order_release);
     job->jobProgress.store(1.0f, std::memory_order_release);
 }
@@ -346,6 +421,38 @@ void AssetManagerObj::on_asset_load_complete(void* user)
 // Public API
 //
 
+bool AssetLoadBatch::is_complete()
+{
+    return mObj->counter.is_zero();
+}
+
+float AssetLoadBatch::get_progress()
+{
+    if (mObj->jobs.empty())
+        return 1.0f;
+
+    float progress = 0.0f;
+
+    for (AssetLoadJob* job : mObj->jobs)
+        progress += job->jobProgress.load(std::memory_order_acquire);
+
+    return progress / (float)mObj->jobs.size();
+}
+
+void AssetLoadBatch::get_loaded_assets(Vector<Asset>& outAssets)
+{
+    outAssets.clear();
+
+    for (AssetLoadJob* job : mObj->jobs)
+    {
+        // status is written by the worker before the job is marked complete
+        if (job->jobInProgress.load(std::memory_order_acquire) || !job->status)
+            continue;
+
+        outAssets.push_back(job->assetHandle);
+    }
+}
+
 AssetType Asset::get_type()
 {
     return mObj->type;
@@ -452,9 +559,21 @@ void AssetManager::begin_load_batch()
     mObj->begin_load_batch();
 }
 
+AssetLoadBatch AssetManager::submit_load_batch()
+{
+    return AssetLoadBatch(mObj->submit_load_batch());
+}
+
 bool AssetManager::end_load_batch(Vector<AssetLoadStatus>& outErrors)
 {
-    return mObj->end_load_batch(outErrors);
+    return mObj->end_load_batch(mObj->submit_load_batch(), outErrors);
+}
+
+bool AssetManager::end_load_batch(AssetLoadBatch batch, Vector<AssetLoadStatus>& outErrors)
+{
+    LD_ASSERT(batch);
+
+    return mObj->end_load_batch(batch.unwrap(), outErrors);
 }
 
 bool AssetManager::has_load_job()
@@ -462,6 +581,11 @@ bool AssetManager::has_load_job()
     return mObj->has_load_job();
 }
 
+float AssetManager::get_load_progress()
+{
+    return mObj->get_load_progress();
+}
+
 SUID AssetManager::get_id_from_name(const char* name, AssetType* outType)
 {
     return mObj->get_id_from_name(name, outType);
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Ludens/Asset/AssetManager.h>
+#include <Ludens/Asset/AssetPack.h>
 #include <Ludens/Asset/AssetType/AudioClipAsset.h>
 #include <Ludens/Asset/AssetType/LuaScriptAsset.h>
 #include <Ludens/Asset/AssetType/MeshAsset.h>
@@ -12,6 +13,7 @@
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/DataRegistry/DataRegistry.h>
 #include <Ludens/Header/Hash.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Media/AudioData.h>
 #include <Ludens/Media/Bitmap.h>
 #include <Ludens/Media/Font.h>
@@ -48,6 +50,13 @@ struct AssetMeta
 
 extern AssetMeta sAssetMeta[];
 
+/// @brief Asset load jobs tracked by a single counter.
+struct AssetLoadBatchObj
+{
+    JobCounter counter;         /// outstanding load jobs of this batch
+    Vector<AssetLoadJob*> jobs; /// load jobs of this batch, freed when the batch ends
+};
+
 /// @brief Asset manager implementation.
 class AssetManagerObj
 {
@@ -66,13 +75,16 @@ public:
     void unregister_asset(AssetObj* obj);
 
     AssetLoadJob* allocate_load_job(AssetEntry entry, AssetObj* assetObj, const FS::Path& loadPath);
-    void free_load_jobs();
+    void free_load_jobs(AssetLoadBatchObj* batch);
     bool has_load_job();
+    float get_load_progress();
 
     void poll();
 
     void begin_load_batch();
-    bool end_load_batch(Vector<AssetLoadStatus>& outErrors);
+    AssetLoadBatchObj* submit_load_batch();
+    bool end_load_batch(AssetLoadBatchObj* batch, Vector<AssetLoadStatus>& outErrors);
+    void wait_load_batches();
     void load_asset(AssetEntry entry);
     void unload_all_assets();
 
@@ -96,10 +108,11 @@ public:
 private:
     Array<PoolAllocator, ASSET_TYPE_ENUM_COUNT> mAssetPA = {};
     HashMap<SUID, AssetObj*> mAssets;
-    Vector<AssetLoadJob*> mLoadJobs;
-    PoolAllocator mLoadJobPA = {}; /// provides address stability for each load job
-    AssetWatcher mWatcher;         /// optional asset file watcher
-    bool mInLoadBatch = false;     /// is within load batch scope
+    Vector<AssetLoadBatchObj*> mLoadBatches; /// batches that have not ended, including the current batch
+    AssetLoadBatchObj* mLoadBatch = nullptr;  /// current batch receiving load jobs
+    PoolAllocator mLoadJobPA = {};            /// provides address stability for each load job
+    AssetWatcher mWatcher;                    /// optional asset file watcher
+    AssetPack mPack = {};                     /// optional asset pack, replaces the storage directory
 };
 
 /// @brief Polymorphic unload/cleanup for each asset type.
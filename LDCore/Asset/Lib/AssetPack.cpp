@@ -0,0 +1,354 @@
+#include <Ludens/Asset/AssetPack.h>
+#include <Ludens/DSA/Vector.h>
+#include <Ludens/Header/Assert.h>
+#include <Ludens/Header/Hash.h>
+#include <Ludens/Memory/Memory.h>
+#include <Ludens/Profiler/Profiler.h>
+#include <Ludens/Serial/Compress.h>
+#include <Ludens/Serial/Serial.h>
+
+#include <algorithm>
+#include <cstring>
+#include <format>
+#include <fstream>
+
+// magic, version, entry count, reserved
+#define ASSET_PACK_HEADER_SIZE 16
+// id, key hash, compression, reserved, offset, size, raw size
+#define ASSET_PACK_ENTRY_SIZE 40
+
+namespace LD {
+
+struct AssetPackObj
+{
+    FS::FileMapping mapping;
+    View file;
+    Vector<AssetPackEntry> entries;
+};
+
+struct AssetPackWriterObj
+{
+    Vector<AssetPackEntry> entries;
+    Vector<Vector<byte>> payloads; // stored payload of each entry
+};
+
+static inline uint32_t get_key_hash(const char* key)
+{
+    return hash32_FNV_1a(key, (int)strlen(key));
+}
+
+static inline bool entry_less(const AssetPackEntry& lhs, const AssetPackEntry& rhs)
+{
+    if ((uint32_t)lhs.id != (uint32_t)rhs.id)
+        return (uint32_t)lhs.id < (uint32_t)rhs.id;
+
+    return lhs.keyHash < rhs.keyHash;
+}
+
+static inline size_t align_up(size_t offset)
+{
+    return (offset + LD_ASSET_PACK_ALIGNMENT - 1) & ~(size_t)(LD_ASSET_PACK_ALIGNMENT - 1);
+}
+
+static bool validate_pack(AssetPackObj* obj, String& err)
+{
+    if (obj->file.size < ASSET_PACK_HEADER_SIZE || memcmp(obj->file.data, LD_ASSET_PACK_MAGIC, 4))
+    {
+        err = "invalid asset pack magic";
+        return false;
+    }
+
+    Deserializer serial(obj->file);
+    serial.advance(4);
+
+    uint32_t version, entryCount, reserved;
+    serial.read_u32(version);
+    serial.read_u32(entryCount);
+    serial.read_u32(reserved);
+
+    if (version != LD_ASSET_PACK_VERSION)
+    {
+        err = std::format("unsupported asset pack version {}", version);
+        return false;
+    }
+
+    if (obj->file.size < ASSET_PACK_HEADER_SIZE + (uint64_t)entryCount * ASSET_PACK_ENTRY_SIZE)
+    {
+        err = "truncated asset pack table of contents";
+        return false;
+    }
+
+    obj->entries.resize(entryCount);
+
+    for (AssetPackEntry& entry : obj->entries)
+    {
+        uint32_t id, compression;
+        serial.read_u32(id);
+        serial.read_u32(entry.keyHash);
+        serial.read_u32(compression);
+        serial.read_u32(reserved);
+        serial.read_u64(entry.offset);
+        serial.read_u64(entry.size);
+        serial.read_u64(entry.rawSize);
+        entry.id = id;
+        entry.compression = (AssetPackCompression)compression;
+
+        if (entry.offset > obj->file.size || entry.size > obj->file.size - entry.offset)
+        {
+            err = std::format("asset pack entry of asset {} is out of bounds", entry.id.to_string());
+            return false;
+        }
+
+        if (compression != ASSET_PACK_COMPRESSION_NONE && compression != ASSET_PACK_COMPRESSION_LZ4 && compression != ASSET_PACK_COMPRESSION_ZSTD)
+        {
+            err = std::format("asset pack entry of asset {} has unknown compression {}", entry.id.to_string(), compression);
+            return false;
+        }
+
+        // uncompressed payloads are copied as is
+        if (entry.compression == ASSET_PACK_COMPRESSION_NONE && entry.rawSize != entry.size)
+        {
+            err = std::format("asset pack entry of asset {} has mismatching sizes", entry.id.to_string());
+            return false;
+        }
+    }
+
+    if (!std::is_sorted(obj->entries.begin(), obj->entries.end(), &entry_less))
+    {
+        err = "asset pack table of contents is not sorted";
+        return false;
+    }
+
+    return true;
+}
+
+AssetPack AssetPack::create(const FS::Path& path, String& err)
+{
+    LD_PROFILE_SCOPE;
+
+    FS::FileMapping mapping = FS::FileMapping::create(path, err);
+    if (!mapping)
+        return {};
+
+    auto* obj = heap_new<AssetPackObj>(MEMORY_USAGE_ASSET);
+    obj->mapping = mapping;
+    obj->file = mapping.view();
+
+    if (!validate_pack(obj, err))
+    {
+        FS::FileMapping::destroy(mapping);
+        heap_delete<AssetPackObj>(obj);
+        return {};
+    }
+
+    return AssetPack(obj);
+}
+
+void AssetPack::destroy(AssetPack pack)
+{
+    AssetPackObj* obj = pack.unwrap();
+
+    FS::FileMapping::destroy(obj->mapping);
+
+    heap_delete<AssetPackObj>(obj);
+}
+
+const AssetPackEntry* AssetPack::find(AssetID id, const char* key)
+{
+    AssetPackEntry target{};
+    target.id = id;
+    target.keyHash = get_key_hash(key);
+
+    auto it = std::lower_bound(mObj->entries.begin(), mObj->entries.end(), target, &entry_less);
+
+    if (it == mObj->entries.end() || it->id != id || it->keyHash != target.keyHash)
+        return nullptr;
+
+    return &*it;
+}
+
+View AssetPack::get_payload(const AssetPackEntry* entry)
+{
+    return View(mObj->file.data + entry->offset, (size_t)entry->size);
+}
+
+bool AssetPack::unpack(const AssetPackEntry* entry, MutView dst, String& err)
+{
+    LD_PROFILE_SCOPE;
+    LD_ASSERT(dst.size >= entry->rawSize);
+
+    View payload = get_payload(entry);
+    size_t rawSize = (size_t)entry->rawSize;
+    size_t unpackSize = 0;
+
+    switch (entry->compression)
+    {
+    case ASSET_PACK_COMPRESSION_LZ4:
+        unpackSize = lz4_decompress(dst.data, rawSize, payload.data, payload.size);
+        break;
+    case ASSET_PACK_COMPRESSION_ZSTD:
+        unpackSize = zstd_decompress(dst.data, rawSize, payload.data, payload.size);
+        break;
+    case ASSET_PACK_COMPRESSION_NONE:
+        LD_ASSERT(payload.size == rawSize); // validated on create
+        memcpy(dst.data, payload.data, payload.size);
+        unpackSize = payload.size;
+        break;
+    default:
+        break;
+    }
+
+    if (unpackSize != rawSize)
+    {
+        err = std::format("corrupt asset pack payload of asset {}", entry->id.to_string());
+        return false;
+    }
+
+    return true;
+}
+
+size_t AssetPack::get_entry_count()
+{
+    return mObj->entries.size();
+}
+
+AssetPackWriter AssetPackWriter::create()
+{
+    auto* obj = heap_new<AssetPackWriterObj>(MEMORY_USAGE_ASSET);
+
+    return AssetPackWriter(obj);
+}
+
+void AssetPackWriter::destroy(AssetPackWriter writer)
+{
+    AssetPackWriterObj* obj = writer.unwrap();
+
+    heap_delete<AssetPackWriterObj>(obj);
+}
+
+void AssetPackWriter::add_file(AssetID id, const char* key, View data, AssetPackCompression compression)
+{
+    LD_PROFILE_SCOPE;
+
+    AssetPackEntry entry{};
+    entry.id = id;
+    entry.keyHash = get_key_hash(key);
+    entry.compression = ASSET_PACK_COMPRESSION_NONE;
+    entry.rawSize = data.size;
+
+    Vector<byte> payload;
+
+    if (compression == ASSET_PACK_COMPRESSION_LZ4 && data.size > 0)
+    {
+        payload.resize(lz4_compress_bound(data.size));
+        payload.resize(lz4_compress(payload.data(), payload.size(), data.data, data.size));
+    }
+    else if (compression == ASSET_PACK_COMPRESSION_ZSTD && data.size > 0)
+    {
+        payload.resize(zstd_compress_bound(data.size));
+        payload.resize(zstd_compress(payload.data(), payload.size(), data.data, data.size, 3));
+    }
+
+    // already compressed media such as PNG and OGG do not shrink
+    if (!payload.empty() && payload.size() < data.size)
+        entry.compression = compression;
+    else
+        payload.assign(data.data, data.data + data.size);
+
+    entry.size = payload.size();
+
+    mObj->entries.push_back(entry);
+    mObj->payloads.push_back(std::move(payload));
+}
+
+bool AssetPackWriter::write(const FS::Path& path, String& err)
+{
+    LD_PROFILE_SCOPE;
+
+    const size_t entryCount = mObj->entries.size();
+    Vector<size_t> order(entryCount);
+
+    for (size_t i = 0; i < entryCount; i++)
+        order[i] = i;
+
+    std::sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+        return entry_less(mObj->entries[lhs], mObj->entries[rhs]);
+    });
+
+    for (size_t i = 1; i < entryCount; i++)
+    {
+        const AssetPackEntry& prev = mObj->entries[order[i - 1]];
+        const AssetPackEntry& entry = mObj->entries[order[i]];
+
+        if (prev.id == entry.id && prev.keyHash == entry.keyHash)
+        {
+            err = std::format("duplicate file key in asset {}", entry.id.to_string());
+            return false;
+        }
+    }
+
+    // payloads follow the table of contents in the same order
+    size_t offset = align_up(ASSET_PACK_HEADER_SIZE + entryCount * ASSET_PACK_ENTRY_SIZE);
+
+    for (size_t idx : order)
+    {
+        AssetPackEntry& entry = mObj->entries[idx];
+        entry.offset = offset;
+        offset = align_up(offset + entry.size);
+    }
+
+    // only the table of contents is serialized in memory, payloads are streamed after it
+    Serializer serial;
+    serial.write((const byte*)LD_ASSET_PACK_MAGIC, 4);
+    serial.write_u32(LD_ASSET_PACK_VERSION);
+    serial.write_u32((uint32_t)entryCount);
+    serial.write_u32(0);
+
+    for (size_t idx : order)
+    {
+        const AssetPackEntry& entry = mObj->entries[idx];
+        serial.write_u32((uint32_t)entry.id);
+        serial.write_u32(entry.keyHash);
+        serial.write_u32((uint32_t)entry.compression);
+        serial.write_u32(0);
+        serial.write_u64(entry.offset);
+        serial.write_u64(entry.size);
+        serial.write_u64(entry.rawSize);
+    }
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+    if (!file.is_open())
+    {
+        err = std::format("failed to open file [{}]", path.string());
+        return false;
+    }
+
+    file.write((const char*)serial.data(), serial.size());
+    size_t fileSize = serial.size();
+    const char zeros[LD_ASSET_PACK_ALIGNMENT] = {};
+
+    for (size_t idx : order)
+    {
+        const AssetPackEntry& entry = mObj->entries[idx];
+        const Vector<byte>& payload = mObj->payloads[idx];
+
+        size_t padding = entry.offset - fileSize;
+        LD_ASSERT(padding < LD_ASSET_PACK_ALIGNMENT);
+        file.write(zeros, padding);
+        file.write((const char*)payload.data(), payload.size());
+        fileSize = entry.offset + payload.size();
+    }
+
+    file.close();
+
+    if (!file)
+    {
+        err = std::format("failed to write file [{}]", path.string());
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace LD
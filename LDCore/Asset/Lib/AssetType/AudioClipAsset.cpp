@@ -10,13 +10,13 @@
 
 namespace LD {
 
-bool AudioClipAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& filePath)
+bool AudioClipAssetObj::load_from_binary(AssetLoadJob& job)
 {
-    Vector<byte> tmp;
-    if (!job.read_file_to_vector(filePath, tmp))
+    View file;
+    if (!job.map_binary(file))
         return false;
 
-    Deserializer serial(tmp.data(), tmp.size());
+    Deserializer serial(file.data, file.size);
 
     AssetType type;
     uint16_t major, minor, patch;
@@ -68,9 +68,8 @@ void AudioClipAssetObj::load(void* user)
     auto& job = *(AssetLoadJob*)user;
     AudioClipAssetObj* obj = (AudioClipAssetObj*)job.assetHandle.unwrap();
 
-    FS::Path filePath = job.assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME;
-    if (FS::exists(filePath))
-        obj->load_from_binary(job, filePath);
+    if (job.has_binary())
+        obj->load_from_binary(job);
 }
 
 void AudioClipAssetObj::unload(AssetObj* base)
@@ -7,13 +7,13 @@
 
 namespace LD {
 
-bool FontAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& filePath)
+bool FontAssetObj::load_from_binary(AssetLoadJob& job)
 {
-    Vector<byte> tmp;
-    if (!job.read_file_to_vector(filePath, tmp))
+    View file;
+    if (!job.map_binary(file))
         return false;
 
-    Deserializer serial(tmp.data(), tmp.size());
+    Deserializer serial(file.data, file.size);
 
     AssetType type;
     uint16_t major, minor, patch;
@@ -57,9 +57,8 @@ void FontAssetObj::load(void* user)
     auto& job = *(AssetLoadJob*)user;
     auto* obj = (FontAssetObj*)job.assetHandle.unwrap();
 
-    FS::Path filePath = job.assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME;
-    if (FS::exists(filePath))
-        obj->load_from_binary(job, filePath);
+    if (job.has_binary())
+        obj->load_from_binary(job);
 }
 
 void FontAssetObj::unload(AssetObj* base)
@@ -13,14 +13,14 @@
 
 namespace LD {
 
-// TODO: this isn't really binary, source code should be baked into LuaJIT bytecode
-bool LuaScriptAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& filePath)
+// Source is always loaded for debugging and as a fallback, bytecode is loaded if the builder baked it.
+bool LuaScriptAssetObj::load_from_binary(AssetLoadJob& job)
 {
-    Vector<byte> file;
-    if (!job.read_file_to_vector(filePath, file))
+    View file;
+    if (!job.map_binary(file))
         return false;
 
-    Deserializer serial(file.data(), file.size());
+    Deserializer serial(file.data, file.size);
 
     AssetType type;
     uint16_t major, minor, patch;
@@ -44,10 +44,16 @@ bool LuaScriptAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& file
             domain = (LuaScriptDomain)domainU32;
             continue;
         }
+        else if (chunkName == "BCOD")
+        {
+            bytecode.clear();
+            bytecode.write(chunkData, chunkSize);
+        }
+
+        serial.advance(chunkSize);
     }
 
-    FS::Path sourcePath = job.assetDirPath / FS::Path(job.assetEntry.get_file_path("source").c_str());
-    if (!job.read_file_to_str(sourcePath, source))
+    if (!job.read_asset_file_to_str("source", source))
         return false;
 
     return true;
@@ -70,16 +76,17 @@ void LuaScriptAssetObj::load(void* user)
     auto& job = *(AssetLoadJob*)user;
     LuaScriptAssetObj* obj = (LuaScriptAssetObj*)job.assetHandle.unwrap();
 
-    FS::Path filePath = job.assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME;
-    if (FS::exists(filePath))
-        obj->load_from_binary(job, filePath);
+    if (job.has_binary())
+        obj->load_from_binary(job);
 
     // TODO:
 }
 
 void LuaScriptAssetObj::unload(AssetObj* base)
 {
-    (void)base;
+    LuaScriptAssetObj& self = *(LuaScriptAssetObj*)base;
+
+    self.bytecode.clear();
 }
 
 void LuaScriptAsset::unload()
@@ -106,12 +113,20 @@ View LuaScriptAsset::get_source()
     return View(obj->source.data(), obj->source.size());
 }
 
+View LuaScriptAsset::get_bytecode()
+{
+    auto* obj = (LuaScriptAssetObj*)mObj;
+
+    return obj->bytecode.view();
+}
+
 void LuaScriptAsset::set_source(View source)
 {
     auto* obj = (LuaScriptAssetObj*)mObj;
 
     obj->source.resize(source.size);
     memcpy(obj->source.data(), source.data, source.size);
+    obj->bytecode.clear(); // stale, recompile from source
 }
 
 } // namespace LD
\ No newline at end of file
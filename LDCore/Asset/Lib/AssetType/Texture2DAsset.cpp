@@ -6,22 +6,20 @@
 #include <Ludens/Serial/Serial.h>
 #include <Ludens/System/FileSystem.h>
 
+#include <algorithm>
+
 #include "../AssetLoadJob.h"
 #include "../AssetMeta.h"
 
 namespace LD {
 
-bool Texture2DAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& filePath)
+bool Texture2DAssetObj::load_from_binary(AssetLoadJob& job)
 {
-    uint64_t serialSize;
-    if (!job.get_file_size(filePath, serialSize))
-        return false;
-
-    serialData.resize(serialSize);
-    if (!job.read_file(filePath, MutView(serialData.data(), serialSize)))
+    View serialView;
+    if (!job.map_binary(serialView))
         return false;
 
-    Deserializer serial(serialData.data(), serialSize);
+    Deserializer serial(serialView.data, serialView.size);
 
     AssetType type;
     uint16_t major, minor, patch;
@@ -34,6 +32,16 @@ bool Texture2DAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& file
     if (!Texture2DAssetObj::deserialize(serial, *this))
         return false;
 
+    // pre-decoded pixels are copied out of the binary, which is released with the load job
+    if (bitmap)
+    {
+        fileView = {};
+        return true;
+    }
+
+    // fileView points into the binary, keep its storage alive with the asset
+    job.take_binary(fileMapping, unpackData);
+
     bitmap = Bitmap::create_from_file_data(fileView);
     if (!job.require(bitmap, "failed to create Bitmap"))
         return false;
@@ -43,7 +51,12 @@ bool Texture2DAssetObj::load_from_binary(AssetLoadJob& job, const FS::Path& file
 
 bool Texture2DAssetObj::serialize(Serializer& serial, const Texture2DAssetObj& obj)
 {
+    // pre-decoded textures no longer have the source file, the importer writes their pixels
+    if (!obj.fileView)
+        return false;
+
     serialize_sampler_info(serial, obj.samplerHint);
+
     serial.write_chunk_begin("FILE");
     serial.write((const byte*)obj.fileView.data, obj.fileView.size);
     serial.write_chunk_end();
@@ -60,6 +73,41 @@ void Texture2DAssetObj::serialize_sampler_info(Serializer& serial, const RSample
     serial.write_chunk_end();
 }
 
+void Texture2DAssetObj::serialize_mip_chain(Serializer& serial, Bitmap base, BitmapCompression compression)
+{
+    LD_PROFILE_SCOPE;
+
+    uint32_t levelCount = 1;
+    for (uint32_t size = std::max(base.width(), base.height()); size > 1; size /= 2)
+        levelCount++;
+
+    serial.write_chunk_begin("MIPS");
+    serial.write_u32(levelCount);
+
+    base.set_compression(compression);
+    Bitmap::serialize(serial, base);
+
+    // each level is filtered from the previous one and released once serialized
+    Bitmap level = base;
+
+    for (uint32_t i = 1; i < levelCount; i++)
+    {
+        Bitmap half = Bitmap::create_half_size(level);
+        half.set_compression(compression);
+        Bitmap::serialize(serial, half);
+
+        if (i > 1)
+            Bitmap::destroy(level);
+
+        level = half;
+    }
+
+    if (levelCount > 1)
+        Bitmap::destroy(level);
+
+    serial.write_chunk_end();
+}
+
 bool Texture2DAssetObj::deserialize(Deserializer& serial, Texture2DAssetObj& obj)
 {
     std::string name(4, ' ');
@@ -82,6 +130,17 @@ bool Texture2DAssetObj::deserialize(Deserializer& serial, Texture2DAssetObj& obj
             obj.samplerHint.mipmapFilter = (RFilter)mipmapFilterU32;
             obj.samplerHint.addressMode = (RSamplerAddressMode)addressModeU32;
         }
+        else if (name == "MIPS")
+        {
+            uint32_t levelCount;
+            serial.read_u32(levelCount);
+
+            if (levelCount == 0 || !Bitmap::deserialize(serial, obj.bitmap))
+                return false;
+
+            // RImage has no mip levels yet, levels above zero are skipped without decompressing
+            serial.advance(chunkSize - (size_t)(serial.view_now() - chunkData));
+        }
         else if (name == "FILE")
         {
             obj.fileView.size = chunkSize;
@@ -90,7 +149,7 @@ bool Texture2DAssetObj::deserialize(Deserializer& serial, Texture2DAssetObj& obj
         }
     }
 
-    return hasSampChunk && obj.fileView;
+    return hasSampChunk && (obj.bitmap || obj.fileView);
 }
 
 void Texture2DAssetObj::create(AssetObj* base)
@@ -110,9 +169,8 @@ void Texture2DAssetObj::load(void* user)
     auto& job = *(AssetLoadJob*)user;
     Texture2DAssetObj* obj = (Texture2DAssetObj*)job.assetHandle.unwrap();
 
-    FS::Path filePath = job.assetDirPath / LD_ASSET_DEFAULT_BINARY_FILE_NAME;
-    if (FS::exists(filePath))
-        obj->load_from_binary(job, filePath);
+    if (job.has_binary())
+        obj->load_from_binary(job);
 }
 
 void Texture2DAssetObj::unload(AssetObj* base)
@@ -125,7 +183,18 @@ void Texture2DAssetObj::unload(AssetObj* base)
         self.bitmap = {};
     }
 
-    self.serialData.clear();
+    if (self.fileMapping)
+    {
+        FS::FileMapping::destroy(self.fileMapping);
+        self.fileMapping = {};
+    }
+
+    if (self.unpackData)
+    {
+        heap_free(self.unpackData);
+        self.unpackData = nullptr;
+    }
+
     self.fileView = {};
 }
 
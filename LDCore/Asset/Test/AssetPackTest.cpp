@@ -0,0 +1,135 @@
+#include <Extra/doctest/doctest.h>
+#include <Ludens/Asset/AssetPack.h>
+#include <Ludens/DSA/Vector.h>
+#include <Ludens/Memory/Memory.h>
+
+#include <cstring>
+#include <string>
+
+using namespace LD;
+
+TEST_CASE("AssetPack")
+{
+    std::string binary1(5000, 'a');
+    std::string binary2 = "not compressed";
+    std::string source = "print('hello')";
+
+    FS::Path path = FS::temp_directory_path() / "ld_asset_pack_test.ldp";
+    String err;
+
+    AssetPackWriter writer = AssetPackWriter::create();
+    writer.add_file(AssetID(42), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View(binary2.data(), binary2.size()), ASSET_PACK_COMPRESSION_NONE);
+    writer.add_file(AssetID(7), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View(binary1.data(), binary1.size()), ASSET_PACK_COMPRESSION_LZ4);
+    writer.add_file(AssetID(7), "source", View(source.data(), source.size()), ASSET_PACK_COMPRESSION_NONE);
+    writer.add_file(AssetID(9), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View{}, ASSET_PACK_COMPRESSION_LZ4);
+    REQUIRE(writer.write(path, err));
+
+    // duplicate keys are rejected
+    writer.add_file(AssetID(7), "source", View(source.data(), source.size()), ASSET_PACK_COMPRESSION_NONE);
+    CHECK_FALSE(writer.write(path, err));
+    AssetPackWriter::destroy(writer);
+
+    AssetPack pack = AssetPack::create(path, err);
+    REQUIRE(pack);
+    CHECK(pack.get_entry_count() == 4);
+    CHECK(pack.find(AssetID(7), "schema") == nullptr);
+    CHECK(pack.find(AssetID(8), LD_ASSET_DEFAULT_BINARY_FILE_KEY) == nullptr);
+
+    const AssetPackEntry* entry = pack.find(AssetID(42), LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+    REQUIRE(entry);
+    CHECK(entry->compression == ASSET_PACK_COMPRESSION_NONE);
+    CHECK(entry->offset % LD_ASSET_PACK_ALIGNMENT == 0);
+    View payload = pack.get_payload(entry);
+    CHECK(payload.size == binary2.size());
+    CHECK(memcmp(payload.data, binary2.data(), payload.size) == 0);
+
+    entry = pack.find(AssetID(7), "source");
+    REQUIRE(entry);
+    payload = pack.get_payload(entry);
+    CHECK(std::string((const char*)payload.data, payload.size) == source);
+
+    entry = pack.find(AssetID(7), LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+    REQUIRE(entry);
+    CHECK(entry->compression == ASSET_PACK_COMPRESSION_LZ4);
+    CHECK(entry->size < entry->rawSize);
+    std::string unpacked(entry->rawSize, ' ');
+    CHECK(pack.unpack(entry, MutView((byte*)unpacked.data(), unpacked.size()), err));
+    CHECK(unpacked == binary1);
+
+    // empty asset files are packed without compression
+    entry = pack.find(AssetID(9), LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+    REQUIRE(entry);
+    CHECK(entry->compression == ASSET_PACK_COMPRESSION_NONE);
+    CHECK(entry->size == 0);
+    CHECK(entry->rawSize == 0);
+
+    AssetPack::destroy(pack);
+    FS::remove(path, err);
+
+    std::string garbage = "definitely not an asset pack";
+    REQUIRE(FS::write_file(path, View(garbage.data(), garbage.size()), err));
+    CHECK_FALSE(AssetPack::create(path, err));
+    FS::remove(path, err);
+
+    CHECK_FALSE(get_memory_leaks(nullptr));
+}
+
+// offsets of the first table of contents entry
+#define TOC_COMPRESSION_OFFSET (16 + 8)
+#define TOC_SIZE_OFFSET (16 + 24)
+#define TOC_RAW_SIZE_OFFSET (16 + 32)
+
+static void write_single_entry_pack(const FS::Path& path, const std::string& data, AssetPackCompression compression, Vector<byte>& file)
+{
+    String err;
+    AssetPackWriter writer = AssetPackWriter::create();
+    writer.add_file(AssetID(7), LD_ASSET_DEFAULT_BINARY_FILE_KEY, View(data.data(), data.size()), compression);
+    REQUIRE(writer.write(path, err));
+    AssetPackWriter::destroy(writer);
+
+    REQUIRE(FS::read_file_to_vector(path, file, err));
+}
+
+TEST_CASE("AssetPack corrupt")
+{
+    FS::Path path = FS::temp_directory_path() / "ld_asset_pack_corrupt_test.ldp";
+    std::string data(5000, 'a');
+    Vector<byte> file;
+    String err;
+
+    SUBCASE("unknown compression")
+    {
+        write_single_entry_pack(path, data, ASSET_PACK_COMPRESSION_NONE, file);
+        file[TOC_COMPRESSION_OFFSET] = 7;
+        REQUIRE(FS::write_file(path, View(file.data(), file.size()), err));
+        CHECK_FALSE(AssetPack::create(path, err));
+    }
+
+    SUBCASE("uncompressed size mismatch")
+    {
+        // a raw size larger than the payload would overflow the destination on unpack
+        write_single_entry_pack(path, data, ASSET_PACK_COMPRESSION_LZ4, file);
+        file[TOC_COMPRESSION_OFFSET] = (byte)ASSET_PACK_COMPRESSION_NONE;
+        REQUIRE(FS::write_file(path, View(file.data(), file.size()), err));
+        CHECK_FALSE(AssetPack::create(path, err));
+    }
+
+    SUBCASE("corrupt payload")
+    {
+        write_single_entry_pack(path, data, ASSET_PACK_COMPRESSION_LZ4, file);
+        file[TOC_RAW_SIZE_OFFSET] += 1; // payload decompresses to fewer bytes than recorded
+        REQUIRE(FS::write_file(path, View(file.data(), file.size()), err));
+
+        AssetPack pack = AssetPack::create(path, err);
+        REQUIRE(pack);
+
+        const AssetPackEntry* entry = pack.find(AssetID(7), LD_ASSET_DEFAULT_BINARY_FILE_KEY);
+        REQUIRE(entry);
+        std::string unpacked(entry->rawSize, ' ');
+        CHECK_FALSE(pack.unpack(entry, MutView((byte*)unpacked.data(), unpacked.size()), err));
+        AssetPack::destroy(pack);
+    }
+
+    FS::remove(path, err);
+    CHECK_FALSE(get_memory_leaks(nullptr));
+}
@@ -0,0 +1,50 @@
+#include <Extra/doctest/doctest.h>
+#include <Ludens/Asset/AssetType/Texture2DAssetObj.h>
+#include <Ludens/Media/Bitmap.h>
+#include <Ludens/Serial/Serial.h>
+
+#include <cstring>
+
+using namespace LD;
+
+TEST_CASE("Texture2DAsset mip chain")
+{
+    uint32_t pixels[8 * 4];
+    for (uint32_t i = 0; i < 8 * 4; i++)
+        pixels[i] = i * 0x01020304;
+
+    Bitmap base = Bitmap::create_from_data(8, 4, BITMAP_FORMAT_RGBA8U, pixels);
+
+    for (BitmapCompression compression : {BITMAP_COMPRESSION_LZ4, BITMAP_COMPRESSION_NONE})
+    {
+        Serializer serial;
+        Texture2DAssetObj::serialize_sampler_info(serial, {});
+        Texture2DAssetObj::serialize_mip_chain(serial, base, compression);
+
+        // 8x4, 4x2, 2x1, 1x1
+        Deserializer reader(serial.data(), serial.size());
+        std::string name(4, ' ');
+        uint32_t chunkSize;
+        REQUIRE(reader.read_chunk(name.data(), chunkSize));
+        reader.advance(chunkSize);
+        REQUIRE(reader.read_chunk(name.data(), chunkSize));
+        CHECK(name == "MIPS");
+
+        uint32_t levelCount;
+        reader.read_u32(levelCount);
+        CHECK(levelCount == 4);
+
+        // only level zero is loaded, the loader skips the rest of the chain
+        Texture2DAssetObj obj{};
+        Deserializer serialIn(serial.data(), serial.size());
+        REQUIRE(Texture2DAssetObj::deserialize(serialIn, obj));
+        REQUIRE(obj.bitmap);
+        CHECK(obj.bitmap.width() == 8);
+        CHECK(obj.bitmap.height() == 4);
+        CHECK(memcmp(obj.bitmap.data(), pixels, sizeof(pixels)) == 0);
+
+        Texture2DAssetObj::unload(&obj);
+    }
+
+    Bitmap::destroy(base);
+}
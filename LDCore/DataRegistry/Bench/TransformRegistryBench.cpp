@@ -0,0 +1,140 @@
+#include <Ludens/DataRegistry/TransformRegistry.h>
+#include <Ludens/Header/Math/Transform.h>
+#include <Ludens/JobSystem/JobSystem.h>
+#include <Ludens/System/Timer.h>
+
+#include <cstdio>
+
+using namespace LD;
+
+constexpr size_t WIDE_COUNT = 131'072;
+constexpr size_t TREE_FANOUT = 8;
+constexpr size_t TREE_DEPTH = 6;
+constexpr int ITERATIONS = 20;
+
+static Transform2D make_transform(uint64_t id)
+{
+    Transform2D tr{};
+    tr.position = Vec2((float)(id % 100), (float)(id % 37));
+    tr.rotation = (float)(id % 360);
+    tr.scale = Vec2(1.0f);
+    return tr;
+}
+
+/// single root with a very wide second depth level
+static void build_wide_scene(Transform2DRegistry& reg)
+{
+    reg.create(1, 0);
+    reg.set_transform(1, make_transform(1));
+
+    for (uint64_t id = 2; id <= WIDE_COUNT + 1; id++)
+    {
+        reg.create(id, 1);
+        reg.set_transform(id, make_transform(id));
+    }
+}
+
+/// balanced tree, each depth level is TREE_FANOUT times wider than the previous one
+static size_t build_tree_scene(Transform2DRegistry& reg)
+{
+    Vector<ID> prevLevel;
+    Vector<ID> level;
+    uint64_t nextID = 1;
+
+    for (size_t i = 0; i < TREE_FANOUT; i++)
+    {
+        reg.create(nextID, 0);
+        reg.set_transform(nextID, make_transform(nextID));
+        prevLevel.push_back(nextID++);
+    }
+
+    for (size_t d = 1; d < TREE_DEPTH; d++)
+    {
+        level.clear();
+
+        for (ID parentID : prevLevel)
+        {
+            for (size_t i = 0; i < TREE_FANOUT; i++)
+            {
+                reg.create(nextID, parentID);
+                reg.set_transform(nextID, make_transform(nextID));
+                level.push_back(nextID++);
+            }
+        }
+
+        std::swap(prevLevel, level);
+    }
+
+    return (size_t)(nextID - 1);
+}
+
+/// invalidate after marking dirtyIDs each iteration, their subtrees are recomputed
+static float bench_invalidate(Transform2DRegistry& reg, size_t threshold, const Vector<ID>& dirtyIDs)
+{
+    reg.set_parallel_threshold(threshold);
+    reg.invalidate_transforms(); // warm up
+
+    size_t us;
+    {
+        ScopeTimer timer(&us);
+
+        for (int i = 0; i < ITERATIONS; i++)
+        {
+            for (ID id : dirtyIDs)
+                reg.mark_dirty(id);
+
+            reg.invalidate_transforms();
+        }
+    }
+
+    return us / 1000.0f / ITERATIONS;
+}
+
+int main(int argc, char** argv)
+{
+    JobSystemInfo jsI{};
+    jsI.immediateQueueCapacity = 256;
+    jsI.standardQueueCapacity = 256;
+    JobSystem::init(jsI);
+
+    printf("worker threads: %d\n", JobSystem::get().get_worker_thread_count());
+
+    {
+        Transform2DRegistry reg;
+        build_wide_scene(reg);
+        Vector<ID> dirtyIDs = {1};
+
+        printf("wide scene %zu transforms, single thread %.3f ms\n", WIDE_COUNT + 1, bench_invalidate(reg, SIZE_MAX, dirtyIDs));
+        printf("wide scene %zu transforms, job system    %.3f ms\n", WIDE_COUNT + 1, bench_invalidate(reg, 8192, dirtyIDs));
+    }
+
+    {
+        Transform2DRegistry reg;
+        size_t count = build_tree_scene(reg);
+        Vector<ID> dirtyIDs;
+        for (uint64_t id = 1; id <= TREE_FANOUT; id++)
+            dirtyIDs.push_back(id);
+
+        printf("tree scene %zu transforms, single thread %.3f ms\n", count, bench_invalidate(reg, SIZE_MAX, dirtyIDs));
+        printf("tree scene %zu transforms, job system    %.3f ms\n", count, bench_invalidate(reg, 8192, dirtyIDs));
+
+        const char* levelNames[] = {"scalar", "SSE2", "AVX2"};
+        for (int level = SIMD_LEVEL_SCALAR; level <= (int)get_cpu_simd_level(); level++)
+        {
+            reg.set_simd_level((SIMDLevel)level);
+            printf("tree scene %zu transforms, %-6s        %.3f ms\n", count, levelNames[level], bench_invalidate(reg, SIZE_MAX, dirtyIDs));
+        }
+        reg.set_simd_level(get_cpu_simd_level());
+
+        // mostly static scene, a single root subtree moves every frame
+        dirtyIDs = {1};
+        float ms = bench_invalidate(reg, SIZE_MAX, dirtyIDs);
+        printf("tree scene %zu transforms, %zu dirty      %.3f ms\n", count, reg.get_recomputed_count(), ms);
+
+        dirtyIDs.clear();
+        ms = bench_invalidate(reg, SIZE_MAX, dirtyIDs);
+        printf("tree scene %zu transforms, %zu dirty      %.3f ms\n", count, reg.get_recomputed_count(), ms);
+    }
+
+    JobSystem::shutdown();
+}
@@ -761,6 +761,15 @@ PoolAllocator::Iterator DataRegistry::get_components(ComponentType type)
     return ite->second.begin();
 }
 
+size_t DataRegistry::get_component_count(ComponentType type)
+{
+    auto ite = mObj->componentPAs.find(type);
+    if (ite == mObj->componentPAs.end())
+        return 0;
+
+    return ite->second.block_count();
+}
+
 bool DataRegistry::get_component_path(CUID compID, Vector<int>& path)
 {
     ComponentBase** data = mObj->get_data_from_cuid(compID);
@@ -840,10 +849,59 @@ bool DataRegistry::set_component_transform_2d(CUID compID, const Transform2D& tr
         return false;
 
     *dstTransform = transform;
+    mObj->transform2DRegistry.mark_dirty(compID);
 
     return true;
 }
 
+size_t DataRegistry::get_component_transforms_2d(const CUID* compIDs, Transform2D* transforms, size_t count)
+{
+    LD_PROFILE_SCOPE;
+
+    size_t copied = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ComponentBase** data = mObj->get_data_from_cuid(compIDs[i]);
+        Transform2D* srcTransform = data ? LD::get_component_transform_2d(data) : nullptr;
+
+        if (!srcTransform)
+            continue;
+
+        transforms[i] = *srcTransform;
+        copied++;
+    }
+
+    return copied;
+}
+
+size_t DataRegistry::set_component_transforms_2d(const CUID* compIDs, const Transform2D* transforms, size_t count)
+{
+    LD_PROFILE_SCOPE;
+
+    size_t written = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        ComponentBase** data = mObj->get_data_from_cuid(compIDs[i]);
+        Transform2D* dstTransform = data ? LD::get_component_transform_2d(data) : nullptr;
+
+        if (!dstTransform)
+            continue;
+
+        *dstTransform = transforms[i];
+        mObj->transform2DRegistry.mark_dirty(compIDs[i]);
+        written++;
+    }
+
+    return written;
+}
+
+void DataRegistry::mark_component_transform_dirty(CUID compID)
+{
+    mObj->transform2DRegistry.mark_dirty(compID);
+}
+
 bool DataRegistry::get_component_world_mat4(CUID compID, Mat4& mat4)
 {
     ComponentBase* base = get_component_base(compID);
@@ -863,6 +921,13 @@ void DataRegistry::invalidate_transforms()
     LD_PROFILE_SCOPE;
 
     mObj->transform2DRegistry.invalidate_transforms();
+
+    LD_PROFILE_PLOT("Transform2D recomputed", (int64_t)mObj->transform2DRegistry.get_recomputed_count());
+}
+
+size_t DataRegistry::get_transform_recomputed_count()
+{
+    return mObj->transform2DRegistry.get_recomputed_count();
 }
 
 String DataRegistry::print_hierarchy()
@@ -0,0 +1,238 @@
+#include "TransformKernel.h"
+
+#if defined(LD_ARCH_X64)
+#include <immintrin.h>
+#endif
+
+// Every kernel evaluates the same expressions in the same order, without FMA contraction,
+// so their results match the scalar Mat4 path of Transform2D::as_mat4():
+//
+//   local = | c*sx  -s*sy  0   px |    world = parent * local, only the xy components of
+//           | s*sx   c*sy  0   py |    parent columns 0, 1, 3 and the z component of parent
+//           | 0      0     lz  0  |    column 2 are not constant for 2D affine transforms.
+//           | 0      0     0   1  |
+//
+// lz = c + (1 - c) is what Mat4::rotate() produces around the Z axis, not always exactly 1.
+
+namespace LD {
+
+static void lanes_scalar(const Transform2DLanes& lanes, size_t begin, size_t end, bool isRoot, Mat4* worldMat4)
+{
+    for (size_t i = begin; i < end; i++)
+    {
+        float la = lanes.rotCos[i] * lanes.scaleX[i];
+        float lb = lanes.rotSin[i] * lanes.scaleX[i];
+        float lc = -lanes.rotSin[i] * lanes.scaleY[i];
+        float ld = lanes.rotCos[i] * lanes.scaleY[i];
+        float lz = lanes.rotCos[i] + (1.0f - lanes.rotCos[i]);
+        float px = lanes.posX[i];
+        float py = lanes.posY[i];
+        Mat4& world = worldMat4[lanes.childSI[i]];
+
+        if (isRoot)
+        {
+            world = Mat4(Vec4(la, lb, 0.0f, 0.0f), Vec4(lc, ld, 0.0f, 0.0f), Vec4(0.0f, 0.0f, lz, 0.0f), Vec4(px, py, 0.0f, 1.0f));
+            continue;
+        }
+
+        const Mat4& parent = worldMat4[lanes.parentSI[i]];
+        float pa = parent[0].x;
+        float pb = parent[0].y;
+        float pc = parent[1].x;
+        float pd = parent[1].y;
+
+        world[0] = Vec4(pa * la + pc * lb, pb * la + pd * lb, 0.0f, 0.0f);
+        world[1] = Vec4(pa * lc + pc * ld, pb * lc + pd * ld, 0.0f, 0.0f);
+        world[2] = Vec4(0.0f, 0.0f, parent[2].z * lz, 0.0f);
+        world[3] = Vec4((pa * px + pc * py) + parent[3].x, (pb * px + pd * py) + parent[3].y, 0.0f, 1.0f);
+    }
+}
+
+#if defined(LD_ARCH_X64)
+
+/// @brief transpose the x and y components of 4 column vectors into 2 lane vectors
+static inline void load_xy_sse2(__m128 v0, __m128 v1, __m128 v2, __m128 v3, __m128& x, __m128& y)
+{
+    __m128 t0 = _mm_unpacklo_ps(v0, v1); // x0 x1 y0 y1
+    __m128 t1 = _mm_unpacklo_ps(v2, v3); // x2 x3 y2 y3
+
+    x = _mm_movelh_ps(t0, t1);
+    y = _mm_movehl_ps(t1, t0);
+}
+
+/// @brief transpose the z components of 4 column vectors into a lane vector
+static inline __m128 load_z_sse2(__m128 v0, __m128 v1, __m128 v2, __m128 v3)
+{
+    __m128 t0 = _mm_unpackhi_ps(v0, v1); // z0 z1 w0 w1
+    __m128 t1 = _mm_unpackhi_ps(v2, v3); // z2 z3 w2 w3
+
+    return _mm_movelh_ps(t0, t1);
+}
+
+/// @brief transpose 4 lanes of world matrix elements back to Mat4 columns
+static inline void store_lanes_sse2(__m128 wa, __m128 wb, __m128 wc, __m128 wd, __m128 wz, __m128 wtx, __m128 wty, const uint32_t* childSI, Mat4* worldMat4)
+{
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 zw = _mm_setr_ps(0.0f, 1.0f, 0.0f, 0.0f);
+
+    __m128 ab[2] = {_mm_unpacklo_ps(wa, wb), _mm_unpackhi_ps(wa, wb)};
+    __m128 cd[2] = {_mm_unpacklo_ps(wc, wd), _mm_unpackhi_ps(wc, wd)};
+    __m128 z[2] = {_mm_unpacklo_ps(wz, zero), _mm_unpackhi_ps(wz, zero)};
+    __m128 t[2] = {_mm_unpacklo_ps(wtx, wty), _mm_unpackhi_ps(wtx, wty)};
+
+    for (int half = 0; half < 2; half++)
+    {
+        Mat4& w0 = worldMat4[childSI[2 * half]];
+        w0[0].simd.data = _mm_movelh_ps(ab[half], zero);
+        w0[1].simd.data = _mm_movelh_ps(cd[half], zero);
+        w0[2].simd.data = _mm_movelh_ps(zero, z[half]);
+        w0[3].simd.data = _mm_movelh_ps(t[half], zw);
+
+        Mat4& w1 = worldMat4[childSI[2 * half + 1]];
+        w1[0].simd.data = _mm_shuffle_ps(ab[half], zero, _MM_SHUFFLE(1, 0, 3, 2));
+        w1[1].simd.data = _mm_shuffle_ps(cd[half], zero, _MM_SHUFFLE(1, 0, 3, 2));
+        w1[2].simd.data = _mm_shuffle_ps(zero, z[half], _MM_SHUFFLE(3, 2, 0, 0));
+        w1[3].simd.data = _mm_shuffle_ps(t[half], zw, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+}
+
+static size_t lanes_sse2(const Transform2DLanes& lanes, size_t begin, size_t end, bool isRoot, Mat4* worldMat4)
+{
+    const __m128 signMask = _mm_set1_ps(-0.0f);
+    const __m128 one = _mm_set1_ps(1.0f);
+    size_t i = begin;
+
+    for (; i + 4 <= end; i += 4)
+    {
+        __m128 rotCos = _mm_loadu_ps(lanes.rotCos + i);
+        __m128 rotSin = _mm_loadu_ps(lanes.rotSin + i);
+        __m128 scaleX = _mm_loadu_ps(lanes.scaleX + i);
+        __m128 scaleY = _mm_loadu_ps(lanes.scaleY + i);
+        __m128 px = _mm_loadu_ps(lanes.posX + i);
+        __m128 py = _mm_loadu_ps(lanes.posY + i);
+
+        __m128 la = _mm_mul_ps(rotCos, scaleX);
+        __m128 lb = _mm_mul_ps(rotSin, scaleX);
+        __m128 lc = _mm_mul_ps(_mm_xor_ps(rotSin, signMask), scaleY);
+        __m128 ld = _mm_mul_ps(rotCos, scaleY);
+        __m128 lz = _mm_add_ps(rotCos, _mm_sub_ps(one, rotCos));
+
+        if (isRoot)
+        {
+            store_lanes_sse2(la, lb, lc, ld, lz, px, py, lanes.childSI + i, worldMat4);
+            continue;
+        }
+
+        const Mat4& p0 = worldMat4[lanes.parentSI[i + 0]];
+        const Mat4& p1 = worldMat4[lanes.parentSI[i + 1]];
+        const Mat4& p2 = worldMat4[lanes.parentSI[i + 2]];
+        const Mat4& p3 = worldMat4[lanes.parentSI[i + 3]];
+
+        __m128 pa, pb, pc, pd, ptx, pty;
+        load_xy_sse2(p0[0].simd.data, p1[0].simd.data, p2[0].simd.data, p3[0].simd.data, pa, pb);
+        load_xy_sse2(p0[1].simd.data, p1[1].simd.data, p2[1].simd.data, p3[1].simd.data, pc, pd);
+        load_xy_sse2(p0[3].simd.data, p1[3].simd.data, p2[3].simd.data, p3[3].simd.data, ptx, pty);
+        __m128 pz = load_z_sse2(p0[2].simd.data, p1[2].simd.data, p2[2].simd.data, p3[2].simd.data);
+
+        __m128 wa = _mm_add_ps(_mm_mul_ps(pa, la), _mm_mul_ps(pc, lb));
+        __m128 wb = _mm_add_ps(_mm_mul_ps(pb, la), _mm_mul_ps(pd, lb));
+        __m128 wc = _mm_add_ps(_mm_mul_ps(pa, lc), _mm_mul_ps(pc, ld));
+        __m128 wd = _mm_add_ps(_mm_mul_ps(pb, lc), _mm_mul_ps(pd, ld));
+        __m128 wz = _mm_mul_ps(pz, lz);
+        __m128 wtx = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pa, px), _mm_mul_ps(pc, py)), ptx);
+        __m128 wty = _mm_add_ps(_mm_add_ps(_mm_mul_ps(pb, px), _mm_mul_ps(pd, py)), pty);
+
+        store_lanes_sse2(wa, wb, wc, wd, wz, wtx, wty, lanes.childSI + i, worldMat4);
+    }
+
+    return i;
+}
+
+LD_TARGET_AVX2 static size_t lanes_avx2(const Transform2DLanes& lanes, size_t begin, size_t end, bool isRoot, Mat4* worldMat4)
+{
+    static_assert(sizeof(Mat4) == 16 * sizeof(float));
+
+    const __m256 signMask = _mm256_set1_ps(-0.0f);
+    const __m256 one = _mm256_set1_ps(1.0f);
+    const float* worldF32 = (const float*)worldMat4;
+    size_t i = begin;
+
+    for (; i + 8 <= end; i += 8)
+    {
+        __m256 rotCos = _mm256_loadu_ps(lanes.rotCos + i);
+        __m256 rotSin = _mm256_loadu_ps(lanes.rotSin + i);
+        __m256 scaleX = _mm256_loadu_ps(lanes.scaleX + i);
+        __m256 scaleY = _mm256_loadu_ps(lanes.scaleY + i);
+        __m256 px = _mm256_loadu_ps(lanes.posX + i);
+        __m256 py = _mm256_loadu_ps(lanes.posY + i);
+
+        __m256 la = _mm256_mul_ps(rotCos, scaleX);
+        __m256 lb = _mm256_mul_ps(rotSin, scaleX);
+        __m256 lc = _mm256_mul_ps(_mm256_xor_ps(rotSin, signMask), scaleY);
+        __m256 ld = _mm256_mul_ps(rotCos, scaleY);
+        __m256 lz = _mm256_add_ps(rotCos, _mm256_sub_ps(one, rotCos));
+        __m256 wa, wb, wc, wd, wz, wtx, wty;
+
+        if (isRoot)
+        {
+            wa = la;
+            wb = lb;
+            wc = lc;
+            wd = ld;
+            wz = lz;
+            wtx = px;
+            wty = py;
+        }
+        else
+        {
+            // float offset of each parent world matrix
+            __m256i base = _mm256_slli_epi32(_mm256_loadu_si256((const __m256i*)(lanes.parentSI + i)), 4);
+
+            __m256 pa = _mm256_i32gather_ps(worldF32, base, 4);
+            __m256 pb = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(1)), 4);
+            __m256 pc = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(4)), 4);
+            __m256 pd = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(5)), 4);
+            __m256 pz = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(10)), 4);
+            __m256 ptx = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(12)), 4);
+            __m256 pty = _mm256_i32gather_ps(worldF32, _mm256_add_epi32(base, _mm256_set1_epi32(13)), 4);
+
+            wa = _mm256_add_ps(_mm256_mul_ps(pa, la), _mm256_mul_ps(pc, lb));
+            wb = _mm256_add_ps(_mm256_mul_ps(pb, la), _mm256_mul_ps(pd, lb));
+            wc = _mm256_add_ps(_mm256_mul_ps(pa, lc), _mm256_mul_ps(pc, ld));
+            wd = _mm256_add_ps(_mm256_mul_ps(pb, lc), _mm256_mul_ps(pd, ld));
+            wz = _mm256_mul_ps(pz, lz);
+            wtx = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pa, px), _mm256_mul_ps(pc, py)), ptx);
+            wty = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(pb, px), _mm256_mul_ps(pd, py)), pty);
+        }
+
+        // scattering to sparse indices has no 256-bit equivalent, store as two halves
+        store_lanes_sse2(_mm256_castps256_ps128(wa), _mm256_castps256_ps128(wb), _mm256_castps256_ps128(wc),
+                         _mm256_castps256_ps128(wd), _mm256_castps256_ps128(wz), _mm256_castps256_ps128(wtx), _mm256_castps256_ps128(wty),
+                         lanes.childSI + i, worldMat4);
+        store_lanes_sse2(_mm256_extractf128_ps(wa, 1), _mm256_extractf128_ps(wb, 1), _mm256_extractf128_ps(wc, 1),
+                         _mm256_extractf128_ps(wd, 1), _mm256_extractf128_ps(wz, 1), _mm256_extractf128_ps(wtx, 1), _mm256_extractf128_ps(wty, 1),
+                         lanes.childSI + i + 4, worldMat4);
+    }
+
+    return i;
+}
+
+#endif // LD_ARCH_X64
+
+void transform_2d_lanes_to_mat4(SIMDLevel level, const Transform2DLanes& lanes, size_t count, bool isRoot, Mat4* worldMat4)
+{
+    size_t i = 0;
+
+#if defined(LD_ARCH_X64)
+    if (level >= SIMD_LEVEL_AVX2)
+        i = lanes_avx2(lanes, i, count, isRoot, worldMat4);
+
+    if (level >= SIMD_LEVEL_SSE2)
+        i = lanes_sse2(lanes, i, count, isRoot, worldMat4);
+#endif
+
+    // remaining lanes that do not fill a vector
+    lanes_scalar(lanes, i, count, isRoot, worldMat4);
+}
+
+} // namespace LD
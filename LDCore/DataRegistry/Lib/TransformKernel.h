@@ -0,0 +1,33 @@
+#pragma once
+
+#include <Ludens/Header/Math/Mat4.h>
+#include <Ludens/Header/SIMD.h>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace LD {
+
+/// @brief Structure of arrays staging of Transform2D entries within a depth level.
+///        Each local transform is decomposed into lanes so kernels load 4 to 8 entries at once.
+struct Transform2DLanes
+{
+    float* posX;
+    float* posY;
+    float* scaleX;
+    float* scaleY;
+    float* rotCos;
+    float* rotSin;
+    uint32_t* childSI;  /// sparse index of the world matrix to write
+    uint32_t* parentSI; /// sparse index of the parent world matrix to read, unused for depth level 0
+};
+
+/// @brief Compute world matrices of staged lanes [0, count). Results are identical
+///        to Transform2D::as_mat4() multiplied with the parent world matrix, given that
+///        parent world matrices are 2D affine transforms produced by the same registry.
+/// @param level Kernel instruction set, caller ensures the CPU supports it.
+/// @param isRoot Lanes are staged from depth level 0 and have no parent.
+/// @param worldMat4 World matrices indexed by sparse index.
+void transform_2d_lanes_to_mat4(SIMDLevel level, const Transform2DLanes& lanes, size_t count, bool isRoot, Mat4* worldMat4);
+
+} // namespace LD
@@ -1,16 +1,24 @@
 #include <Ludens/DSA/Queue.h>
 #include <Ludens/DataRegistry/TransformRegistry.h>
 #include <Ludens/Header/Math/Transform.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Profiler/Profiler.h>
 
+#include <algorithm>
+#include <atomic>
 #include <utility>
 
+#include "TransformKernel.h"
+
 #define TRANSFORM_REGISTRY_MEMORY_USAGE MEMORY_USAGE_MISC
 #define TRANSFORM_REGISTRY_PAGE_SIZE 1024
+#define TRANSFORM_REGISTRY_PARALLEL_THRESHOLD 8192
+#define TRANSFORM_REGISTRY_PARALLEL_GRAIN 2048
 
 namespace LD {
 
 Transform2DRegistry::Transform2DRegistry()
+    : mParallelThreshold(TRANSFORM_REGISTRY_PARALLEL_THRESHOLD), mSIMDLevel(get_cpu_simd_level())
 {
     PoolAllocatorInfo paI{};
     paI.blockSize = sizeof(Transform2D);
@@ -32,39 +40,59 @@ void Transform2DRegistry::invalidate_transforms()
 {
     LD_PROFILE_SCOPE;
 
-    if (mDepth.empty())
+    mRecomputedCount = 0;
+
+    // static frame, every world matrix is still valid
+    if (mDirtyCount == 0)
         return;
 
-    Depth& rootDepth = *mDepth[0];
-    size_t maxChildLI = rootDepth.local.size();
+    JobSystem js = JobSystem::get();
+    std::atomic<size_t> recomputedCount = 0;
 
-    for (size_t childLI = 0; childLI < maxChildLI; childLI++)
+    for (size_t d = 0; d < mDepth.size(); d++)
     {
-        // SPACE: For a wide depth level we can split the range into jobs for the JobSystem,
+        size_t width = mDepth[d]->local.size();
 
-        uint32_t childSI = rootDepth.local[childLI].id.index();
+        if (mSIMDLevel > SIMD_LEVEL_SCALAR)
+        {
+            mDepth[d]->laneF32.resize(6 * width);
+            mDepth[d]->laneU32.resize(2 * width);
+        }
+
+        if (!js || width < mParallelThreshold)
+        {
+            mRecomputedCount += invalidate_depth_range(d, 0, width);
+            continue;
+        }
 
-        mWorldMat4[childSI] = rootDepth.local[childLI].transform->as_mat4();
+        // parallel_for returns once the whole level is done,
+        // which is the barrier before the next depth level.
+        js.parallel_for(0, width, TRANSFORM_REGISTRY_PARALLEL_GRAIN, [this, d, &recomputedCount](size_t begin, size_t end) {
+            recomputedCount.fetch_add(invalidate_depth_range(d, begin, end), std::memory_order_relaxed);
+        });
     }
 
-    for (size_t d = 1; d < mDepth.size(); d++)
-    {
-        Depth& depthPrev = *mDepth[d - 1];
-        Depth& depth = *mDepth[d];
-        maxChildLI = depth.local.size();
+    mRecomputedCount += recomputedCount.load(std::memory_order_relaxed);
+    mDirtyCount = 0;
 
-        // SPACE: For a wide depth level we can split the range into jobs for the JobSystem,
-        //        there is overhead for notifying std::condition_variable, so we probably
-        //        don't want to split if a depth level takes only a few microseconds.
+    // entries marked during this invalidation are no longer dirty,
+    // wrapping around only causes spurious recomputation.
+    if (++mEpoch == 0)
+        mEpoch = 1;
+}
 
-        for (size_t childLI = 0; childLI < maxChildLI; childLI++)
-        {
-            uint64_t parentSI = depth.local[childLI].parentID.index();
+void Transform2DRegistry::mark_dirty(ID id)
+{
+    if (!has_transform(id))
+        return;
 
-            Mat4 localMat4 = depth.local[childLI].transform->as_mat4();
-            mWorldMat4[depth.local[childLI].id.index()] = mWorldMat4[parentSI] * localMat4;
-        }
-    }
+    mDirtyEpoch[id.index()] = mEpoch;
+    mDirtyCount++;
+}
+
+void Transform2DRegistry::set_simd_level(SIMDLevel level)
+{
+    mSIMDLevel = std::min(level, get_cpu_simd_level());
 }
 
 bool Transform2DRegistry::has_transform(ID id)
@@ -80,6 +108,8 @@ void Transform2DRegistry::set_transform(ID id, const Transform2D& transform)
 
     Depth& depth = *mDepth[sparse.depthLevel];
     *depth.local[sparse.localIndex].transform = transform;
+
+    mark_dirty(id);
 }
 
 bool Transform2DRegistry::get_world_transform(ID id, Transform2D& outWorldTransform)
@@ -110,6 +140,7 @@ Transform2D* Transform2DRegistry::create(ID childID, ID parentID)
     {
         mSparse.resize(maxSI + 1);
         mWorldMat4.resize(maxSI + 1);
+        mDirtyEpoch.resize(maxSI + 1, 0);
     }
 
     if (parentID)
@@ -134,6 +165,8 @@ Transform2D* Transform2DRegistry::create(ID childID, ID parentID)
 
     // stable address until destroyed
     *childTransform = {Vec2(0.0f), Vec2(1.0f), 0.0f};
+    mark_dirty(childID);
+
     return childTransform;
 }
 
@@ -217,9 +250,111 @@ void Transform2DRegistry::reparent_subtree(ID childID, ID parentID, IDHierarchyC
 
         childS.depthLevel = childDepthLevel;
         childS.localIndex = childNewLI;
+
+        mark_dirty(childID);
     }
 }
 
+size_t Transform2DRegistry::invalidate_depth_range(size_t depthLevel, size_t begin, size_t end)
+{
+    if (mSIMDLevel > SIMD_LEVEL_SCALAR)
+        return invalidate_depth_range_lanes(depthLevel, begin, end);
+
+    const Entry* local = mDepth[depthLevel]->local.data();
+    uint32_t* dirtyEpoch = mDirtyEpoch.data();
+    size_t recomputedCount = 0;
+
+    if (depthLevel == 0)
+    {
+        for (size_t childLI = begin; childLI < end; childLI++)
+        {
+            uint32_t childSI = local[childLI].id.index();
+            if (dirtyEpoch[childSI] != mEpoch)
+                continue;
+
+            mWorldMat4[childSI] = local[childLI].transform->as_mat4();
+            recomputedCount++;
+        }
+
+        return recomputedCount;
+    }
+
+    for (size_t childLI = begin; childLI < end; childLI++)
+    {
+        uint32_t childSI = local[childLI].id.index();
+        uint64_t parentSI = local[childLI].parentID.index();
+
+        // parent recomputed in a previous depth level dirties the child,
+        // which in turn dirties the grandchildren in the next level.
+        if (dirtyEpoch[childSI] != mEpoch)
+        {
+            if (dirtyEpoch[parentSI] != mEpoch)
+                continue;
+
+            dirtyEpoch[childSI] = mEpoch;
+        }
+
+        Mat4 localMat4 = local[childLI].transform->as_mat4();
+        mWorldMat4[childSI] = mWorldMat4[parentSI] * localMat4;
+        recomputedCount++;
+    }
+
+    return recomputedCount;
+}
+
+size_t Transform2DRegistry::invalidate_depth_range_lanes(size_t depthLevel, size_t begin, size_t end)
+{
+    Depth& depth = *mDepth[depthLevel];
+    const Entry* local = depth.local.data();
+    uint32_t* dirtyEpoch = mDirtyEpoch.data();
+    size_t width = depth.local.size();
+
+    // each range stages into its own slice of the lanes,
+    // only dirty entries are staged so every lane does useful work.
+    Transform2DLanes lanes;
+    lanes.posX = depth.laneF32.data() + begin;
+    lanes.posY = lanes.posX + width;
+    lanes.scaleX = lanes.posY + width;
+    lanes.scaleY = lanes.scaleX + width;
+    lanes.rotCos = lanes.scaleY + width;
+    lanes.rotSin = lanes.rotCos + width;
+    lanes.childSI = depth.laneU32.data() + begin;
+    lanes.parentSI = lanes.childSI + width;
+
+    size_t count = 0;
+
+    for (size_t childLI = begin; childLI < end; childLI++)
+    {
+        uint32_t childSI = local[childLI].id.index();
+        uint32_t parentSI = local[childLI].parentID.index();
+
+        if (dirtyEpoch[childSI] != mEpoch)
+        {
+            if (depthLevel == 0 || dirtyEpoch[parentSI] != mEpoch)
+                continue;
+
+            dirtyEpoch[childSI] = mEpoch;
+        }
+
+        const Transform2D& transform = *local[childLI].transform;
+        float radians = (float)LD_TO_RADIANS(transform.rotation);
+
+        lanes.posX[count] = transform.position.x;
+        lanes.posY[count] = transform.position.y;
+        lanes.scaleX[count] = transform.scale.x;
+        lanes.scaleY[count] = transform.scale.y;
+        lanes.rotCos[count] = LD_COS(radians);
+        lanes.rotSin[count] = LD_SIN(radians);
+        lanes.childSI[count] = childSI;
+        lanes.parentSI[count] = parentSI;
+        count++;
+    }
+
+    transform_2d_lanes_to_mat4(mSIMDLevel, lanes, count, depthLevel == 0, mWorldMat4.data());
+
+    return count;
+}
+
 void Transform2DRegistry::reserve_depth(int depth)
 {
     if (depth < mDepth.size())
@@ -1,9 +1,12 @@
 #include <Extra/doctest/doctest.h>
 #include <Ludens/DataRegistry/TransformRegistry.h>
 #include <Ludens/Header/Math/Transform.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Memory/Memory.h>
 #include <Ludens/System/Timer.h>
 
+#include <algorithm>
+
 using namespace LD;
 
 const uint64_t N = 1000;
@@ -193,4 +196,191 @@ TEST_CASE("Transform2DRegistry reparent")
 
     delete reg;
     CHECK(get_memory_leaks(nullptr) == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("Transform2DRegistry dirty")
+{
+    Transform2DRegistry* reg = new Transform2DRegistry;
+
+    // single chain
+    Transform2D* chain[N + 1];
+    chain[1] = reg->create(1, 0);
+    for (uint64_t i = 2; i <= N; i++)
+        chain[i] = reg->create(i, i - 1);
+
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == N);
+
+    // static frame
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == 0);
+
+    // only the dirty subtree is recomputed
+    reg->set_transform(N / 2 + 1, translate(Vec2(1.0f, 2.0f)));
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == N / 2);
+
+    Vec4 v = reg->get_world_mat4(N / 2) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    CHECK(v == Vec4(0.0f, 0.0f, 0.0f, 1.0f));
+    v = reg->get_world_mat4(N) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    CHECK(v == Vec4(1.0f, 2.0f, 0.0f, 1.0f));
+
+    // writes through the raw address are picked up once marked
+    *chain[N] = translate(Vec2(3.0f, 3.0f));
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == 0);
+    reg->mark_dirty(N);
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == 1);
+    v = reg->get_world_mat4(N) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    CHECK(v == Vec4(4.0f, 5.0f, 0.0f, 1.0f));
+
+    // reparented subtree is recomputed under the new parent
+    reg->set_transform(1, translate(Vec2(10.0f, 0.0f)));
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == N);
+    reg->reparent_subtree(N / 2 + 1, 0, &chain_hierarchy, nullptr);
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == N / 2);
+    v = reg->get_world_mat4(N) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    CHECK(v == Vec4(4.0f, 5.0f, 0.0f, 1.0f));
+
+    delete reg;
+    CHECK(get_memory_leaks(nullptr) == 0);
+}
+
+static Transform2D varied(uint64_t id)
+{
+    Transform2D tr{};
+    tr.position = Vec2((float)(id % 17) - 8.0f, (float)(id % 13) * 0.5f);
+    tr.rotation = (float)(id * 37 % 360);
+    tr.scale = Vec2(0.5f + (float)(id % 5) * 0.25f, 1.5f - (float)(id % 3) * 0.25f);
+    return tr;
+}
+
+// SIMD kernels evaluate the same float expressions as the scalar path,
+// results are expected to be identical, not just within epsilon.
+static bool is_mat4_equal(const Mat4& lhs, const Mat4& rhs)
+{
+    for (int i = 0; i < 16; i++)
+    {
+        if (lhs.element(i) != rhs.element(i))
+            return false;
+    }
+
+    return true;
+}
+
+TEST_CASE("Transform2DRegistry SIMD")
+{
+    const SIMDLevel levels[] = {SIMD_LEVEL_SCALAR, SIMD_LEVEL_SSE2, SIMD_LEVEL_AVX2};
+    Transform2DRegistry* regs[3];
+
+    // 3 depth levels with widths that leave partial vectors,
+    // child i at depth 2 is parented to i / 3 at depth 1.
+    const uint64_t rootCount = 7;
+    const uint64_t midCount = 61;
+    const uint64_t leafCount = 3 * midCount + 2;
+
+    for (int l = 0; l < 3; l++)
+    {
+        Transform2DRegistry* reg = regs[l] = new Transform2DRegistry;
+        reg->set_simd_level(levels[l]);
+        CHECK(reg->get_simd_level() <= levels[l]);
+
+        uint64_t id = 1;
+        for (uint64_t i = 0; i < rootCount; i++, id++)
+        {
+            reg->create(id, 0);
+            reg->set_transform(id, varied(id));
+        }
+        for (uint64_t i = 0; i < midCount; i++, id++)
+        {
+            reg->create(id, 1 + i % rootCount);
+            reg->set_transform(id, varied(id));
+        }
+        for (uint64_t i = 0; i < leafCount; i++, id++)
+        {
+            reg->create(id, 1 + rootCount + std::min(i / 3, midCount - 1));
+            reg->set_transform(id, varied(id));
+        }
+
+        reg->invalidate_transforms();
+        CHECK(reg->get_recomputed_count() == rootCount + midCount + leafCount);
+    }
+
+    const uint64_t count = rootCount + midCount + leafCount;
+
+    for (uint64_t id = 1; id <= count; id++)
+    {
+        CHECK(is_mat4_equal(regs[0]->get_world_mat4(id), regs[1]->get_world_mat4(id)));
+        CHECK(is_mat4_equal(regs[0]->get_world_mat4(id), regs[2]->get_world_mat4(id)));
+    }
+
+    // partially dirty, staged lanes are compacted
+    for (int l = 0; l < 3; l++)
+    {
+        for (uint64_t id = 2; id <= count; id += 5)
+            regs[l]->set_transform(id, varied(id * 3));
+
+        regs[l]->invalidate_transforms();
+        CHECK(regs[l]->get_recomputed_count() == regs[0]->get_recomputed_count());
+    }
+
+    for (uint64_t id = 1; id <= count; id++)
+    {
+        CHECK(is_mat4_equal(regs[0]->get_world_mat4(id), regs[1]->get_world_mat4(id)));
+        CHECK(is_mat4_equal(regs[0]->get_world_mat4(id), regs[2]->get_world_mat4(id)));
+    }
+
+    for (int l = 0; l < 3; l++)
+        delete regs[l];
+
+    CHECK(get_memory_leaks(nullptr) == 0);
+}
+
+TEST_CASE("Transform2DRegistry parallel")
+{
+    JobSystemInfo jsI{};
+    jsI.immediateQueueCapacity = 64;
+    jsI.standardQueueCapacity = 64;
+    JobSystem::init(jsI);
+
+    Transform2DRegistry* reg = new Transform2DRegistry;
+    reg->set_parallel_threshold(1);
+
+    // N/2 roots, each with a single child
+    for (uint64_t i = 1; i <= N / 2; i++)
+    {
+        reg->create(i, 0);
+        reg->set_transform(i, translate(Vec2(i * 1.0f, 1.0f)));
+        reg->create(i + N / 2, i);
+        reg->set_transform(i + N / 2, translate(Vec2(1.0f, 2.0f)));
+    }
+
+    reg->invalidate_transforms();
+
+    for (uint64_t i = 1; i <= N / 2; i++)
+    {
+        Vec4 v = reg->get_world_mat4(i + N / 2) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        CHECK(v == Vec4(i + 1.0f, 3.0f, 0.0f, 1.0f));
+    }
+
+    // only the dirty half of the roots and their children are recomputed
+    for (uint64_t i = 1; i <= N / 2; i += 2)
+        reg->set_transform(i, translate(Vec2(0.0f, 1.0f)));
+
+    reg->invalidate_transforms();
+    CHECK(reg->get_recomputed_count() == N / 2);
+
+    for (uint64_t i = 1; i <= N / 2; i++)
+    {
+        float x = (i % 2) ? 1.0f : i + 1.0f;
+        Vec4 v = reg->get_world_mat4(i + N / 2) * Vec4(0.0f, 0.0f, 0.0f, 1.0f);
+        CHECK(v == Vec4(x, 3.0f, 0.0f, 1.0f));
+    }
+
+    delete reg;
+    JobSystem::shutdown();
+    CHECK(get_memory_leaks(nullptr) == 0);
+}
@@ -0,0 +1,135 @@
+#include <Ludens/JobSystem/JobSystem.h>
+#include <Ludens/System/Timer.h>
+
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+using namespace LD;
+
+constexpr size_t N = 100'000;
+constexpr size_t SPAWN_ROOTS = 64;
+constexpr size_t SPAWN_CHILDREN = 1024;
+constexpr int WORK_ITERATIONS = 256;
+
+static std::atomic<size_t> sSink;
+
+struct TinyJob
+{
+    JobHeader header{};
+    uint32_t seed = 0;
+
+    TinyJob()
+    {
+        header.onExecute = &TinyJob::main;
+        header.user = this;
+    }
+
+    static void main(void* user)
+    {
+        TinyJob* self = (TinyJob*)user;
+        uint32_t x = self->seed + 1;
+
+        for (int i = 0; i < WORK_ITERATIONS; i++)
+            x = x * 1664525u + 1013904223u;
+
+        sSink.fetch_add(x & 1, std::memory_order_relaxed);
+    }
+};
+
+/// root job that spawns child jobs from a worker thread
+struct SpawnJob
+{
+    JobHeader header{};
+    TinyJob* children = nullptr;
+
+    SpawnJob()
+    {
+        header.onExecute = &SpawnJob::main;
+        header.user = this;
+    }
+
+    static void main(void* user)
+    {
+        SpawnJob* self = (SpawnJob*)user;
+        JobSystem js = JobSystem::get();
+
+        for (size_t i = 0; i < SPAWN_CHILDREN; i++)
+            js.submit(&self->children[i].header, JOB_DISPATCH_STANDARD);
+    }
+};
+
+static size_t bench_main_submit(bool workStealing)
+{
+    JobSystemInfo jsI{};
+    jsI.immediateQueueCapacity = 1024;
+    jsI.standardQueueCapacity = 1024;
+    jsI.enableWorkStealing = workStealing;
+    JobSystem::init(jsI);
+
+    JobSystem js = JobSystem::get();
+    std::vector<TinyJob> jobs(N);
+    size_t dur;
+
+    {
+        ScopeTimer timer(&dur);
+
+        for (size_t i = 0; i < N; i++)
+        {
+            jobs[i].seed = (uint32_t)i;
+            js.submit(&jobs[i].header, JOB_DISPATCH_STANDARD);
+        }
+
+        js.wait_all();
+    }
+
+    JobSystem::shutdown();
+
+    return dur;
+}
+
+static size_t bench_worker_spawn(bool workStealing)
+{
+    JobSystemInfo jsI{};
+    jsI.immediateQueueCapacity = 1024;
+    jsI.standardQueueCapacity = 1024;
+    jsI.workerDequeCapacity = SPAWN_CHILDREN * 2;
+    jsI.enableWorkStealing = workStealing;
+    JobSystem::init(jsI);
+
+    JobSystem js = JobSystem::get();
+    std::vector<TinyJob> children(SPAWN_ROOTS * SPAWN_CHILDREN);
+    std::vector<SpawnJob> roots(SPAWN_ROOTS);
+    size_t dur;
+
+    {
+        ScopeTimer timer(&dur);
+
+        for (size_t i = 0; i < SPAWN_ROOTS; i++)
+        {
+            roots[i].children = children.data() + i * SPAWN_CHILDREN;
+            js.submit(&roots[i].header, JOB_DISPATCH_STANDARD);
+        }
+
+        js.wait_all();
+    }
+
+    JobSystem::shutdown();
+
+    return dur;
+}
+
+int main(int argc, char** argv)
+{
+    size_t dur = bench_main_submit(false);
+    printf("main thread submit %zu jobs, shared queues  %.3f ms\n", N, dur / 1000.0f);
+
+    dur = bench_main_submit(true);
+    printf("main thread submit %zu jobs, work stealing  %.3f ms\n", N, dur / 1000.0f);
+
+    dur = bench_worker_spawn(false);
+    printf("worker spawn %zu jobs, shared queues        %.3f ms\n", SPAWN_ROOTS * SPAWN_CHILDREN, dur / 1000.0f);
+
+    dur = bench_worker_spawn(true);
+    printf("worker spawn %zu jobs, work stealing        %.3f ms\n", SPAWN_ROOTS * SPAWN_CHILDREN, dur / 1000.0f);
+}
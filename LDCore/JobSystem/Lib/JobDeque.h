@@ -0,0 +1,182 @@
+#pragma once
+
+#include <Ludens/JobSystem/JobSystem.h>
+#include <Ludens/Memory/Memory.h>
+
+#include <atomic>
+#include <cstring>
+
+namespace LD {
+
+/// @brief Fixed capacity Chase-Lev work stealing deque storing JobHeader by value.
+///        Only the owning worker thread may push() and pop() at the bottom,
+///        any thread may steal() from the top.
+class JobDeque
+{
+public:
+    /// @brief create deque, capacity is rounded up to a power of two
+    JobDeque(size_t capacity)
+        : mTop(0), mBottom(0)
+    {
+        size_t cap = 2;
+        while (cap < capacity)
+            cap <<= 1;
+
+        mMask = cap - 1;
+        mSlots = (Slot*)heap_malloc(sizeof(Slot) * cap, MEMORY_USAGE_JOB_SYSTEM);
+
+        for (size_t i = 0; i < cap; i++)
+            new (mSlots + i) Slot();
+    }
+
+    ~JobDeque()
+    {
+        heap_free(mSlots);
+    }
+
+    JobDeque(const JobDeque&) = delete;
+    JobDeque& operator=(const JobDeque&) = delete;
+
+    /// @brief push a job to the bottom, owner thread only
+    /// @return false if the deque is full
+    inline bool push(const JobHeader& job)
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed);
+        int64_t t = mTop.load(std::memory_order_acquire);
+
+        if (b - t > (int64_t)mMask)
+            return false;
+
+        mSlots[b & mMask].store(job);
+        std::atomic_thread_fence(std::memory_order_release);
+        mBottom.store(b + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    /// @brief pop the most recently pushed job, owner thread only
+    inline bool pop(JobHeader& job)
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed) - 1;
+        mBottom.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t t = mTop.load(std::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // empty deque
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return false;
+        }
+
+        mSlots[b & mMask].load(job);
+
+        if (t == b)
+        {
+            // last job, race against thieves
+            bool won = mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+            mBottom.store(b + 1, std::memory_order_relaxed);
+            return won;
+        }
+
+        return true;
+    }
+
+    /// @brief steal the least recently pushed job, any thread
+    /// @return false if the deque is empty or another thread won the race
+    inline bool steal(JobHeader& job)
+    {
+        int64_t t = mTop.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        int64_t b = mBottom.load(std::memory_order_acquire);
+
+        if (t >= b)
+            return false;
+
+        // the slot may be overwritten after another thief wins the race,
+        // in which case the CAS fails and the copy is discarded.
+        JobHeader stolen;
+        mSlots[t & mMask].load(stolen);
+
+        if (!mTop.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            return false;
+
+        job = stolen;
+        return true;
+    }
+
+    /// @brief approximate number of jobs in the deque
+    inline size_t size() const
+    {
+        int64_t b = mBottom.load(std::memory_order_relaxed);
+        int64_t t = mTop.load(std::memory_order_relaxed);
+
+        return b > t ? (size_t)(b - t) : 0;
+    }
+
+    /// @brief Move jobs of the specified type to the bottom so the owner pops them first,
+    ///        owner thread only. Jobs stolen concurrently are simply not reordered.
+    void prioritize(uint32_t prioType)
+    {
+        size_t count = size();
+        if (count == 0)
+            return;
+
+        JobHeader* jobs = (JobHeader*)heap_malloc(sizeof(JobHeader) * count, MEMORY_USAGE_JOB_SYSTEM);
+        size_t popCount = 0;
+
+        // jobs[0] is the most recently pushed
+        while (popCount < count && pop(jobs[popCount]))
+            popCount++;
+
+        for (size_t i = popCount; i > 0; i--)
+        {
+            if (jobs[i - 1].type != prioType)
+                push(jobs[i - 1]);
+        }
+
+        for (size_t i = popCount; i > 0; i--)
+        {
+            if (jobs[i - 1].type == prioType)
+                push(jobs[i - 1]);
+        }
+
+        heap_free(jobs);
+    }
+
+private:
+    /// JobHeader stored as relaxed atomic words, thieves may read
+    /// a slot concurrently with the owner overwriting it.
+    struct Slot
+    {
+        static constexpr size_t word_count = (sizeof(JobHeader) + sizeof(uint64_t) - 1) / sizeof(uint64_t);
+
+        std::atomic<uint64_t> words[word_count];
+
+        inline void store(const JobHeader& job)
+        {
+            uint64_t tmp[word_count]{};
+            memcpy(tmp, &job, sizeof(JobHeader));
+
+            for (size_t i = 0; i < word_count; i++)
+                words[i].store(tmp[i], std::memory_order_relaxed);
+        }
+
+        inline void load(JobHeader& job) const
+        {
+            uint64_t tmp[word_count];
+
+            for (size_t i = 0; i < word_count; i++)
+                tmp[i] = words[i].load(std::memory_order_relaxed);
+
+            memcpy(&job, tmp, sizeof(JobHeader));
+        }
+    };
+
+    alignas(64) std::atomic<int64_t> mTop;
+    alignas(64) std::atomic<int64_t> mBottom;
+    Slot* mSlots;
+    size_t mMask;
+};
+
+} // namespace LD
@@ -1,13 +1,19 @@
 #include <Ludens/DSA/Vector.h>
+#include <Ludens/Header/Assert.h>
 #include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Memory/Memory.h>
 #include <Ludens/Profiler/Profiler.h>
 
+#include "JobDeque.h"
+
+#include <algorithm>
 #include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <thread>
 
+#define JOB_PARALLEL_FOR_CHUNKS_PER_THREAD 4
+
 namespace LD {
 
 /// thread safe ring buffer to store JobHeader info
@@ -103,10 +109,39 @@ private:
     JobHeader* mJobs;
 };
 
+/// contiguous chunk of a parallel_for range
+struct JobRangeChunk
+{
+    JobHeader header;
+    JobRangeFn fn;
+    void* user;
+    size_t begin;
+    size_t end;
+
+    static void execute(void* chunk)
+    {
+        JobRangeChunk* self = (JobRangeChunk*)chunk;
+        self->fn(self->begin, self->end, self->user);
+    }
+};
+
+/// continuation registered on a JobCounter, intrusive stack node
+struct JobContinuation
+{
+    JobHeader job;
+    JobDispatchType type;
+    JobContinuation* next;
+};
+
 struct WorkerThread
 {
     std::thread handle;
     std::atomic_bool isWorking;
+    JobDeque* immDeque;                   // work stealing mode only
+    JobDeque* stdDeque;                   // work stealing mode only
+    std::atomic_bool hasPrioritize;       // deferred prioritize() request for the owned deques
+    std::atomic<uint32_t> prioritizeType; // job type of the deferred prioritize() request
+    uint32_t rngState;                    // xorshift state for victim selection
 };
 
 /// @brief thread-based job system implementation
@@ -119,16 +154,47 @@ struct JobSystemObj
     std::vector<WorkerThread*> workerThreads;
     std::atomic<bool> isRunning;
     std::atomic<size_t> jobCounter;
+    std::atomic<size_t> queuedCounter; // work stealing mode, jobs in queues or deques not yet picked up
+    std::atomic<int> sleepingCounter;  // work stealing mode, workers waiting on wakeCV
     JobQueue immQueue;
     JobQueue stdQueue;
+    bool isWorkStealing;
 
     JobSystemObj(const JobSystemInfo& info);
     ~JobSystemObj();
 };
 
 static JobSystemObj* sObj;
+static thread_local WorkerThread* sWorker; // null for non-worker threads
 
 static void worker_thread_main(void* thread);
+static void submit_job(const JobHeader* job, JobDispatchType type);
+
+/// submit all continuations currently registered on the counter
+static void release_continuations(JobCounter* counter)
+{
+    JobContinuation* cont = counter->continuations.exchange(nullptr);
+
+    while (cont)
+    {
+        JobContinuation* next = cont->next;
+        submit_job(&cont->job, cont->type);
+        heap_delete<JobContinuation>(cont);
+        cont = next;
+    }
+}
+
+/// decrement the counter of a completed job, the signaling count keeps
+/// waiters from releasing the counter while continuations are submitted.
+static void signal_counter(JobCounter* counter)
+{
+    counter->signaling.fetch_add(1);
+
+    if (counter->value.fetch_sub(1) == 1)
+        release_continuations(counter);
+
+    counter->signaling.fetch_sub(1, std::memory_order_release);
+}
 
 static void execute_job(const JobHeader& job)
 {
@@ -137,6 +203,9 @@ static void execute_job(const JobHeader& job)
     if (job.onComplete)
         job.onComplete(job.user);
 
+    if (job.counter)
+        signal_counter(job.counter);
+
     if (sObj->jobCounter.fetch_sub(1, std::memory_order_acq_rel) == 1)
     {
         std::unique_lock<std::mutex> lock(sObj->waitAllMutex);
@@ -145,37 +214,216 @@ static void execute_job(const JobHeader& job)
 }
 
 JobSystemObj::JobSystemObj(const JobSystemInfo& info)
-    : immQueue(info.immediateQueueCapacity), stdQueue(info.standardQueueCapacity)
+    : immQueue(info.immediateQueueCapacity), stdQueue(info.standardQueueCapacity), isWorkStealing(info.enableWorkStealing)
 {
-    int workerCount = (int)std::thread::hardware_concurrency() - 1;
+    int workerCount = info.workerThreadCount ? (int)info.workerThreadCount : (int)std::thread::hardware_concurrency() - 1;
     workerThreads.resize(workerCount);
 
+    size_t dequeCapacity = info.workerDequeCapacity ? info.workerDequeCapacity : info.standardQueueCapacity;
+
     for (int i = 0; i < workerCount; i++)
     {
-        workerThreads[i] = heap_new<WorkerThread>(MEMORY_USAGE_JOB_SYSTEM);
-        workerThreads[i]->isWorking = false;
+        WorkerThread* thread = heap_new<WorkerThread>(MEMORY_USAGE_JOB_SYSTEM);
+        thread->isWorking = false;
+        thread->immDeque = nullptr;
+        thread->stdDeque = nullptr;
+        thread->hasPrioritize = false;
+        thread->rngState = 0x9E3779B9u * (uint32_t)(i + 1);
+
+        if (isWorkStealing)
+        {
+            thread->immDeque = heap_new<JobDeque>(MEMORY_USAGE_JOB_SYSTEM, dequeCapacity);
+            thread->stdDeque = heap_new<JobDeque>(MEMORY_USAGE_JOB_SYSTEM, dequeCapacity);
+        }
+
+        workerThreads[i] = thread;
     }
 
+    queuedCounter = 0;
+    sleepingCounter = 0;
     isRunning = true;
 }
 
 JobSystemObj::~JobSystemObj()
 {
-    isRunning = false;
+    {
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        isRunning = false;
+    }
 
     wakeCV.notify_all();
 
+    // workers may still steal from each other until all of them have exited
     for (WorkerThread* thread : workerThreads)
-    {
         thread->handle.join();
+
+    for (WorkerThread* thread : workerThreads)
+    {
+        if (thread->immDeque)
+            heap_delete<JobDeque>(thread->immDeque);
+
+        if (thread->stdDeque)
+            heap_delete<JobDeque>(thread->stdDeque);
+
         heap_delete<WorkerThread>(thread);
     }
 }
 
+static inline uint32_t next_random(WorkerThread* thread)
+{
+    uint32_t x = thread->rngState;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    thread->rngState = x;
+
+    return x;
+}
+
+/// wake one sleeping worker, the mutex is only touched if someone is asleep
+static void wake_one_worker()
+{
+    if (sObj->sleepingCounter.load() == 0)
+        return;
+
+    {
+        std::unique_lock<std::mutex> lock(sObj->wakeMutex);
+    }
+
+    sObj->wakeCV.notify_one();
+}
+
+/// try to steal from other workers starting at a random victim
+static bool steal_job(WorkerThread* thief, JobDispatchType type, JobHeader& job)
+{
+    size_t workerCount = sObj->workerThreads.size();
+    if (workerCount == 0)
+        return false;
+
+    size_t start = thief ? next_random(thief) % workerCount : 0;
+
+    for (size_t i = 0; i < workerCount; i++)
+    {
+        WorkerThread* victim = sObj->workerThreads[(start + i) % workerCount];
+
+        if (victim == thief)
+            continue;
+
+        JobDeque* deque = (type == JOB_DISPATCH_IMMEDIATE) ? victim->immDeque : victim->stdDeque;
+
+        if (deque->steal(job))
+            return true;
+    }
+
+    return false;
+}
+
+/// Job search order in work stealing mode. Immediate jobs anywhere take priority
+/// over standard jobs, within a priority the local deque is checked first, then
+/// the shared queue for jobs from the main thread, and finally other workers.
+static bool find_job_work_stealing(WorkerThread* thread, JobHeader& job)
+{
+    if (thread->immDeque->pop(job))
+        return true;
+
+    if (!sObj->immQueue.empty() && sObj->immQueue.dequeue(job))
+        return true;
+
+    if (steal_job(thread, JOB_DISPATCH_IMMEDIATE, job))
+        return true;
+
+    if (thread->stdDeque->pop(job))
+        return true;
+
+    if (!sObj->stdQueue.empty() && sObj->stdQueue.dequeue(job))
+        return true;
+
+    return steal_job(thread, JOB_DISPATCH_STANDARD, job);
+}
+
+/// Execute a single pending job on the calling thread, used while waiting on a counter.
+static bool try_execute_job()
+{
+    JobHeader job;
+
+    if (!sObj->isWorkStealing)
+    {
+        if (!sObj->immQueue.dequeue(job) && !sObj->stdQueue.dequeue(job))
+            return false;
+
+        execute_job(job);
+        return true;
+    }
+
+    bool foundJob;
+
+    if (sWorker)
+    {
+        foundJob = find_job_work_stealing(sWorker, job);
+    }
+    else
+    {
+        foundJob = (!sObj->immQueue.empty() && sObj->immQueue.dequeue(job)) ||
+                   steal_job(nullptr, JOB_DISPATCH_IMMEDIATE, job) ||
+                   (!sObj->stdQueue.empty() && sObj->stdQueue.dequeue(job)) ||
+                   steal_job(nullptr, JOB_DISPATCH_STANDARD, job);
+    }
+
+    if (!foundJob)
+        return false;
+
+    sObj->queuedCounter.fetch_sub(1);
+    execute_job(job);
+    return true;
+}
+
+static void worker_thread_main_work_stealing(WorkerThread* thread)
+{
+    sWorker = thread;
+
+    while (sObj->isRunning)
+    {
+        if (thread->hasPrioritize.exchange(false, std::memory_order_acquire))
+        {
+            uint32_t prioType = thread->prioritizeType.load(std::memory_order_relaxed);
+            thread->immDeque->prioritize(prioType);
+            thread->stdDeque->prioritize(prioType);
+        }
+
+        JobHeader job;
+
+        if (find_job_work_stealing(thread, job))
+        {
+            sObj->queuedCounter.fetch_sub(1);
+            thread->isWorking = true;
+            execute_job(job);
+            thread->isWorking = false;
+            continue;
+        }
+
+        // put worker thread to sleep, the sleeping counter is published before the
+        // predicate is checked so submit() either sees a sleeper or we see the job.
+        std::unique_lock<std::mutex> lock(sObj->wakeMutex);
+        sObj->sleepingCounter.fetch_add(1);
+        sObj->wakeCV.wait(lock, [] {
+            return sObj->queuedCounter.load() > 0 || !sObj->isRunning;
+        });
+        sObj->sleepingCounter.fetch_sub(1);
+    }
+
+    sWorker = nullptr;
+}
+
 static void worker_thread_main(void* user)
 {
     WorkerThread* thread = (WorkerThread*)user;
 
+    if (sObj->isWorkStealing)
+    {
+        worker_thread_main_work_stealing(thread);
+        return;
+    }
+
     while (sObj->isRunning)
     {
         JobHeader job;
@@ -233,6 +481,19 @@ void JobSystem::wait_all()
 {
     LD_PROFILE_SCOPE;
 
+    if (mObj->isWorkStealing)
+    {
+        {
+            std::unique_lock<std::mutex> lock(mObj->wakeMutex);
+        }
+
+        mObj->wakeCV.notify_all();
+
+        std::unique_lock<std::mutex> lock(mObj->waitAllMutex);
+        mObj->waitAllCV.wait(lock, [] { return sObj->jobCounter.load(std::memory_order_acquire) == 0; });
+        return;
+    }
+
     bool allDispatched;
 
     do
@@ -246,29 +507,164 @@ void JobSystem::wait_all()
     mObj->waitAllCV.wait(lock, [] { return sObj->jobCounter.load(std::memory_order_acquire) == 0; });
 }
 
-void JobSystem::submit(const JobHeader* job, JobDispatchType type)
+/// submit in work stealing mode, counters are incremented before the job
+/// becomes visible to other threads so they never underflow.
+static void submit_work_stealing(const JobHeader* job, JobDispatchType type)
+{
+    sObj->jobCounter.fetch_add(1);
+    sObj->queuedCounter.fetch_add(1);
+
+    if (sWorker)
+    {
+        JobDeque* deque = (type == JOB_DISPATCH_IMMEDIATE) ? sWorker->immDeque : sWorker->stdDeque;
+
+        if (deque->push(*job))
+        {
+            wake_one_worker();
+            return;
+        }
+    }
+
+    JobQueue* queue = (type == JOB_DISPATCH_IMMEDIATE) ? &sObj->immQueue : &sObj->stdQueue;
+
+    if (queue->enqueue(*job))
+    {
+        wake_one_worker();
+        return;
+    }
+
+    // both the local deque and shared queue are full
+    sObj->queuedCounter.fetch_sub(1);
+    execute_job(*job);
+}
+
+static void submit_job(const JobHeader* job, JobDispatchType type)
 {
-    JobQueue* queue = (type == JOB_DISPATCH_IMMEDIATE) ? &mObj->immQueue : &mObj->stdQueue;
+    if (sObj->isWorkStealing)
+    {
+        submit_work_stealing(job, type);
+        return;
+    }
+
+    JobQueue* queue = (type == JOB_DISPATCH_IMMEDIATE) ? &sObj->immQueue : &sObj->stdQueue;
+
+    // count the job before it becomes visible to workers
+    sObj->jobCounter.fetch_add(1);
 
     if (queue->enqueue(*job))
     {
-        sObj->jobCounter.fetch_add(1);
         sObj->wakeCV.notify_one();
     }
     else
     {
-        sObj->jobCounter.fetch_add(1);
-
         // TODO: currently it is possible that the main thread
         //       starts executing a large job and freezes the app.
         execute_job(*job);
     }
 }
 
+void JobSystem::submit(const JobHeader* job, JobDispatchType type)
+{
+    if (job->counter)
+        job->counter->value.fetch_add(1);
+
+    submit_job(job, type);
+}
+
+void JobSystem::submit_continuation(const JobHeader* job, JobDispatchType type, JobCounter* dependency)
+{
+    LD_ASSERT(dependency);
+
+    // the continuation counts as outstanding from now on
+    if (job->counter)
+        job->counter->value.fetch_add(1);
+
+    JobContinuation* cont = heap_new<JobContinuation>(MEMORY_USAGE_JOB_SYSTEM);
+    cont->job = *job;
+    cont->type = type;
+    cont->next = dependency->continuations.load();
+
+    while (!dependency->continuations.compare_exchange_weak(cont->next, cont))
+        ;
+
+    // If the dependency already reached zero, the thread that completed it may have
+    // drained the stack before our push. Whoever exchanges the stack first submits it.
+    if (dependency->value.load() == 0)
+        release_continuations(dependency);
+}
+
+void JobSystem::wait(JobCounter* counter)
+{
+    LD_PROFILE_SCOPE;
+
+    while (!counter->is_zero())
+    {
+        if (!try_execute_job())
+            std::this_thread::yield();
+    }
+}
+
+void JobSystem::parallel_for(size_t begin, size_t end, size_t grain, JobRangeFn fn, void* user)
+{
+    LD_PROFILE_SCOPE;
+
+    if (end <= begin)
+        return;
+
+    size_t count = end - begin;
+    grain = grain ? grain : 1;
+
+    if (count <= grain || mObj->workerThreads.empty())
+    {
+        fn(begin, end, user);
+        return;
+    }
+
+    // A few chunks per thread balance uneven work, while each chunk remains
+    // a contiguous range no smaller than the grain for cache locality.
+    size_t threadCount = mObj->workerThreads.size() + 1;
+    size_t chunkCount = std::min((count + grain - 1) / grain, threadCount * JOB_PARALLEL_FOR_CHUNKS_PER_THREAD);
+
+    JobCounter counter;
+    JobRangeChunk* chunks = (JobRangeChunk*)heap_malloc(sizeof(JobRangeChunk) * chunkCount, MEMORY_USAGE_JOB_SYSTEM);
+
+    for (size_t i = 0; i < chunkCount; i++)
+    {
+        JobRangeChunk& chunk = chunks[i];
+        chunk.header = {};
+        chunk.header.onExecute = &JobRangeChunk::execute;
+        chunk.header.user = &chunk;
+        chunk.header.counter = &counter;
+        chunk.fn = fn;
+        chunk.user = user;
+        chunk.begin = begin + count * i / chunkCount;
+        chunk.end = begin + count * (i + 1) / chunkCount;
+    }
+
+    for (size_t i = 1; i < chunkCount; i++)
+        submit(&chunks[i].header, JOB_DISPATCH_IMMEDIATE);
+
+    fn(chunks[0].begin, chunks[0].end, user);
+
+    wait(&counter);
+
+    heap_free(chunks);
+}
+
 void JobSystem::prioritize(uint32_t type)
 {
     mObj->immQueue.prioritize(type);
     mObj->stdQueue.prioritize(type);
+
+    if (!mObj->isWorkStealing)
+        return;
+
+    // only the owning worker may reorder its deques
+    for (WorkerThread* thread : mObj->workerThreads)
+    {
+        thread->prioritizeType.store(type, std::memory_order_relaxed);
+        thread->hasPrioritize.store(true, std::memory_order_release);
+    }
 }
 
 } // namespace LD
\ No newline at end of file
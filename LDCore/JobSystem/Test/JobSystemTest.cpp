@@ -3,6 +3,10 @@
 #include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Memory/Memory.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 using namespace LD;
 
 class IncJob
@@ -138,12 +142,13 @@ TEST_CASE("JobSystem")
     CHECK(profile.current == 0);
 }
 
-template <size_t TCapacity, size_t N>
+template <size_t TCapacity, size_t N, bool TWorkStealing = false>
 void test_bandwidth()
 {
     JobSystem::init({
         .immediateQueueCapacity = TCapacity,
         .standardQueueCapacity = TCapacity,
+        .enableWorkStealing = TWorkStealing,
     });
 
     JobSystem js = JobSystem::get();
@@ -181,12 +186,13 @@ TEST_CASE("JobSystem bandwidth")
     CHECK(profile.current == 0);
 }
 
-template <size_t TCapacity>
+template <size_t TCapacity, bool TWorkStealing = false>
 void test_worker_spawn_jobs()
 {
     JobSystem::init({
         .immediateQueueCapacity = TCapacity,
         .standardQueueCapacity = TCapacity,
+        .enableWorkStealing = TWorkStealing,
     });
 
     FibJob job1;
@@ -221,4 +227,340 @@ TEST_CASE("JobSystem worker spawns jobs")
 
     const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_JOB_SYSTEM);
     CHECK(profile.current == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("JobSystem work stealing")
+{
+    test_bandwidth<2, 256, true>();
+    test_bandwidth<512, 256, true>();
+    test_worker_spawn_jobs<2, true>();
+    test_worker_spawn_jobs<512, true>();
+    test_worker_spawn_jobs<8192, true>();
+
+    const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_JOB_SYSTEM);
+    CHECK(profile.current == 0);
+}
+
+/// @brief job that records its execution order, optionally blocking the worker until released.
+class OrderJob
+{
+public:
+    OrderJob()
+    {
+        mHeader.onExecute = &OrderJob::main;
+        mHeader.user = this;
+    }
+
+    void submit(uint32_t type, std::vector<int>* order, int id)
+    {
+        mHeader.type = type;
+        mOrder = order;
+        mID = id;
+        JobSystem::get().submit(&mHeader, JOB_DISPATCH_STANDARD);
+    }
+
+    void submit_gate(std::atomic_bool* started, std::atomic_bool* release)
+    {
+        mStarted = started;
+        mRelease = release;
+        JobSystem::get().submit(&mHeader, JOB_DISPATCH_STANDARD);
+    }
+
+private:
+    static void main(void* user)
+    {
+        OrderJob* self = (OrderJob*)user;
+
+        if (self->mRelease)
+        {
+            self->mStarted->store(true);
+
+            while (!self->mRelease->load())
+                std::this_thread::yield();
+
+            return;
+        }
+
+        // single worker thread, no synchronization required
+        self->mOrder->push_back(self->mID);
+    }
+
+private:
+    JobHeader mHeader{};
+    std::vector<int>* mOrder = nullptr;
+    std::atomic_bool* mStarted = nullptr;
+    std::atomic_bool* mRelease = nullptr;
+    int mID = -1;
+};
+
+TEST_CASE("JobSystem work stealing prioritize")
+{
+    JobSystem::init({
+        .immediateQueueCapacity = 64,
+        .standardQueueCapacity = 64,
+        .enableWorkStealing = true,
+        .workerThreadCount = 1,
+    });
+
+    JobSystem js = JobSystem::get();
+    REQUIRE(js.get_worker_thread_count() == 1);
+
+    // occupy the only worker so the following jobs stay queued
+    std::atomic_bool started = false;
+    std::atomic_bool release = false;
+    OrderJob gate;
+    gate.submit_gate(&started, &release);
+
+    while (!started.load())
+        std::this_thread::yield();
+
+    std::vector<int> order;
+    std::vector<OrderJob> jobs(32);
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        jobs[i].submit((uint32_t)(i % 2), &order, (int)i);
+
+    js.prioritize(1);
+    release.store(true);
+    js.wait_all();
+
+    // prioritized jobs run first and keep their submission order
+    REQUIRE(order.size() == jobs.size());
+
+    for (size_t i = 0; i < jobs.size() / 2; i++)
+        CHECK(order[i] == (int)(2 * i + 1));
+
+    for (size_t i = jobs.size() / 2; i < jobs.size(); i++)
+        CHECK(order[i] % 2 == 0);
+
+    JobSystem::shutdown();
+
+    const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_JOB_SYSTEM);
+    CHECK(profile.current == 0);
+}
+
+/// @brief fibonacci job that waits on its children from the worker thread.
+class FibWaitJob
+{
+public:
+    FibWaitJob(int query)
+        : mQuery(query)
+    {
+        mHeader.onExecute = &FibWaitJob::main;
+        mHeader.user = this;
+    }
+
+    void submit(JobCounter* counter)
+    {
+        mHeader.counter = counter;
+        JobSystem::get().submit(&mHeader, JOB_DISPATCH_STANDARD);
+    }
+
+    int get_result() const
+    {
+        return mResult;
+    }
+
+private:
+    static void main(void* user)
+    {
+        FibWaitJob* job = (FibWaitJob*)user;
+
+        if (job->mQuery <= 1)
+        {
+            job->mResult = job->mQuery;
+            return;
+        }
+
+        // worker thread waits on children, executing other jobs meanwhile
+        JobCounter counter;
+        FibWaitJob child0(job->mQuery - 2);
+        FibWaitJob child1(job->mQuery - 1);
+        child0.submit(&counter);
+        child1.submit(&counter);
+        JobSystem::get().wait(&counter);
+
+        job->mResult = child0.get_result() + child1.get_result();
+    }
+
+private:
+    JobHeader mHeader{};
+    int mQuery;
+    int mResult = -1;
+};
+
+struct SumJob
+{
+    JobHeader header{};
+    std::atomic<int>* sum = nullptr;
+    int value = 0;
+
+    SumJob()
+    {
+        header.onExecute = &SumJob::main;
+        header.user = this;
+    }
+
+    static void main(void* user)
+    {
+        SumJob* self = (SumJob*)user;
+        self->sum->fetch_add(self->value);
+    }
+};
+
+template <bool TWorkStealing>
+void test_counter()
+{
+    JobSystem::init({
+        .immediateQueueCapacity = 16,
+        .standardQueueCapacity = 16,
+        .enableWorkStealing = TWorkStealing,
+    });
+
+    JobSystem js = JobSystem::get();
+
+    // wait on a subset of jobs
+    JobCounter counter;
+    std::vector<IncJob> jobs(64);
+
+    for (size_t i = 0; i < jobs.size(); i++)
+    {
+        jobs[i].set_value((int)i);
+        JobHeader* header = (JobHeader*)(jobs.data() + i);
+        header->counter = &counter;
+        js.submit(header, JOB_DISPATCH_STANDARD);
+    }
+
+    js.wait(&counter);
+    CHECK(counter.is_zero());
+
+    for (size_t i = 0; i < jobs.size(); i++)
+        CHECK(jobs[i].get_value() == (int)i + 1);
+
+    // fan-in dependency chain: stage0 (N jobs) -> stage1 -> stage2
+    std::atomic<int> sum0 = 0;
+    std::atomic<int> sum1 = 0;
+    std::atomic<int> sum2 = 0;
+    JobCounter stage0, stage1, stage2;
+    std::vector<SumJob> stage0Jobs(100);
+    SumJob stage1Job, stage2Job;
+
+    for (size_t i = 0; i < stage0Jobs.size(); i++)
+    {
+        stage0Jobs[i].sum = &sum0;
+        stage0Jobs[i].value = (int)i;
+        stage0Jobs[i].header.counter = &stage0;
+        js.submit(&stage0Jobs[i].header, JOB_DISPATCH_STANDARD);
+    }
+
+    stage1Job.sum = &sum1;
+    stage1Job.value = 1;
+    stage1Job.header.counter = &stage1;
+    js.submit_continuation(&stage1Job.header, JOB_DISPATCH_STANDARD, &stage0);
+
+    stage2Job.sum = &sum2;
+    stage2Job.value = 1;
+    stage2Job.header.counter = &stage2;
+    js.submit_continuation(&stage2Job.header, JOB_DISPATCH_IMMEDIATE, &stage1);
+
+    js.wait(&stage2);
+    CHECK(stage0.is_zero());
+    CHECK(stage1.is_zero());
+    CHECK(sum0 == 4950);
+    CHECK(sum1 == 1);
+    CHECK(sum2 == 1);
+
+    // continuation on a counter that is already zero is submitted right away
+    SumJob lateJob;
+    lateJob.sum = &sum2;
+    lateJob.value = 1;
+    lateJob.header.counter = &stage2;
+    js.submit_continuation(&lateJob.header, JOB_DISPATCH_STANDARD, &stage0);
+    js.wait(&stage2);
+    CHECK(sum2 == 2);
+
+    // worker threads waiting on counters
+    JobCounter fibCounter;
+    FibWaitJob fib(15);
+    fib.submit(&fibCounter);
+    js.wait(&fibCounter);
+    CHECK(fib.get_result() == 610);
+
+    js.wait_all();
+    JobSystem::shutdown();
+}
+
+TEST_CASE("JobSystem counter")
+{
+    test_counter<false>();
+    test_counter<true>();
+
+    const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_JOB_SYSTEM);
+    CHECK(profile.current == 0);
+}
+
+template <bool TWorkStealing>
+void test_parallel_for()
+{
+    JobSystem::init({
+        .immediateQueueCapacity = 16,
+        .standardQueueCapacity = 16,
+        .enableWorkStealing = TWorkStealing,
+    });
+
+    JobSystem js = JobSystem::get();
+
+    // every index is visited exactly once
+    std::vector<int> values(10007, 0);
+    js.parallel_for(0, values.size(), 64, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+            values[i]++;
+    });
+
+    size_t mismatch = 0;
+    for (int value : values)
+        mismatch += value != 1;
+    CHECK(mismatch == 0);
+
+    // range below grain runs inline as a single chunk
+    std::atomic<int> chunkCount = 0;
+    js.parallel_for(10, 20, 64, [&](size_t begin, size_t end) {
+        CHECK(begin == 10);
+        CHECK(end == 20);
+        chunkCount++;
+    });
+    CHECK(chunkCount == 1);
+
+    // empty range
+    chunkCount = 0;
+    js.parallel_for(5, 5, 1, [&](size_t, size_t) { chunkCount++; });
+    CHECK(chunkCount == 0);
+
+    // nested parallel_for from worker threads
+    std::vector<std::atomic<int>> sums(32);
+    js.parallel_for(0, sums.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            JobSystem::get().parallel_for(0, 1000, 10, [&](size_t b, size_t e) {
+                sums[i].fetch_add((int)(e - b));
+            });
+        }
+    });
+
+    mismatch = 0;
+    for (const std::atomic<int>& sum : sums)
+        mismatch += sum.load() != 1000;
+    CHECK(mismatch == 0);
+
+    js.wait_all();
+    JobSystem::shutdown();
+}
+
+TEST_CASE("JobSystem parallel_for")
+{
+    test_parallel_for<false>();
+    test_parallel_for<true>();
+
+    const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_JOB_SYSTEM);
+    CHECK(profile.current == 0);
+}
@@ -2,6 +2,7 @@
 #include <Ludens/Header/Assert.h>
 #include <Ludens/Log/Log.h>
 #include <Ludens/Lua/LuaState.h>
+#include <Ludens/Memory/Allocator.h>
 #include <Ludens/Memory/Memory.h>
 #include <cstring>
 
@@ -19,11 +20,14 @@ static_assert(LD::LUA_ERR_RUNTIME == LUA_ERRRUN);
 static_assert(LD::LUA_ERR_MEMORY == LUA_ERRMEM);
 static_assert(LD::LUA_ERR_ERROR == LUA_ERRERR);
 
+#define LUA_POOL_PAGE_SIZE (64 * 1024)
+
 static Log sLog("lua");
 
 struct LuaStateObj
 {
     lua_State* L;
+    SizeClassAllocator allocator; /// owns all memory of the state, released wholesale on destruction
 
     // get negative stack index
     inline int negative_index(int index)
@@ -41,30 +45,31 @@ static int lua_buffer_writer(lua_State* L, const void* p, size_t sz, void* data)
     return 0;
 }
 
+// Lua always passes the old block size, so blocks need no header.
+// Small tables, strings and closures are recycled through size class pools.
 static void* lua_alloc(void* ud, void* ptr, size_t osize, size_t nsize)
 {
-    (void)ud;
-
-    if (osize == 0)
-        return heap_malloc(nsize, MEMORY_USAGE_LUA);
+    SizeClassAllocator allocator = ((LuaStateObj*)ud)->allocator;
 
     if (nsize == 0)
     {
-        heap_free(ptr);
+        if (ptr)
+            allocator.free(ptr, osize);
+
         return NULL;
     }
 
-    void* base = heap_malloc(nsize, MEMORY_USAGE_LUA);
-    memcpy(base, ptr, std::min(osize, nsize));
-    heap_free(ptr);
-
-    return base;
+    return allocator.reallocate(ptr, osize, nsize);
 }
 
 LuaState LuaState::create(const LuaStateInfo& stateI)
 {
     LuaStateObj* obj = (LuaStateObj*)heap_malloc(sizeof(LuaStateObj), MEMORY_USAGE_LUA);
 
+    SizeClassAllocatorInfo allocatorI{};
+    allocatorI.usage = MEMORY_USAGE_LUA;
+    allocatorI.pageSize = LUA_POOL_PAGE_SIZE;
+    obj->allocator = SizeClassAllocator::create(allocatorI);
     obj->L = lua_newstate(&lua_alloc, obj);
 
     if (stateI.openLibs)
@@ -80,6 +85,7 @@ void LuaState::destroy(LuaState state)
     if (obj)
     {
         lua_close(obj->L);
+        SizeClassAllocator::destroy(obj->allocator);
         heap_free(obj);
     }
 
@@ -115,13 +121,13 @@ LuaState& LuaState::operator=(const LuaState& other)
     return *this;
 }
 
-bool LuaState::dump(const char* str, Buffer& buffer)
+bool LuaState::dump(const char* str, Buffer& buffer, const char* name)
 {
     buffer.resize(0);
 
     int oldSize = lua_gettop(mL);
 
-    int err = luaL_loadstring(mL, str);
+    int err = luaL_loadbuffer(mL, str, strlen(str), name ? name : str);
     if (err != 0)
     {
         lua_settop(mL, oldSize);
@@ -155,6 +161,53 @@ bool LuaState::do_file(const char* filepath)
     return ret == 0;
 }
 
+void LuaState::gc_stop()
+{
+    lua_gc(mL, LUA_GCSTOP, 0);
+}
+
+void LuaState::gc_restart()
+{
+    lua_gc(mL, LUA_GCRESTART, 0);
+}
+
+void LuaState::gc_collect()
+{
+    lua_gc(mL, LUA_GCCOLLECT, 0);
+}
+
+bool LuaState::gc_step(int stepKB)
+{
+    return lua_gc(mL, LUA_GCSTEP, stepKB) == 1;
+}
+
+int LuaState::gc_set_pause(int pause)
+{
+    return lua_gc(mL, LUA_GCSETPAUSE, pause);
+}
+
+int LuaState::gc_set_step_multiplier(int stepMultiplier)
+{
+    return lua_gc(mL, LUA_GCSETSTEPMUL, stepMultiplier);
+}
+
+// non-owning handles from lua callbacks reach the state object through the allocator userdata
+size_t LuaState::get_memory_size()
+{
+    void* ud;
+    lua_getallocf(mL, &ud);
+
+    return ((LuaStateObj*)ud)->allocator.size();
+}
+
+size_t LuaState::get_peak_memory_size()
+{
+    void* ud;
+    lua_getallocf(mL, &ud);
+
+    return ((LuaStateObj*)ud)->allocator.peak_size();
+}
+
 void LuaState::get_global(const char* name)
 {
     lua_getglobal(mL, name);
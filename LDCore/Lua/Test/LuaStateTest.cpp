@@ -4,6 +4,7 @@
 #include <Ludens/Lua/LuaState.h>
 #include <Ludens/Memory/Memory.h>
 #include <limits>
+#include <string>
 
 using namespace LD;
 
@@ -328,6 +329,17 @@ TEST_CASE("LuaState dump")
     CHECK(L.size() == 1);
     CHECK(L.get_type(-1) == LUA_TYPE_NUMBER);
     CHECK(L.to_integer(-1) == 3);
+    L.pop(1);
+
+    // chunk name is kept in bytecode debug info
+    ok = L.dump("error('oops')", *buf, "@foo.lua");
+    CHECK(ok);
+    ok = L.load_buffer((const char*)buf->data(), buf->size(), "bc");
+    CHECK(ok);
+    err = L.pcall(0, 0, 0);
+    CHECK(err != 0);
+    CHECK(std::string(L.to_string(-1)).starts_with("foo.lua:1:"));
+    L.pop(1);
 
     delete buf;
 
@@ -363,3 +375,39 @@ TEST_CASE("LuaState registry refs")
 
     CHECK_FALSE(get_memory_leaks(nullptr));
 }
+
+TEST_CASE("LuaState garbage collection")
+{
+    LuaState L = LuaState::create(sTestStateInfo);
+
+    L.gc_stop();
+    size_t baseSize = L.get_memory_size();
+
+    bool ok = L.do_string("local t = {} for i = 1, 10000 do t[i] = { i } end");
+    CHECK(ok);
+    CHECK(L.get_memory_size() > baseSize);
+    CHECK(L.get_peak_memory_size() >= L.get_memory_size());
+
+    // garbage is only reclaimed by explicit steps while stopped
+    bool isCycleFinished = false;
+    for (int i = 0; i < 1000 && !isCycleFinished; i++)
+        isCycleFinished = L.gc_step(64);
+    CHECK(isCycleFinished);
+    CHECK(L.get_memory_size() < L.get_peak_memory_size());
+
+    L.gc_set_pause(150);
+    CHECK(L.gc_set_pause(200) == 150);
+    L.gc_set_step_multiplier(400);
+    CHECK(L.gc_set_step_multiplier(200) == 400);
+
+    L.gc_restart();
+    L.gc_collect();
+
+    // live objects are released wholesale with the state
+    ok = L.do_string("_G.keep = {} for i = 1, 1000 do _G.keep[i] = tostring(i) end");
+    CHECK(ok);
+
+    LuaState::destroy(L);
+
+    CHECK_FALSE(get_memory_leaks(nullptr));
+}
@@ -8,6 +8,7 @@
 #include <Ludens/Serial/Compress.h>
 #include <Ludens/System/FileSystem.h>
 
+#include <algorithm>
 #include <cstring>
 
 #include <stb/stb_image.h>
@@ -55,21 +56,30 @@ inline uint32_t get_pixel_size_from_format(BitmapFormat format)
     return sBitmapFormatTable[(int)format].pixelSize;
 }
 
-Bitmap Bitmap::create_from_data(uint32_t width, uint32_t height, BitmapFormat format, const void* data)
+/// @brief Allocate bitmap with pixel storage following the object, pixels are uninitialized.
+static BitmapObj* allocate_bitmap(uint32_t width, uint32_t height, BitmapFormat format)
 {
-    LD_PROFILE_SCOPE;
-
     uint64_t pixelSize = (uint64_t)get_pixel_size_from_format(format);
-    uint64_t dataSize = width * height * pixelSize;
+    uint64_t dataSize = (uint64_t)width * height * pixelSize;
 
     BitmapObj* obj = (BitmapObj*)heap_malloc(sizeof(BitmapObj) + dataSize, MEMORY_USAGE_MEDIA);
     obj->flags = 0;
     obj->width = width;
     obj->height = height;
     obj->format = format;
+    obj->compression = BITMAP_COMPRESSION_LZ4;
     obj->data = (byte*)(obj + 1);
 
-    memcpy(obj->data, data, dataSize);
+    return obj;
+}
+
+Bitmap Bitmap::create_from_data(uint32_t width, uint32_t height, BitmapFormat format, const void* data)
+{
+    LD_PROFILE_SCOPE;
+
+    BitmapObj* obj = allocate_bitmap(width, height, format);
+
+    memcpy(obj->data, data, (uint64_t)width * height * get_pixel_size_from_format(format));
 
     return {obj};
 }
@@ -90,6 +100,7 @@ Bitmap Bitmap::create_from_file_data(uint32_t fileSize, const void* fileData)
     }
 
     obj->format = BITMAP_FORMAT_RGBA8U;
+    obj->compression = BITMAP_COMPRESSION_LZ4;
     obj->flags = BITMAP_FLAG_USE_STB_FREE;
     obj->width = (uint32_t)x;
     obj->height = (uint32_t)y;
@@ -97,6 +108,41 @@ Bitmap Bitmap::create_from_file_data(uint32_t fileSize, const void* fileData)
     return Bitmap(obj);
 }
 
+Bitmap Bitmap::create_half_size(const Bitmap& src)
+{
+    LD_PROFILE_SCOPE;
+
+    const BitmapObj* srcObj = src;
+    LD_ASSERT(srcObj->format != BITMAP_FORMAT_RGBA32F);
+
+    const uint32_t srcW = srcObj->width;
+    const uint32_t srcH = srcObj->height;
+    const uint32_t dstW = srcW > 1 ? srcW / 2 : 1;
+    const uint32_t dstH = srcH > 1 ? srcH / 2 : 1;
+    const uint32_t ch = get_channels_from_format(srcObj->format);
+
+    BitmapObj* obj = allocate_bitmap(dstW, dstH, srcObj->format);
+
+    for (uint32_t y = 0; y < dstH; y++)
+    {
+        // clamp the second row and column for single pixel dimensions
+        const byte* row0 = srcObj->data + (uint64_t)std::min(y * 2, srcH - 1) * srcW * ch;
+        const byte* row1 = srcObj->data + (uint64_t)std::min(y * 2 + 1, srcH - 1) * srcW * ch;
+        byte* dst = obj->data + (uint64_t)y * dstW * ch;
+
+        for (uint32_t x = 0; x < dstW; x++)
+        {
+            const uint32_t x0 = std::min(x * 2, srcW - 1) * ch;
+            const uint32_t x1 = std::min(x * 2 + 1, srcW - 1) * ch;
+
+            for (uint32_t c = 0; c < ch; c++)
+                dst[x * ch + c] = (byte)((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) / 4);
+        }
+    }
+
+    return Bitmap(obj);
+}
+
 Bitmap Bitmap::create_from_path(const char* path, bool isF32)
 {
     LD_PROFILE_SCOPE;
@@ -267,9 +313,17 @@ bool Bitmap::serialize(Serializer& serial, const Bitmap& bitmap)
     serial.write_u32((uint32_t)obj->format);
     serial.write_u32((uint32_t)obj->compression);
 
+    size_t dataSize = (size_t)obj->width * obj->height * pixelSize;
+
+    if (obj->compression == BITMAP_COMPRESSION_NONE)
+    {
+        serial.write_u64((uint64_t)dataSize);
+        serial.write(obj->data, dataSize);
+        return true;
+    }
+
     LD_ASSERT(obj->compression == BITMAP_COMPRESSION_LZ4);
 
-    size_t dataSize = obj->width * obj->height * pixelSize;
     size_t sizeBound = lz4_compress_bound(dataSize);
     Vector<byte> compressed(sizeBound);
     size_t cmpSize = lz4_compress(compressed.data(), compressed.size(), obj->data, dataSize);
@@ -292,19 +346,39 @@ bool Bitmap::deserialize(Deserializer& serial, Bitmap& bitmap)
     serial.read_u32(compressionU32);
 
     const BitmapFormat format = (BitmapFormat)formatU32;
+    const BitmapCompression compression = (BitmapCompression)compressionU32;
     const uint32_t pixelSize = get_pixel_size_from_format(format);
 
-    uint64_t lz4BlockSize;
-    serial.read_u64(lz4BlockSize);
+    uint64_t blockSize;
+    serial.read_u64(blockSize);
 
-    const byte* lz4BlockData = serial.view_now();
-    serial.advance(lz4BlockSize);
+    const byte* blockData = serial.view_now();
+    serial.advance(blockSize);
 
-    size_t dataSize = width * height * pixelSize;
-    Vector<byte> pixels(dataSize);
-    lz4_decompress(pixels.data(), pixels.size(), lz4BlockData, lz4BlockSize);
+    // decompress or copy straight into bitmap storage
+    BitmapObj* obj = allocate_bitmap(width, height, format);
+    obj->compression = compression;
+    size_t dataSize = (size_t)width * height * pixelSize;
+
+    bool isValid;
+
+    if (compression == BITMAP_COMPRESSION_NONE)
+    {
+        isValid = blockSize == dataSize;
+        if (isValid)
+            memcpy(obj->data, blockData, dataSize);
+    }
+    else
+        isValid = lz4_decompress(obj->data, dataSize, blockData, blockSize) == dataSize;
+
+    // truncated or corrupt pixel block
+    if (!isValid)
+    {
+        heap_free(obj);
+        return false;
+    }
 
-    bitmap = Bitmap::create_from_data(width, height, format, pixels.data());
+    bitmap = Bitmap(obj);
 
     return true;
 }
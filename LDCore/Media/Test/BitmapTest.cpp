@@ -1,6 +1,10 @@
 #include <Extra/doctest/doctest.h>
+#include <Ludens/DSA/Vector.h>
 #include <Ludens/Header/Math/Math.h>
 #include <Ludens/Media/Bitmap.h>
+#include <Ludens/Serial/Serial.h>
+
+#include <cstring>
 
 using namespace LD;
 
@@ -8,8 +12,8 @@ TEST_CASE("Bitmap MSE")
 {
     uint32_t pixel1 = 0xFFFFFFFF;
     uint32_t pixel2 = 0;
-    BitmapView view1{1, 1, BITMAP_CHANNEL_RGBA, (const char*)&pixel1};
-    BitmapView view2{1, 1, BITMAP_CHANNEL_RGBA, (const char*)&pixel2};
+    BitmapView view1{1, 1, BITMAP_FORMAT_RGBA8U, (const char*)&pixel1};
+    BitmapView view2{1, 1, BITMAP_FORMAT_RGBA8U, (const char*)&pixel2};
 
     double mse;
     CHECK(Bitmap::compute_mse(view1, view2, mse));
@@ -29,4 +33,74 @@ TEST_CASE("Bitmap MSE")
 
     CHECK(Bitmap::compute_mse(view1, view1, mse));
     CHECK(is_equal_epsilon(mse, 0.0));
-}
\ No newline at end of file
+}
+
+TEST_CASE("Bitmap half size")
+{
+    // 3x2 grayscale, the odd column is clamped
+    const uint8_t pixels[6] = {
+        0, 100, 200,
+        40, 60, 0};
+    Bitmap src = Bitmap::create_from_data(3, 2, BITMAP_FORMAT_R8U, pixels);
+    Bitmap half = Bitmap::create_half_size(src);
+    CHECK(half.width() == 1);
+    CHECK(half.height() == 1);
+    CHECK(half.data()[0] == 50);
+
+    Bitmap quarter = Bitmap::create_half_size(half);
+    CHECK(quarter.width() == 1);
+    CHECK(quarter.height() == 1);
+    CHECK(quarter.data()[0] == 50);
+
+    Bitmap::destroy(quarter);
+    Bitmap::destroy(half);
+    Bitmap::destroy(src);
+}
+
+TEST_CASE("Bitmap serialize")
+{
+    uint32_t pixels[16];
+    for (uint32_t i = 0; i < 16; i++)
+        pixels[i] = i < 8 ? 0xFF00FF00 : i * 0x01020304;
+
+    Bitmap src = Bitmap::create_from_data(4, 4, BITMAP_FORMAT_RGBA8U, pixels);
+
+    for (BitmapCompression compression : {BITMAP_COMPRESSION_LZ4, BITMAP_COMPRESSION_NONE})
+    {
+        src.set_compression(compression);
+
+        Serializer serializer;
+        CHECK(Bitmap::serialize(serializer, src));
+
+        View view = serializer.view();
+        Deserializer deserializer(view.data, view.size);
+        Bitmap dst{};
+        CHECK(Bitmap::deserialize(deserializer, dst));
+        CHECK(dst.width() == 4);
+        CHECK(dst.height() == 4);
+        CHECK(dst.format() == BITMAP_FORMAT_RGBA8U);
+
+        double mse;
+        CHECK(Bitmap::compute_mse(src.view(), dst.view(), mse));
+        CHECK(mse == 0.0);
+
+        Bitmap::destroy(dst);
+    }
+
+    // uncompressed block size that does not match the bitmap dimensions
+    src.set_compression(BITMAP_COMPRESSION_NONE);
+    Serializer serializer;
+    CHECK(Bitmap::serialize(serializer, src));
+
+    View view = serializer.view();
+    Vector<byte> corrupt(view.data, view.data + view.size);
+    uint64_t blockSize = sizeof(pixels) / 2;
+    memcpy(corrupt.data() + 16, &blockSize, sizeof(blockSize));
+
+    Deserializer deserializer(corrupt.data(), corrupt.size());
+    Bitmap dst{};
+    CHECK_FALSE(Bitmap::deserialize(deserializer, dst));
+    CHECK_FALSE(dst);
+
+    Bitmap::destroy(src);
+}
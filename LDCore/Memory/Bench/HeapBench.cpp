@@ -0,0 +1,114 @@
+#include <Ludens/Memory/Memory.h>
+#include <Ludens/System/Timer.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace LD;
+
+constexpr int ALLOC_PER_THREAD = 1'000'000;
+constexpr int BATCH_SIZE = 64;
+
+/// mutex per usage accounting, what heap_malloc used to do
+struct LockedAccounting
+{
+    std::mutex mutex[MEMORY_USAGE_ENUM_LAST];
+    std::size_t current[MEMORY_USAGE_ENUM_LAST]{};
+    std::size_t peak[MEMORY_USAGE_ENUM_LAST]{};
+} sLocked;
+
+struct LockedHeader
+{
+    std::size_t size;
+    MemoryUsage usage;
+};
+
+static void* locked_malloc(std::size_t size, MemoryUsageSite site)
+{
+    MemoryUsage usage = site.usage;
+    LockedHeader* header = (LockedHeader*)std::malloc(sizeof(LockedHeader) + size);
+    header->size = size;
+    header->usage = usage;
+
+    {
+        std::unique_lock<std::mutex> lock(sLocked.mutex[usage]);
+        sLocked.current[usage] += size;
+        sLocked.peak[usage] = std::max(sLocked.peak[usage], sLocked.current[usage]);
+    }
+
+    return header + 1;
+}
+
+static void locked_free(void* ptr)
+{
+    LockedHeader* header = (LockedHeader*)ptr - 1;
+
+    {
+        std::unique_lock<std::mutex> lock(sLocked.mutex[header->usage]);
+        sLocked.current[header->usage] -= header->size;
+    }
+
+    std::free(header);
+}
+
+/// small allocations freed in batches, every thread uses the same usage to maximize contention
+template <void* (*TMalloc)(std::size_t, MemoryUsageSite), void (*TFree)(void*)>
+static float bench_threads(int threadCount)
+{
+    std::atomic<bool> start = false;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&]() {
+            void* batch[BATCH_SIZE];
+
+            while (!start)
+                std::this_thread::yield();
+
+            for (int i = 0; i < ALLOC_PER_THREAD; i += BATCH_SIZE)
+            {
+                for (int j = 0; j < BATCH_SIZE; j++)
+                    batch[j] = TMalloc(16 + (j % 8) * 16, MEMORY_USAGE_MISC);
+
+                for (int j = 0; j < BATCH_SIZE; j++)
+                    TFree(batch[j]);
+            }
+        });
+    }
+
+    size_t us;
+    {
+        ScopeTimer timer(&us);
+        start = true;
+
+        for (std::thread& thread : threads)
+            thread.join();
+    }
+
+    return us / 1000.0f;
+}
+
+int main(int argc, char** argv)
+{
+    int maxThreads = std::max(4, (int)std::thread::hardware_concurrency());
+
+    printf("%d allocations per thread, hardware threads: %u\n", ALLOC_PER_THREAD, std::thread::hardware_concurrency());
+
+    for (int threadCount = 1; threadCount <= maxThreads; threadCount *= 2)
+    {
+        float lockedMS = bench_threads<&locked_malloc, &locked_free>(threadCount);
+
+        heap_set_backend(HEAP_BACKEND_SYSTEM);
+        float systemMS = bench_threads<&heap_malloc, &heap_free>(threadCount);
+
+        heap_set_backend(HEAP_BACKEND_SLAB);
+        float slabMS = bench_threads<&heap_malloc, &heap_free>(threadCount);
+
+        printf("%2d threads: mutex accounting %8.3f ms, heap_malloc system %8.3f ms, heap_malloc slab %8.3f ms\n", threadCount, lockedMS, systemMS, slabMS);
+    }
+}
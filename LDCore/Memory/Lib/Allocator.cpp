@@ -2,6 +2,11 @@
 #include <Ludens/Header/Types.h>
 #include <Ludens/Memory/Allocator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+
 namespace LD {
 
 struct LinearAllocatorObj
@@ -17,9 +22,9 @@ struct LinearAllocatorObj
     MemoryUsage usage; /// usage domain
     bool isMultiPage;  /// whether allocator paginates
 
-    void allocate_page()
+    void allocate_page(const std::source_location& site)
     {
-        Page* page = (Page*)heap_malloc(sizeof(Page) + capacity, usage);
+        Page* page = (Page*)heap_malloc(sizeof(Page) + capacity, {usage, site});
         page->next = pageList;
         page->used = 0;
         pageList = page;
@@ -40,9 +45,9 @@ struct LinearAllocatorObj
     }
 };
 
-LinearAllocator LinearAllocator::create(const LinearAllocatorInfo& info)
+LinearAllocator LinearAllocator::create(const LinearAllocatorInfo& info, std::source_location site)
 {
-    LinearAllocatorObj* obj = (LinearAllocatorObj*)heap_malloc(sizeof(LinearAllocatorObj), info.usage);
+    LinearAllocatorObj* obj = (LinearAllocatorObj*)heap_malloc(sizeof(LinearAllocatorObj), {info.usage, site});
     obj->usage = info.usage;
     obj->capacity = info.capacity;
     obj->pageList = nullptr; // defer until first allocation
@@ -97,13 +102,13 @@ size_t LinearAllocator::remain() const
     return mObj->capacity - currentPage->used;
 }
 
-void* LinearAllocator::allocate(size_t size)
+void* LinearAllocator::allocate(size_t size, std::source_location site)
 {
     if (size > mObj->capacity)
         return nullptr; // can't satisfy request even in multi-page mode
 
     if (!mObj->pageList || (mObj->isMultiPage && remain() < size))
-        mObj->allocate_page();
+        mObj->allocate_page(site);
 
     LinearAllocatorObj::Page* currentPage = mObj->pageList;
     LD_ASSERT(currentPage);
@@ -118,10 +123,10 @@ void* LinearAllocator::allocate(size_t size)
     return nullptr;
 }
 
-void* LinearAllocator::allocate_aligned(size_t size, size_t alignment)
+void* LinearAllocator::allocate_aligned(size_t size, size_t alignment, std::source_location site)
 {
     if (!mObj->pageList)
-        mObj->allocate_page();
+        mObj->allocate_page(site);
 
     LinearAllocatorObj::Page* currentPage = mObj->pageList;
     LD_ASSERT(currentPage);
@@ -134,7 +139,7 @@ void* LinearAllocator::allocate_aligned(size_t size, size_t alignment)
         return nullptr;
 
     if (pad + size > remain())
-        mObj->allocate_page();
+        mObj->allocate_page(site);
 
     currentPage = mObj->pageList;
     LD_ASSERT(currentPage->used + pad + size <= mObj->capacity);
@@ -204,9 +209,9 @@ struct PoolAllocatorObj
     MemoryUsage usage;
     bool isMultiPage;
 
-    void allocate_page()
+    void allocate_page(const std::source_location& site)
     {
-        Page* page = (Page*)heap_malloc(sizeof(Page) + blockSize * pageSize, usage);
+        Page* page = (Page*)heap_malloc(sizeof(Page) + blockSize * pageSize, {usage, site});
         page->obj = this;
         page->next = pageList;
         pageList = page;
@@ -228,11 +233,11 @@ struct PoolAllocatorObj
 
 static_assert(sizeof(PoolAllocatorObj::Block) == 16); // update Allocator.h
 
-PoolAllocator PoolAllocator::create(const PoolAllocatorInfo& info)
+PoolAllocator PoolAllocator::create(const PoolAllocatorInfo& info, std::source_location site)
 {
     LD_ASSERT(info.blockSize != 0 && info.pageSize > 0);
 
-    PoolAllocatorObj* obj = (PoolAllocatorObj*)heap_malloc(sizeof(PoolAllocatorObj), info.usage);
+    PoolAllocatorObj* obj = (PoolAllocatorObj*)heap_malloc(sizeof(PoolAllocatorObj), {info.usage, site});
     obj->usage = info.usage;
     obj->blockSize = info.blockSize + sizeof(PoolAllocatorObj::Block); // each block includes 16-byte header overhead
     obj->pageSize = info.pageSize;
@@ -256,10 +261,10 @@ void PoolAllocator::destroy(PoolAllocator allocator)
     heap_free(obj);
 }
 
-void* PoolAllocator::allocate()
+void* PoolAllocator::allocate(std::source_location site)
 {
     if (!mObj->pageList)
-        mObj->allocate_page();
+        mObj->allocate_page(site);
 
     for (PoolAllocatorObj::Page* page = mObj->pageList; page; page = page->next)
     {
@@ -276,7 +281,7 @@ void* PoolAllocator::allocate()
 
     if (mObj->isMultiPage)
     {
-        mObj->allocate_page();
+        mObj->allocate_page(site);
         PoolAllocatorObj::Page* page = mObj->pageList;
         LD_ASSERT(page && page->freeBlocks);
 
@@ -315,6 +320,16 @@ size_t PoolAllocator::page_count() const
     return count;
 }
 
+size_t PoolAllocator::block_count() const
+{
+    size_t count = 0;
+
+    for (PoolAllocatorObj::Page* page = mObj->pageList; page; page = page->next)
+        count += page->allocated_block_count();
+
+    return count;
+}
+
 PoolAllocator::Iterator& PoolAllocator::Iterator::operator++()
 {
     // jump to next page or return end
@@ -373,4 +388,430 @@ PoolAllocator::Iterator PoolAllocator::begin()
     return Iterator(nullptr, nullptr, 0);
 }
 
+#define SIZE_CLASS_COUNT (SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE / 16)
+
+struct SizeClassAllocatorObj
+{
+    struct Block
+    {
+        Block* next; /// next block free for allocation within the same size class
+    };
+
+    struct alignas(16) Page
+    {
+        Page* next;
+    };
+
+    struct alignas(16) LargeBlock
+    {
+        LargeBlock* prev;
+        LargeBlock* next;
+    };
+
+    Block* freeList[SIZE_CLASS_COUNT]; /// recycled blocks of each size class
+    byte* carve;                       /// next uncarved byte in the newest page
+    byte* carveEnd;                    /// end of the newest page
+    Page* pageList;                    /// memory pages, released wholesale
+    LargeBlock* largeList;             /// blocks larger than any size class
+    MemoryUsage usage;                 /// usage domain
+    size_t pageSize;                   /// byte capacity per page
+    size_t pageCount;                  /// number of pages allocated
+    size_t size;                       /// bytes currently allocated
+    size_t peakSize;                   /// peak bytes allocated
+
+    static inline uint32_t get_class_index(size_t size)
+    {
+        return (uint32_t)((size + 15) / 16) - 1;
+    }
+
+    void* allocate_small(uint32_t classIndex, const std::source_location& site)
+    {
+        Block* block = freeList[classIndex];
+
+        if (block)
+        {
+            freeList[classIndex] = block->next;
+            return block;
+        }
+
+        size_t blockSize = (classIndex + 1) * 16;
+
+        // the tail of the previous page is abandoned
+        if (carve + blockSize > carveEnd)
+        {
+            Page* page = (Page*)heap_malloc(sizeof(Page) + pageSize, {usage, site});
+            page->next = pageList;
+            pageList = page;
+            pageCount++;
+            carve = (byte*)(page + 1);
+            carveEnd = carve + pageSize;
+        }
+
+        void* carved = carve;
+        carve += blockSize;
+
+        return carved;
+    }
+
+    void* allocate_large(size_t size, const std::source_location& site)
+    {
+        LargeBlock* block = (LargeBlock*)heap_malloc(sizeof(LargeBlock) + size, {usage, site});
+        block->prev = nullptr;
+        block->next = largeList;
+
+        if (largeList)
+            largeList->prev = block;
+
+        largeList = block;
+
+        return block + 1;
+    }
+
+    void free_large(void* ptr)
+    {
+        LargeBlock* block = (LargeBlock*)ptr - 1;
+
+        if (block->prev)
+            block->prev->next = block->next;
+        else
+            largeList = block->next;
+
+        if (block->next)
+            block->next->prev = block->prev;
+
+        heap_free(block);
+    }
+};
+
+SizeClassAllocator SizeClassAllocator::create(const SizeClassAllocatorInfo& info, std::source_location site)
+{
+    LD_ASSERT(info.pageSize >= SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE && info.pageSize % 16 == 0);
+
+    SizeClassAllocatorObj* obj = (SizeClassAllocatorObj*)heap_malloc(sizeof(SizeClassAllocatorObj), {info.usage, site});
+    memset(obj, 0, sizeof(SizeClassAllocatorObj)); // pages are deferred until first allocation
+    obj->usage = info.usage;
+    obj->pageSize = info.pageSize;
+
+    return {obj};
+}
+
+void SizeClassAllocator::destroy(SizeClassAllocator allocator)
+{
+    SizeClassAllocatorObj* obj = allocator;
+
+    while (obj->pageList)
+    {
+        SizeClassAllocatorObj::Page* page = obj->pageList;
+        obj->pageList = page->next;
+        heap_free(page);
+    }
+
+    while (obj->largeList)
+    {
+        SizeClassAllocatorObj::LargeBlock* block = obj->largeList;
+        obj->largeList = block->next;
+        heap_free(block);
+    }
+
+    heap_free(obj);
+}
+
+void* SizeClassAllocator::allocate(size_t size, std::source_location site)
+{
+    LD_ASSERT(size > 0);
+
+    mObj->size += size;
+    mObj->peakSize = std::max(mObj->peakSize, mObj->size);
+
+    if (size > SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE)
+        return mObj->allocate_large(size, site);
+
+    return mObj->allocate_small(SizeClassAllocatorObj::get_class_index(size), site);
+}
+
+void* SizeClassAllocator::reallocate(void* block, size_t oldSize, size_t newSize, std::source_location site)
+{
+    if (!block)
+        return allocate(newSize, site);
+
+    LD_ASSERT(newSize > 0);
+
+    bool isSmall = oldSize <= SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE && newSize <= SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE;
+
+    // shrinking or growing within the same size class keeps the block
+    if (isSmall && SizeClassAllocatorObj::get_class_index(oldSize) == SizeClassAllocatorObj::get_class_index(newSize))
+    {
+        mObj->size = mObj->size - oldSize + newSize;
+        mObj->peakSize = std::max(mObj->peakSize, mObj->size);
+        return block;
+    }
+
+    void* newBlock = allocate(newSize, site);
+    memcpy(newBlock, block, std::min(oldSize, newSize));
+    free(block, oldSize);
+
+    return newBlock;
+}
+
+void SizeClassAllocator::free(void* block, size_t size)
+{
+    LD_ASSERT(mObj->size >= size);
+
+    mObj->size -= size;
+
+    if (size > SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE)
+    {
+        mObj->free_large(block);
+        return;
+    }
+
+    uint32_t classIndex = SizeClassAllocatorObj::get_class_index(size);
+    SizeClassAllocatorObj::Block* blk = (SizeClassAllocatorObj::Block*)block;
+    blk->next = mObj->freeList[classIndex];
+    mObj->freeList[classIndex] = blk;
+}
+
+size_t SizeClassAllocator::page_count() const
+{
+    return mObj->pageCount;
+}
+
+size_t SizeClassAllocator::size() const
+{
+    return mObj->size;
+}
+
+size_t SizeClassAllocator::peak_size() const
+{
+    return mObj->peakSize;
+}
+
+struct FrameArenaObj
+{
+    struct Page
+    {
+        Page* next;
+        size_t capacity;
+        size_t used;
+    };
+
+    /// @brief Pages of a thread for a single frame parity.
+    struct Buffer
+    {
+        Page* pageList;    /// retained pages in fill order
+        Page* currentPage; /// page being filled
+        Page* largeList;   /// dedicated pages for oversized requests, freed on reset
+    };
+
+    /// @brief Arena state of a thread, only the owner thread allocates from its buffers.
+    struct Thread
+    {
+        Buffer buffers[2];
+        uint64_t frame; /// frame index the owner last allocated in
+        std::atomic<size_t> bytesSaved;
+        Thread* next;
+    };
+
+    MemoryUsage usage;
+    size_t pageSize;
+    uint64_t id;                 /// distinguishes arenas across create and destroy
+    std::atomic<uint64_t> frame; /// current frame index
+    std::mutex threadMutex;      /// guards the thread list
+    Thread* threadList;          /// threads that allocated from the arena
+
+    Page* allocate_page(size_t capacity, const std::source_location& site)
+    {
+        Page* page = (Page*)heap_malloc(sizeof(Page) + capacity, {usage, site});
+        page->next = nullptr;
+        page->capacity = capacity;
+        page->used = 0;
+        return page;
+    }
+
+    void reset_buffer(Buffer& buffer)
+    {
+        for (Page* page = buffer.pageList; page; page = page->next)
+            page->used = 0;
+
+        buffer.currentPage = buffer.pageList;
+
+        free_page_list(buffer.largeList);
+        buffer.largeList = nullptr;
+    }
+
+    Thread* get_thread(const std::source_location& site);
+    void* allocate(Thread* thread, size_t size, size_t alignment, const std::source_location& site);
+
+    static void* allocate_from_page(Page* page, size_t size, size_t alignment);
+    static void free_page_list(Page* page);
+};
+
+static FrameArenaObj* sFrameArena = nullptr;
+static uint64_t sFrameArenaID = 0;
+static thread_local FrameArenaObj::Thread* sFrameArenaThread;
+static thread_local uint64_t sFrameArenaThreadID;
+
+FrameArenaObj::Thread* FrameArenaObj::get_thread(const std::source_location& site)
+{
+    if (sFrameArenaThreadID == id)
+        return sFrameArenaThread;
+
+    Thread* thread = heap_new<Thread>({usage, site});
+    thread->buffers[0] = {};
+    thread->buffers[1] = {};
+    thread->frame = frame.load(std::memory_order_acquire);
+    thread->bytesSaved.store(0, std::memory_order_relaxed);
+
+    {
+        std::unique_lock<std::mutex> lock(threadMutex);
+        thread->next = threadList;
+        threadList = thread;
+    }
+
+    sFrameArenaThread = thread;
+    sFrameArenaThreadID = id;
+
+    return thread;
+}
+
+void* FrameArenaObj::allocate_from_page(Page* page, size_t size, size_t alignment)
+{
+    uintptr_t base = (uintptr_t)(page + 1);
+    uintptr_t now = (base + page->used + alignment - 1) & ~(uintptr_t)(alignment - 1);
+
+    if (now + size > base + page->capacity)
+        return nullptr;
+
+    page->used = now + size - base;
+    return (void*)now;
+}
+
+void FrameArenaObj::free_page_list(Page* page)
+{
+    while (page)
+    {
+        Page* nextPage = page->next;
+        heap_free(page);
+        page = nextPage;
+    }
+}
+
+void* FrameArenaObj::allocate(Thread* thread, size_t size, size_t alignment, const std::source_location& site)
+{
+    uint64_t currentFrame = frame.load(std::memory_order_acquire);
+    Buffer& buffer = thread->buffers[currentFrame & 1];
+
+    // recycle buffers whose frames have ended
+    if (thread->frame != currentFrame)
+    {
+        if (currentFrame - thread->frame >= 2)
+            reset_buffer(thread->buffers[(currentFrame + 1) & 1]);
+
+        reset_buffer(buffer);
+        thread->frame = currentFrame;
+    }
+
+    thread->bytesSaved.fetch_add(size, std::memory_order_relaxed);
+
+    if (size + alignment > pageSize)
+    {
+        Page* page = allocate_page(size + alignment, site);
+        page->next = buffer.largeList;
+        buffer.largeList = page;
+        return allocate_from_page(page, size, alignment);
+    }
+
+    while (buffer.currentPage)
+    {
+        void* ptr = allocate_from_page(buffer.currentPage, size, alignment);
+        if (ptr)
+            return ptr;
+
+        if (!buffer.currentPage->next)
+            break;
+
+        buffer.currentPage = buffer.currentPage->next;
+    }
+
+    Page* page = allocate_page(pageSize, site);
+
+    if (buffer.currentPage)
+        buffer.currentPage->next = page;
+    else
+        buffer.pageList = page;
+
+    buffer.currentPage = page;
+
+    return allocate_from_page(page, size, alignment);
+}
+
+FrameArena FrameArena::create(const FrameArenaInfo& info, std::source_location site)
+{
+    LD_ASSERT(!sFrameArena); // singleton
+
+    sFrameArena = heap_new<FrameArenaObj>({info.usage, site});
+    sFrameArena->usage = info.usage;
+    sFrameArena->pageSize = info.pageSize;
+    sFrameArena->id = ++sFrameArenaID;
+    sFrameArena->frame.store(0, std::memory_order_relaxed);
+    sFrameArena->threadList = nullptr;
+
+    return FrameArena(sFrameArena);
+}
+
+void FrameArena::destroy()
+{
+    LD_ASSERT(sFrameArena); // singleton
+
+    FrameArenaObj::Thread* thread = sFrameArena->threadList;
+
+    while (thread)
+    {
+        FrameArenaObj::Thread* nextThread = thread->next;
+
+        for (FrameArenaObj::Buffer& buffer : thread->buffers)
+        {
+            FrameArenaObj::free_page_list(buffer.pageList);
+            FrameArenaObj::free_page_list(buffer.largeList);
+        }
+
+        heap_delete<FrameArenaObj::Thread>(thread);
+        thread = nextThread;
+    }
+
+    heap_delete<FrameArenaObj>(sFrameArena);
+    sFrameArena = nullptr;
+}
+
+FrameArena FrameArena::get()
+{
+    return FrameArena(sFrameArena);
+}
+
+void FrameArena::next_frame()
+{
+    mObj->frame.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t FrameArena::frame_index() const
+{
+    return mObj->frame.load(std::memory_order_relaxed);
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment, std::source_location site)
+{
+    return mObj->allocate(mObj->get_thread(site), size, alignment, site);
+}
+
+size_t FrameArena::bytes_saved() const
+{
+    std::unique_lock<std::mutex> lock(mObj->threadMutex);
+    size_t bytesSaved = 0;
+
+    for (FrameArenaObj::Thread* thread = mObj->threadList; thread; thread = thread->next)
+        bytesSaved += thread->bytesSaved.load(std::memory_order_relaxed);
+
+    return bytesSaved;
+}
+
 } // namespace LD
@@ -1,10 +1,19 @@
+#include "SlabHeap.h"
 #include <Ludens/Header/Assert.h>
 #include <Ludens/Memory/Memory.h>
 
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
 #include <cstring>
 #include <mutex>
 #include <new>
+#include <vector>
+
+// Bytes of unflushed accounting a thread may hold per usage before
+// publishing to the shared counters. Larger allocations flush immediately.
+#define MEMORY_THREAD_FLUSH_THRESHOLD (64 * 1024)
 
 namespace LD {
 
@@ -12,6 +21,59 @@ struct MemoryHeader
 {
     std::size_t size;
     MemoryUsage usage;
+    uint16_t backend;   // HeapBackend that allocated the block, may differ from the current one
+    uint16_t isTracked; // block starts with a MemoryTrack record before this header
+};
+
+static_assert(sizeof(MemoryHeader) == 16, "heap blocks must stay 16-byte aligned");
+
+/// @brief Call site record of a tracked block, linked into the list of live tracked blocks.
+struct alignas(16) MemoryTrack
+{
+    MemoryTrack* prev;
+    MemoryTrack* next;
+    const char* file;
+    uint32_t line;
+    uint64_t timestamp;
+};
+
+/// @brief Prints the largest live tracked allocations at exit if tracking is enabled by environment.
+struct MemoryTrackReport
+{
+    int topN = 0;
+
+    MemoryTrackReport();
+    ~MemoryTrackReport();
+};
+
+/// @brief Shared counters of a usage, each on its own cache line.
+struct alignas(64) MemoryCounter
+{
+    std::atomic<int64_t> current; // flushed bytes
+    std::atomic<int64_t> peak;    // highest flushed bytes
+};
+
+enum ThreadCountersState
+{
+    THREAD_COUNTERS_UNREGISTERED = 0,
+    THREAD_COUNTERS_REGISTERED,
+    THREAD_COUNTERS_EXITED,
+};
+
+/// @brief Per thread accounting not yet flushed to the shared counters. Only the owner thread
+///        writes the deltas, get_memory_profile() reads them to aggregate lazily.
+struct ThreadCounters
+{
+    std::atomic<int64_t> delta[MEMORY_USAGE_ENUM_LAST];
+    ThreadCounters* prev;
+    ThreadCounters* next;
+    ThreadCountersState state;
+};
+
+/// @brief Flushes and unregisters thread counters on thread exit.
+struct ThreadCountersGuard
+{
+    ~ThreadCountersGuard();
 };
 
 // clang-format off
@@ -19,7 +81,6 @@ struct
 {
     MemoryProfile profile;
     const char* cstr;
-    std::mutex mutex;
 } sTable[]{
     { { MEMORY_USAGE_MISC,},       "MEMORY_USAGE_MISC", },
     { { MEMORY_USAGE_MEDIA,},      "MEMORY_USAGE_MEDIA", },
@@ -41,38 +102,208 @@ struct
 
 static_assert(sizeof(sTable) / sizeof(*sTable) == MEMORY_USAGE_ENUM_LAST);
 
-void* heap_malloc(std::size_t size, MemoryUsage usage)
+static std::atomic<HeapBackend> sHeapBackend{HEAP_BACKEND_SYSTEM};
+static std::atomic<bool> sHeapTracking;
+static std::mutex sTrackMutex;  // guards the tracked block list
+static MemoryTrack* sTrackList; // live tracked blocks
+static MemoryTrackReport sTrackReport;
+static MemoryCounter sCounters[MEMORY_USAGE_ENUM_LAST];
+static std::mutex sThreadMutex;           // guards the thread list and profile snapshots
+static ThreadCounters* sThreadList;       // threads with registered counters
+static thread_local ThreadCounters sThreadCounters;
+static thread_local ThreadCountersGuard sThreadCountersGuard;
+
+static void update_peak(MemoryCounter& counter, int64_t current)
 {
-    MemoryHeader* header = (MemoryHeader*)std::malloc(sizeof(MemoryHeader) + size);
-    LD_ASSERT(header);
+    int64_t peak = counter.peak.load(std::memory_order_relaxed);
 
-    header->size = size;
-    header->usage = usage;
+    while (current > peak && !counter.peak.compare_exchange_weak(peak, current, std::memory_order_relaxed))
+        ;
+}
+
+static void flush_counter(MemoryUsage usage, int64_t delta)
+{
+    MemoryCounter& counter = sCounters[usage];
+    int64_t current = counter.current.fetch_add(delta, std::memory_order_relaxed) + delta;
+
+    if (delta > 0)
+        update_peak(counter, current);
+}
+
+static void register_thread_counters()
+{
+    ThreadCounters& tc = sThreadCounters;
+    (void)&sThreadCountersGuard; // odr-use to schedule the guard destructor on thread exit
+
+    std::unique_lock<std::mutex> lock(sThreadMutex);
+
+    tc.prev = nullptr;
+    tc.next = sThreadList;
+    if (sThreadList)
+        sThreadList->prev = &tc;
+    sThreadList = &tc;
+    tc.state = THREAD_COUNTERS_REGISTERED;
+}
+
+ThreadCountersGuard::~ThreadCountersGuard()
+{
+    ThreadCounters& tc = sThreadCounters;
+
+    if (tc.state != THREAD_COUNTERS_REGISTERED)
+        return;
+
+    std::unique_lock<std::mutex> lock(sThreadMutex);
+
+    for (int i = 0; i < (int)MEMORY_USAGE_ENUM_LAST; i++)
+        flush_counter((MemoryUsage)i, tc.delta[i].exchange(0, std::memory_order_relaxed));
+
+    if (tc.prev)
+        tc.prev->next = tc.next;
+    else
+        sThreadList = tc.next;
+
+    if (tc.next)
+        tc.next->prev = tc.prev;
+
+    // allocations from later thread_local destructors go to the shared counters
+    tc.state = THREAD_COUNTERS_EXITED;
+}
+
+static inline void account(MemoryUsage usage, int64_t size)
+{
+    ThreadCounters& tc = sThreadCounters;
+
+    if (tc.state != THREAD_COUNTERS_REGISTERED)
+    {
+        if (tc.state == THREAD_COUNTERS_EXITED)
+        {
+            flush_counter(usage, size);
+            return;
+        }
+
+        register_thread_counters();
+    }
+
+    int64_t delta = tc.delta[usage].load(std::memory_order_relaxed) + size;
+
+    if (delta > MEMORY_THREAD_FLUSH_THRESHOLD || delta < -MEMORY_THREAD_FLUSH_THRESHOLD)
+    {
+        flush_counter(usage, delta);
+        delta = 0;
+    }
+
+    tc.delta[usage].store(delta, std::memory_order_relaxed);
+}
+
+void heap_set_backend(HeapBackend backend)
+{
+    sHeapBackend.store(backend, std::memory_order_relaxed);
+}
+
+HeapBackend heap_get_backend()
+{
+    return sHeapBackend.load(std::memory_order_relaxed);
+}
+
+void heap_trim()
+{
+    slab_heap_trim();
+}
+
+void heap_set_tracking(bool enable)
+{
+    sHeapTracking.store(enable, std::memory_order_relaxed);
+}
+
+bool heap_get_tracking()
+{
+    return sHeapTracking.load(std::memory_order_relaxed);
+}
+
+static void track_block(MemoryTrack* track, const std::source_location& site)
+{
+    track->file = site.file_name();
+    track->line = (uint32_t)site.line();
+    track->timestamp = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    track->prev = nullptr;
+
+    std::unique_lock<std::mutex> lock(sTrackMutex);
+
+    track->next = sTrackList;
+    if (sTrackList)
+        sTrackList->prev = track;
+    sTrackList = track;
+}
+
+static void untrack_block(MemoryTrack* track)
+{
+    std::unique_lock<std::mutex> lock(sTrackMutex);
+
+    if (track->prev)
+        track->prev->next = track->next;
+    else
+        sTrackList = track->next;
+
+    if (track->next)
+        track->next->prev = track->prev;
+}
+
+void* heap_malloc(std::size_t size, MemoryUsageSite usage)
+{
+    bool isTracked = sHeapTracking.load(std::memory_order_relaxed);
+    std::size_t blockSize = sizeof(MemoryHeader) + size + (isTracked ? sizeof(MemoryTrack) : 0);
+    void* block = nullptr;
+    HeapBackend backend = HEAP_BACKEND_SYSTEM;
 
+    if (blockSize <= SLAB_HEAP_MAX_BLOCK_SIZE && sHeapBackend.load(std::memory_order_relaxed) == HEAP_BACKEND_SLAB)
     {
-        std::unique_lock<std::mutex> lock(sTable[usage].mutex);
+        block = slab_heap_malloc(blockSize);
+        backend = block ? HEAP_BACKEND_SLAB : HEAP_BACKEND_SYSTEM;
+    }
+
+    if (!block)
+        block = std::malloc(blockSize);
+
+    LD_ASSERT(block);
+
+    MemoryHeader* header = (MemoryHeader*)block;
 
-        sTable[usage].profile.current += size;
-        sTable[usage].profile.peak = std::max(sTable[usage].profile.peak, sTable[usage].profile.current);
+    if (isTracked)
+    {
+        track_block((MemoryTrack*)block, usage.site);
+        header = (MemoryHeader*)((MemoryTrack*)block + 1);
     }
 
+    header->size = size;
+    header->usage = usage.usage;
+    header->backend = (uint16_t)backend;
+    header->isTracked = (uint16_t)isTracked;
+
+    account(usage.usage, (int64_t)size);
+
     return (void*)(header + 1);
 }
 
 void heap_free(void* ptr)
 {
     MemoryHeader* header = (MemoryHeader*)ptr - 1;
+    void* block = (void*)header;
 
-    {
-        std::unique_lock<std::mutex> lock(sTable[header->usage].mutex);
+    account(header->usage, -(int64_t)header->size);
 
-        sTable[header->usage].profile.current -= header->size;
+    if (header->isTracked)
+    {
+        block = (void*)((MemoryTrack*)header - 1);
+        untrack_block((MemoryTrack*)block);
     }
 
-    std::free((void*)header);
+    if (header->backend == HEAP_BACKEND_SLAB)
+        slab_heap_free(block);
+    else
+        std::free(block);
 }
 
-char* heap_strdup(const char* cstr, MemoryUsage usage)
+char* heap_strdup(const char* cstr, MemoryUsageSite usage)
 {
     size_t len = strlen(cstr);
     char* str = (char*)heap_malloc(len + 1, usage);
@@ -82,7 +313,7 @@ char* heap_strdup(const char* cstr, MemoryUsage usage)
     return str;
 }
 
-char* heap_strdup(const void* data, size_t len, MemoryUsage usage)
+char* heap_strdup(const void* data, size_t len, MemoryUsageSite usage)
 {
     char* str = (char*)heap_malloc(len + 1, usage);
     memcpy(str, data, len);
@@ -91,22 +322,47 @@ char* heap_strdup(const void* data, size_t len, MemoryUsage usage)
     return str;
 }
 
+/// @brief aggregate shared counters with unflushed thread deltas, caller locks sThreadMutex
+static const MemoryProfile& aggregate_profile(MemoryUsage usage)
+{
+    MemoryCounter& counter = sCounters[usage];
+    int64_t current = counter.current.load(std::memory_order_relaxed);
+
+    for (ThreadCounters* tc = sThreadList; tc; tc = tc->next)
+        current += tc->delta[usage].load(std::memory_order_relaxed);
+
+    // a snapshot taken while threads flush may be transiently off by one threshold
+    current = std::max<int64_t>(current, 0);
+    update_peak(counter, current);
+
+    MemoryProfile& profile = sTable[(int)usage].profile;
+    profile.current = (std::size_t)current;
+    profile.peak = (std::size_t)counter.peak.load(std::memory_order_relaxed);
+
+    return profile;
+}
+
 const MemoryProfile& get_memory_profile(MemoryUsage usage)
 {
-    return sTable[(int)usage].profile;
+    std::unique_lock<std::mutex> lock(sThreadMutex);
+
+    return aggregate_profile(usage);
 }
 
 int get_memory_leaks(MemoryProfile* leaks)
 {
+    std::unique_lock<std::mutex> lock(sThreadMutex);
     int count = 0;
 
     for (int i = 0; i < (int)MEMORY_USAGE_ENUM_LAST; i++)
     {
-        if (sTable[i].profile.current == 0)
+        const MemoryProfile& profile = aggregate_profile((MemoryUsage)i);
+
+        if (profile.current == 0)
             continue;
 
         if (leaks)
-            leaks[count] = sTable[i].profile;
+            leaks[count] = profile;
 
         count++;
     }
@@ -114,9 +370,72 @@ int get_memory_leaks(MemoryProfile* leaks)
     return count;
 }
 
+int get_memory_allocations(MemoryUsage usage, int maxCount, MemoryAllocation* allocs)
+{
+    if (maxCount <= 0)
+        return 0;
+
+    std::vector<MemoryAllocation> live;
+    {
+        std::unique_lock<std::mutex> lock(sTrackMutex);
+
+        for (MemoryTrack* track = sTrackList; track; track = track->next)
+        {
+            const MemoryHeader* header = (const MemoryHeader*)(track + 1);
+
+            if (header->usage == usage)
+                live.push_back({usage, header->size, track->file, track->line, track->timestamp});
+        }
+    }
+
+    int count = std::min(maxCount, (int)live.size());
+    std::partial_sort(live.begin(), live.begin() + count, live.end(), [](const MemoryAllocation& lhs, const MemoryAllocation& rhs) {
+        return lhs.size > rhs.size;
+    });
+    std::copy(live.begin(), live.begin() + count, allocs);
+
+    return count;
+}
+
 const char* get_memory_usage_cstr(MemoryUsage usage)
 {
     return sTable[(int)usage].cstr;
 }
 
+MemoryTrackReport::MemoryTrackReport()
+{
+    const char* env = std::getenv("LD_MEMORY_TRACKING");
+
+    if (!env)
+        return;
+
+    topN = std::atoi(env);
+    if (topN <= 0)
+        topN = 10;
+
+    heap_set_tracking(true);
+}
+
+MemoryTrackReport::~MemoryTrackReport()
+{
+    if (topN <= 0)
+        return;
+
+    std::vector<MemoryAllocation> allocs(topN);
+    uint64_t now = (uint64_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+
+    for (int i = 0; i < (int)MEMORY_USAGE_ENUM_LAST; i++)
+    {
+        int count = get_memory_allocations((MemoryUsage)i, topN, allocs.data());
+
+        if (count == 0)
+            continue;
+
+        printf("live allocations in usage %s:\n", get_memory_usage_cstr((MemoryUsage)i));
+
+        for (int j = 0; j < count; j++)
+            printf("  %zu bytes at %s:%u, allocated %.3f s ago\n", allocs[j].size, allocs[j].file, allocs[j].line, (now - allocs[j].timestamp) / 1e6);
+    }
+}
+
 } // namespace LD
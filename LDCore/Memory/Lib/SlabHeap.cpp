@@ -0,0 +1,295 @@
+#include "SlabHeap.h"
+#include <Ludens/Header/Assert.h>
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <new>
+
+// Slabs are aligned to their size so a block finds its slab by masking the address.
+#define SLAB_SIZE (64 * 1024)
+#define SLAB_CLASS_COUNT 32
+
+namespace LD {
+
+struct ThreadHeap;
+
+/// @brief Intrusive link of a free block.
+struct SlabBlock
+{
+    SlabBlock* next;
+};
+
+/// @brief Header at the start of each slab, blocks of a single size class follow.
+struct alignas(64) Slab
+{
+    ThreadHeap* owner;
+    Slab* next;         // next slab of the owner heap
+    uint32_t classIndex;
+    uint32_t liveCount; // blocks handed out and not yet returned to the owner free lists
+};
+
+/// @brief Size class slabs of a thread. Only the owner thread touches the free lists,
+///        other threads push freed blocks to the remote list. Heaps are never destroyed,
+///        the heap of an exited thread is retired and adopted by the next new thread.
+struct ThreadHeap
+{
+    Slab* slabList;
+    SlabBlock* freeList[SLAB_CLASS_COUNT];
+    char* carve[SLAB_CLASS_COUNT];    // next unsplit block of the newest slab
+    char* carveEnd[SLAB_CLASS_COUNT]; // end of the newest slab
+    ThreadHeap* nextRetired;
+    alignas(64) std::atomic<SlabBlock*> remoteFree;
+};
+
+enum ThreadHeapState
+{
+    THREAD_HEAP_NONE = 0,
+    THREAD_HEAP_ACTIVE,
+    THREAD_HEAP_EXITED,
+};
+
+/// @brief Releases empty slabs and retires the thread heap on thread exit.
+struct ThreadHeapGuard
+{
+    ~ThreadHeapGuard();
+};
+
+// 16-byte steps up to 256, then four classes per power of two up to 4096
+static constexpr uint32_t sClassSize[SLAB_CLASS_COUNT] = {
+    16, 32, 48, 64, 80, 96, 112, 128, 144, 160, 176, 192, 208, 224, 240, 256,
+    320, 384, 448, 512, 640, 768, 896, 1024, 1280, 1536, 1792, 2048, 2560, 3072, 3584, 4096};
+
+struct SlabClassTable
+{
+    uint8_t index[SLAB_HEAP_MAX_BLOCK_SIZE / 16 + 1];
+
+    constexpr SlabClassTable()
+        : index{}
+    {
+        uint32_t classIndex = 0;
+
+        for (uint32_t i = 0; i <= SLAB_HEAP_MAX_BLOCK_SIZE / 16; i++)
+        {
+            while (sClassSize[classIndex] < i * 16)
+                classIndex++;
+
+            index[i] = (uint8_t)classIndex;
+        }
+    }
+};
+
+static_assert(sClassSize[SLAB_CLASS_COUNT - 1] == SLAB_HEAP_MAX_BLOCK_SIZE);
+
+static constexpr SlabClassTable sClassTable;
+static std::mutex sRetiredMutex;
+static ThreadHeap* sRetiredList; // heaps of exited threads, awaiting adoption
+static thread_local ThreadHeap* sThreadHeap;
+static thread_local ThreadHeapState sThreadHeapState;
+static thread_local ThreadHeapGuard sThreadHeapGuard;
+
+static bool drain_remote_free(ThreadHeap* heap);
+static void trim_thread_heap(ThreadHeap* heap);
+
+static ThreadHeap* acquire_thread_heap()
+{
+    (void)&sThreadHeapGuard; // odr-use to schedule the guard destructor on thread exit
+
+    ThreadHeap* heap = nullptr;
+    {
+        std::unique_lock<std::mutex> lock(sRetiredMutex);
+
+        if (sRetiredList)
+        {
+            heap = sRetiredList;
+            sRetiredList = heap->nextRetired;
+        }
+    }
+
+    if (!heap)
+        heap = new ThreadHeap();
+
+    heap->nextRetired = nullptr;
+    sThreadHeap = heap;
+    sThreadHeapState = THREAD_HEAP_ACTIVE;
+
+    return heap;
+}
+
+ThreadHeapGuard::~ThreadHeapGuard()
+{
+    if (sThreadHeapState != THREAD_HEAP_ACTIVE)
+        return;
+
+    ThreadHeap* heap = sThreadHeap;
+    trim_thread_heap(heap);
+
+    // blocks still alive in the retired slabs are freed remotely until another thread adopts the heap
+    sThreadHeap = nullptr;
+    sThreadHeapState = THREAD_HEAP_EXITED;
+
+    std::unique_lock<std::mutex> lock(sRetiredMutex);
+    heap->nextRetired = sRetiredList;
+    sRetiredList = heap;
+}
+
+static inline Slab* get_slab(void* block)
+{
+    return (Slab*)((uintptr_t)block & ~(uintptr_t)(SLAB_SIZE - 1));
+}
+
+/// @brief Release slabs without live blocks of a heap, only the owner thread or the
+///        holder of the retired list lock may trim a heap.
+static void trim_thread_heap(ThreadHeap* heap)
+{
+    drain_remote_free(heap);
+
+    // unlink free blocks of empty slabs, they are released below
+    for (uint32_t classIndex = 0; classIndex < SLAB_CLASS_COUNT; classIndex++)
+    {
+        SlabBlock** link = &heap->freeList[classIndex];
+
+        while (*link)
+        {
+            if (get_slab(*link)->liveCount == 0)
+                *link = (*link)->next;
+            else
+                link = &(*link)->next;
+        }
+
+        // an exhausted carve may point past its slab, it is reset without looking up the slab
+        char* carve = heap->carve[classIndex];
+        if (carve == heap->carveEnd[classIndex] || get_slab(carve)->liveCount == 0)
+            heap->carve[classIndex] = heap->carveEnd[classIndex] = nullptr;
+    }
+
+    Slab** link = &heap->slabList;
+
+    while (*link)
+    {
+        Slab* slab = *link;
+
+        if (slab->liveCount == 0)
+        {
+            *link = slab->next;
+            ::operator delete((void*)slab, std::align_val_t(SLAB_SIZE));
+        }
+        else
+            link = &slab->next;
+    }
+}
+
+/// @brief move blocks freed by other threads back to the local free lists
+static bool drain_remote_free(ThreadHeap* heap)
+{
+    SlabBlock* block = heap->remoteFree.exchange(nullptr, std::memory_order_acquire);
+
+    if (!block)
+        return false;
+
+    while (block)
+    {
+        SlabBlock* next = block->next;
+        Slab* slab = get_slab(block);
+        slab->liveCount--;
+        block->next = heap->freeList[slab->classIndex];
+        heap->freeList[slab->classIndex] = block;
+        block = next;
+    }
+
+    return true;
+}
+
+static void allocate_slab(ThreadHeap* heap, uint32_t classIndex)
+{
+    Slab* slab = (Slab*)::operator new(SLAB_SIZE, std::align_val_t(SLAB_SIZE));
+    slab->owner = heap;
+    slab->next = heap->slabList;
+    slab->classIndex = classIndex;
+    slab->liveCount = 0;
+    heap->slabList = slab;
+
+    size_t blockSize = sClassSize[classIndex];
+    size_t blockCount = (SLAB_SIZE - sizeof(Slab)) / blockSize;
+
+    heap->carve[classIndex] = (char*)(slab + 1);
+    heap->carveEnd[classIndex] = heap->carve[classIndex] + blockCount * blockSize;
+}
+
+void* slab_heap_malloc(std::size_t size)
+{
+    LD_ASSERT(size <= SLAB_HEAP_MAX_BLOCK_SIZE);
+
+    ThreadHeap* heap = sThreadHeap;
+
+    if (!heap)
+    {
+        if (sThreadHeapState == THREAD_HEAP_EXITED)
+            return nullptr;
+
+        heap = acquire_thread_heap();
+    }
+
+    uint32_t classIndex = sClassTable.index[(size + 15) / 16];
+
+    SlabBlock* block = heap->freeList[classIndex];
+    if (block)
+    {
+        heap->freeList[classIndex] = block->next;
+        get_slab(block)->liveCount++;
+        return block;
+    }
+
+    if (heap->carve[classIndex] == heap->carveEnd[classIndex])
+    {
+        if (drain_remote_free(heap) && heap->freeList[classIndex])
+        {
+            block = heap->freeList[classIndex];
+            heap->freeList[classIndex] = block->next;
+            get_slab(block)->liveCount++;
+            return block;
+        }
+
+        allocate_slab(heap, classIndex);
+    }
+
+    void* carved = heap->carve[classIndex];
+    heap->carve[classIndex] += sClassSize[classIndex];
+    get_slab(carved)->liveCount++;
+
+    return carved;
+}
+
+void slab_heap_free(void* ptr)
+{
+    SlabBlock* block = (SlabBlock*)ptr;
+    ThreadHeap* owner = get_slab(ptr)->owner;
+
+    if (owner == sThreadHeap)
+    {
+        Slab* slab = get_slab(ptr);
+        slab->liveCount--;
+        block->next = owner->freeList[slab->classIndex];
+        owner->freeList[slab->classIndex] = block;
+        return;
+    }
+
+    block->next = owner->remoteFree.load(std::memory_order_relaxed);
+
+    while (!owner->remoteFree.compare_exchange_weak(block->next, block, std::memory_order_release, std::memory_order_relaxed))
+        ;
+}
+
+void slab_heap_trim()
+{
+    if (sThreadHeap)
+        trim_thread_heap(sThreadHeap);
+
+    // retired heaps have no owner thread, the lock keeps them from being adopted meanwhile
+    std::unique_lock<std::mutex> lock(sRetiredMutex);
+
+    for (ThreadHeap* heap = sRetiredList; heap; heap = heap->nextRetired)
+        trim_thread_heap(heap);
+}
+
+} // namespace LD
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LD {
+
+/// @brief Largest block served by slabs, including the memory header.
+#define SLAB_HEAP_MAX_BLOCK_SIZE 4096
+
+/// @brief Allocate a block from the size class slabs of the calling thread.
+///        Blocks are 16-byte aligned.
+/// @param size Block size in bytes, at most SLAB_HEAP_MAX_BLOCK_SIZE.
+/// @return Block address, or null if the calling thread has already exited
+///         and the caller should fall back to the system allocator.
+void* slab_heap_malloc(std::size_t size);
+
+/// @brief Free a block from slab_heap_malloc. Any thread may free the block,
+///        blocks freed by other threads are handed back to the owning thread heap.
+void slab_heap_free(void* block);
+
+/// @brief Return slabs without live blocks to the system, for the calling thread heap
+///        and the heaps of exited threads. Empty slabs of a thread are also released on thread exit.
+void slab_heap_trim();
+
+} // namespace LD
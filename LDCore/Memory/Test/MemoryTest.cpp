@@ -4,6 +4,12 @@
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/Memory/Allocator.h>
 
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
 using namespace LD;
 
 TEST_CASE("LinearAllocator single page")
@@ -181,6 +187,7 @@ void test_pool_allocator_iterator()
 
     CHECK(ctr == N);
     CHECK(set.empty());
+    CHECK(pa.block_count() == N);
 
     PoolAllocator::destroy(pa);
 }
@@ -195,4 +202,384 @@ TEST_CASE("PoolAllocator iterator")
 
     const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_MISC);
     CHECK(profile.current == 0);
-}
\ No newline at end of file
+}
+
+TEST_CASE("SizeClassAllocator")
+{
+    SizeClassAllocatorInfo scaI{};
+    scaI.usage = MEMORY_USAGE_MISC;
+    scaI.pageSize = 1024;
+    SizeClassAllocator sca = SizeClassAllocator::create(scaI);
+
+    CHECK(sca.page_count() == 0);
+
+    // freed blocks are recycled within the same size class
+    void* b0 = sca.allocate(20);
+    CHECK(sca.page_count() == 1);
+    CHECK((uintptr_t)b0 % 16 == 0);
+    sca.free(b0, 20);
+    CHECK(sca.allocate(32) == b0);
+    CHECK(sca.size() == 32);
+
+    // resizing within the size class keeps the block
+    CHECK(sca.reallocate(b0, 32, 17) == b0);
+    CHECK(sca.size() == 17);
+
+    // resizing across size classes preserves contents
+    memset(b0, 7, 17);
+    uint8_t* b1 = (uint8_t*)sca.reallocate(b0, 17, 100);
+    CHECK(b1 != b0);
+    CHECK(b1[0] == 7);
+    CHECK(b1[16] == 7);
+    CHECK(sca.size() == 100);
+
+    // blocks larger than any size class go to the general heap
+    uint8_t* large = (uint8_t*)sca.reallocate(b1, 100, SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+    CHECK(large[16] == 7);
+    CHECK(sca.size() == SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE + 1);
+    CHECK(sca.peak_size() == 100 + SIZE_CLASS_ALLOCATOR_MAX_BLOCK_SIZE + 1); // both blocks live during the copy
+
+    // pages are added as small blocks run out
+    for (int i = 0; i < 64; i++)
+        sca.allocate(64);
+    CHECK(sca.page_count() > 1);
+
+    // live blocks are released wholesale
+    SizeClassAllocator::destroy(sca);
+
+    const MemoryProfile& profile = get_memory_profile(MEMORY_USAGE_MISC);
+    CHECK(profile.current == 0);
+}
+
+TEST_CASE("heap_malloc multithreaded accounting")
+{
+    constexpr int threadCount = 4;
+    constexpr int allocCount = 1000;
+    constexpr size_t allocSize = 100;
+
+    const MemoryProfile& before = get_memory_profile(MEMORY_USAGE_NETWORK);
+    CHECK(before.current == 0);
+
+    std::atomic<int> allocated = 0;
+    std::atomic<bool> release = false;
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&]() {
+            std::vector<void*> ptrs(allocCount);
+
+            for (int i = 0; i < allocCount; i++)
+                ptrs[i] = heap_malloc(allocSize, MEMORY_USAGE_NETWORK);
+
+            allocated++;
+            while (!release)
+                std::this_thread::yield();
+
+            for (int i = 0; i < allocCount; i++)
+                heap_free(ptrs[i]);
+        });
+    }
+
+    while (allocated < threadCount)
+        std::this_thread::yield();
+
+    // every thread is holding its allocations, unflushed bytes are aggregated
+    const MemoryProfile& peak = get_memory_profile(MEMORY_USAGE_NETWORK);
+    CHECK(peak.current == threadCount * allocCount * allocSize);
+    CHECK(peak.peak == threadCount * allocCount * allocSize);
+
+    release = true;
+    for (std::thread& thread : threads)
+        thread.join();
+
+    // exited threads have flushed their counters
+    const MemoryProfile& after = get_memory_profile(MEMORY_USAGE_NETWORK);
+    CHECK(after.current == 0);
+    CHECK(after.peak == threadCount * allocCount * allocSize);
+}
+
+TEST_CASE("heap_malloc slab backend")
+{
+    constexpr int allocCount = 2000;
+
+    // allocation from the system backend, freed after switching
+    void* systemPtr = heap_malloc(64, MEMORY_USAGE_MEDIA);
+
+    heap_set_backend(HEAP_BACKEND_SLAB);
+    CHECK(heap_get_backend() == HEAP_BACKEND_SLAB);
+
+    std::vector<void*> ptrs(allocCount);
+    size_t totalSize = 0;
+
+    for (int i = 0; i < allocCount; i++)
+    {
+        size_t size = (size_t)(i * 7) % 5000; // spans every size class and the malloc fallback
+        ptrs[i] = heap_malloc(size, MEMORY_USAGE_MEDIA);
+        CHECK(((uintptr_t)ptrs[i] % 16) == 0);
+        memset(ptrs[i], i & 0xFF, size);
+        totalSize += size;
+    }
+
+    CHECK(get_memory_profile(MEMORY_USAGE_MEDIA).current == totalSize + 64);
+
+    for (int i = 0; i < allocCount; i++)
+    {
+        size_t size = (size_t)(i * 7) % 5000;
+        const uint8_t* bytes = (const uint8_t*)ptrs[i];
+        bool intact = true;
+
+        for (size_t j = 0; j < size; j++)
+            intact = intact && bytes[j] == (uint8_t)(i & 0xFF);
+
+        CHECK(intact);
+    }
+
+    for (int i = 0; i < allocCount; i++)
+        heap_free(ptrs[i]);
+
+    // worker allocations are freed on this thread after the worker exits,
+    // the next worker adopts the retired slabs and reuses the freed blocks
+    for (int round = 0; round < 2; round++)
+    {
+        std::thread worker([&]() {
+            for (int i = 0; i < allocCount; i++)
+                ptrs[i] = heap_malloc(48, MEMORY_USAGE_MEDIA);
+        });
+        worker.join();
+
+        CHECK(get_memory_profile(MEMORY_USAGE_MEDIA).current == allocCount * 48 + 64);
+
+        for (int i = 0; i < allocCount; i++)
+            heap_free(ptrs[i]);
+    }
+
+    heap_set_backend(HEAP_BACKEND_SYSTEM);
+    heap_free(systemPtr);
+
+    CHECK(get_memory_profile(MEMORY_USAGE_MEDIA).current == 0);
+}
+
+TEST_CASE("heap_trim")
+{
+    constexpr int allocCount = 4000;
+
+    heap_set_backend(HEAP_BACKEND_SLAB);
+
+    // spans several slabs of a size class, half of the blocks keep their slabs alive
+    std::vector<void*> ptrs(allocCount);
+    for (int i = 0; i < allocCount; i++)
+        ptrs[i] = heap_malloc(100, MEMORY_USAGE_MEDIA);
+
+    for (int i = 0; i < allocCount; i += 2)
+        heap_free(ptrs[i]);
+
+    heap_trim();
+
+    for (int i = 1; i < allocCount; i += 2)
+    {
+        memset(ptrs[i], 0xAB, 100);
+        heap_free(ptrs[i]);
+    }
+
+    heap_trim();
+
+    // the thread heap keeps serving blocks after every slab was released
+    for (int i = 0; i < allocCount; i++)
+    {
+        ptrs[i] = heap_malloc(100, MEMORY_USAGE_MEDIA);
+        memset(ptrs[i], i & 0xFF, 100);
+    }
+
+    // blocks of an exited thread are freed remotely, trimming releases the retired slabs
+    std::thread worker([&]() {
+        for (int i = 0; i < allocCount; i++)
+        {
+            heap_free(ptrs[i]);
+            ptrs[i] = heap_malloc(200, MEMORY_USAGE_MEDIA);
+        }
+    });
+    worker.join();
+
+    for (int i = 0; i < allocCount; i++)
+        heap_free(ptrs[i]);
+
+    heap_trim();
+    heap_set_backend(HEAP_BACKEND_SYSTEM);
+
+    CHECK(get_memory_profile(MEMORY_USAGE_MEDIA).current == 0);
+}
+
+TEST_CASE("heap_malloc call site tracking")
+{
+    // tracking may already be enabled by LD_MEMORY_TRACKING
+    bool wasTracking = heap_get_tracking();
+
+    heap_set_tracking(false);
+    void* untracked = heap_malloc(32, MEMORY_USAGE_AUDIO);
+
+    heap_set_tracking(true);
+    CHECK(heap_get_tracking());
+
+    uint32_t line = __LINE__ + 1;
+    void* small = heap_malloc(100, MEMORY_USAGE_AUDIO);
+    void* large = heap_malloc(10000, MEMORY_USAGE_AUDIO);
+    char* str = heap_strdup("tracked", MEMORY_USAGE_AUDIO);
+    int* value = heap_new<int>(MEMORY_USAGE_AUDIO, 7);
+
+    heap_set_tracking(false);
+
+    MemoryAllocation allocs[8];
+    int count = get_memory_allocations(MEMORY_USAGE_AUDIO, 8, allocs);
+    REQUIRE(count == 4);
+
+    // sorted by descending size, call sites are in this file
+    CHECK(allocs[0].size == 10000);
+    CHECK(allocs[0].line == line + 1);
+    CHECK(allocs[1].size == 100);
+    CHECK(allocs[1].line == line);
+    CHECK(allocs[2].size == 8);
+    CHECK(allocs[2].line == line + 2);
+    CHECK(allocs[3].size == sizeof(int));
+    CHECK(allocs[3].line == line + 3);
+    CHECK(strstr(allocs[3].file, "MemoryTest.cpp"));
+    CHECK(allocs[0].timestamp <= allocs[3].timestamp);
+
+    count = get_memory_allocations(MEMORY_USAGE_AUDIO, 2, allocs);
+    CHECK(count == 2);
+    CHECK(allocs[1].size == 100);
+
+    // tracked blocks are released after tracking is disabled
+    heap_free(large);
+    heap_free(str);
+    heap_delete(value);
+    count = get_memory_allocations(MEMORY_USAGE_AUDIO, 8, allocs);
+    CHECK(count == 1);
+
+    heap_free(small);
+    heap_free(untracked);
+    CHECK(get_memory_allocations(MEMORY_USAGE_AUDIO, 8, allocs) == 0);
+    CHECK(get_memory_profile(MEMORY_USAGE_AUDIO).current == 0);
+
+    heap_set_tracking(wasTracking);
+}
+
+TEST_CASE("allocator call site tracking")
+{
+    bool wasTracking = heap_get_tracking();
+    heap_set_tracking(true);
+
+    // pages are attributed to the allocator call that allocated them, not to Allocator.cpp
+    uint32_t line = __LINE__ + 1;
+    PoolAllocator pa = PoolAllocator::create({MEMORY_USAGE_AUDIO, 64, 4, true});
+    void* block = pa.allocate();
+
+    SizeClassAllocator sca = SizeClassAllocator::create({MEMORY_USAGE_AUDIO, 4096});
+    void* large = sca.allocate(1000);
+
+    heap_set_tracking(false);
+
+    MemoryAllocation allocs[8];
+    int count = get_memory_allocations(MEMORY_USAGE_AUDIO, 8, allocs);
+    REQUIRE(count == 4);
+
+    for (int i = 0; i < count; i++)
+        CHECK(strstr(allocs[i].file, "MemoryTest.cpp"));
+
+    std::vector<uint32_t> lines;
+    for (int i = 0; i < count; i++)
+        lines.push_back(allocs[i].line);
+    std::sort(lines.begin(), lines.end());
+
+    CHECK(lines == std::vector<uint32_t>{line, line + 1, line + 3, line + 4});
+
+    sca.free(large, 1000);
+    SizeClassAllocator::destroy(sca);
+    pa.free(block);
+    PoolAllocator::destroy(pa);
+
+    CHECK(get_memory_allocations(MEMORY_USAGE_AUDIO, 8, allocs) == 0);
+    heap_set_tracking(wasTracking);
+}
+
+TEST_CASE("FrameArena")
+{
+    // without an arena, frame containers use the general heap
+    CHECK_FALSE(FrameArena::get());
+    {
+        FrameVector<int> v(100, 1);
+        CHECK(get_memory_profile(MEMORY_USAGE_MISC).current == 100 * sizeof(int));
+    }
+
+    FrameArenaInfo info{};
+    info.usage = MEMORY_USAGE_MISC;
+    info.pageSize = 1024;
+    FrameArena arena = FrameArena::create(info);
+    CHECK(FrameArena::get());
+    CHECK(arena.frame_index() == 0);
+
+    void* p0 = arena.allocate(100);
+    void* p1 = arena.allocate(3, 64);
+    CHECK(((uintptr_t)p0 % alignof(std::max_align_t)) == 0);
+    CHECK(((uintptr_t)p1 % 64) == 0);
+    memset(p0, 0xAB, 100);
+
+    // the previous frame buffer stays intact during the next frame
+    arena.next_frame();
+    void* p2 = arena.allocate(100);
+    CHECK(p2 != p0);
+    CHECK(((const uint8_t*)p0)[99] == 0xAB);
+
+    // buffers are recycled two frames later without touching the heap
+    size_t heapBytes = get_memory_profile(MEMORY_USAGE_MISC).current;
+    arena.next_frame();
+    CHECK(arena.allocate(100) == p0);
+    CHECK(get_memory_profile(MEMORY_USAGE_MISC).current == heapBytes);
+
+    // oversized requests get a dedicated page
+    void* large = arena.allocate(4096);
+    CHECK(large);
+    memset(large, 0, 4096);
+
+    {
+        FrameVector<int> v;
+        for (int i = 0; i < 1000; i++)
+            v.push_back(i);
+        CHECK(v[999] == 999);
+    }
+
+    size_t saved = arena.bytes_saved();
+    CHECK(saved >= 100 * 3 + 3 + 4096 + 1000 * sizeof(int));
+
+    // each thread allocates from its own buffers
+    constexpr int threadCount = 4;
+    std::vector<std::thread> threads;
+    std::atomic<int> mismatches = 0;
+
+    for (int t = 0; t < threadCount; t++)
+    {
+        threads.emplace_back([&, t]() {
+            std::vector<uint8_t*> ptrs;
+
+            for (int i = 0; i < 200; i++)
+            {
+                uint8_t* ptr = (uint8_t*)arena.allocate(32);
+                memset(ptr, t, 32);
+                ptrs.push_back(ptr);
+            }
+
+            for (uint8_t* ptr : ptrs)
+                mismatches += (ptr[0] != t || ptr[31] != t);
+        });
+    }
+
+    for (std::thread& thread : threads)
+        thread.join();
+
+    CHECK(mismatches == 0);
+    CHECK(arena.bytes_saved() == saved + threadCount * 200 * 32);
+
+    FrameArena::destroy();
+    CHECK_FALSE(FrameArena::get());
+    CHECK(get_memory_profile(MEMORY_USAGE_MISC).current == 0);
+}
@@ -18,6 +18,7 @@ struct ProjectLoadAsyncObj
     FS::Path projectDir;
     FS::Path sceneSchemaAbsPath;
     ProjectContext* projectCtx = nullptr;
+    AssetLoadBatch assetBatch = {};
     ProjectLoadState status = PROJECT_LOAD_STATE_IDLE;
 };
 
@@ -72,6 +73,7 @@ bool ProjectLoadAsync::begin(const FS::Path& projectDir, String& err)
     AssetRegistry oldAssetRegistry = AM.swap_asset_registry(mObj->projectCtx->asset_registry(), mObj->projectDir);
     AM.begin_load_batch();
     AM.load_all_assets();
+    mObj->assetBatch = AM.submit_load_batch();
 
     if (oldAssetRegistry)
         AssetRegistry::destroy(oldAssetRegistry);
@@ -87,14 +89,17 @@ ProjectLoadState ProjectLoadAsync::update()
 
     if (mObj->status == PROJECT_LOAD_STATE_LOADING_ASSETS)
     {
-        if (!AM.has_load_job())
+        if (mObj->assetBatch.is_complete())
             mObj->status = PROJECT_LOAD_STATE_LOADING_SCENE;
     }
 
     if (mObj->status == PROJECT_LOAD_STATE_LOADING_SCENE)
     {
         Vector<AssetLoadStatus> errors;
-        if (!AM.end_load_batch(errors))
+        bool loadSuccess = AM.end_load_batch(mObj->assetBatch, errors);
+        mObj->assetBatch = {};
+
+        if (!loadSuccess)
         {
             sLog.warn("AssetManager failed to load some assets, {} errors", errors.size());
             for (const AssetLoadStatus& err : errors)
@@ -0,0 +1,192 @@
+#include <LDCore/RenderBackend/Lib/RShaderCache.h>
+#include <LDCore/RenderBackend/Lib/RShaderCompiler.h>
+#include <Ludens/System/FileSystem.h>
+#include <Ludens/System/Timer.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace LD;
+
+constexpr uint32_t SYNTHETIC_COUNT = 32;
+constexpr int ITERATIONS = 5;
+
+struct ShaderSource
+{
+    RShaderType type;
+    std::string glsl;
+};
+
+/// fragment shaders of roughly the size of a forward lighting shader, each one unique
+static void generate_sources(std::vector<ShaderSource>& sources)
+{
+    for (uint32_t i = 0; i < SYNTHETIC_COUNT; i++)
+    {
+        std::string glsl = R"(
+layout (location = 0) in vec3 vNormal;
+layout (location = 1) in vec2 vUV;
+layout (location = 0) out vec4 fColor;
+layout (set = 0, binding = 0) uniform Frame { mat4 viewProj; vec4 lightDir[8]; vec4 lightColor[8]; } uFrame;
+layout (set = 1, binding = 0) uniform sampler2D uAlbedo;
+layout (set = 1, binding = 1) uniform sampler2D uNormal;
+layout (push_constant) uniform PC { vec4 tint; uint lightCount; } uPC;
+void main()
+{
+    vec3 albedo = texture(uAlbedo, vUV).rgb * uPC.tint.rgb;
+    vec3 N = normalize(vNormal + texture(uNormal, vUV).xyz * 2.0 - 1.0);
+    vec3 color = vec3(0.0);
+    for (uint i = 0; i < uPC.lightCount; i++)
+    {
+        float NdotL = max(dot(N, -uFrame.lightDir[i].xyz), 0.0);
+        color += albedo * uFrame.lightColor[i].rgb * NdotL;
+    }
+)";
+        glsl += "    color = pow(color, vec3(1.0 / " + std::to_string(2.0 + i * 0.01) + "));\n";
+        glsl += "    fColor = vec4(color, 1.0);\n}\n";
+
+        sources.push_back({RSHADER_TYPE_FRAGMENT, std::move(glsl)});
+    }
+}
+
+static bool read_sources(const FS::Path& dir, std::vector<ShaderSource>& sources)
+{
+    for (const auto& entry : std::filesystem::directory_iterator(dir))
+    {
+        std::string ext = entry.path().extension().string();
+        RShaderType type;
+
+        if (ext == ".vert")
+            type = RSHADER_TYPE_VERTEX;
+        else if (ext == ".frag")
+            type = RSHADER_TYPE_FRAGMENT;
+        else if (ext == ".comp")
+            type = RSHADER_TYPE_COMPUTE;
+        else
+            continue;
+
+        String err;
+        Vector<byte> file;
+        if (!FS::read_file_to_vector(entry.path(), file, err))
+        {
+            printf("failed to read %s: %s\n", entry.path().string().c_str(), err.c_str());
+            return false;
+        }
+
+        sources.push_back({type, std::string((const char*)file.data(), file.size())});
+    }
+
+    return true;
+}
+
+/// what RDevice::create_shader does on a cold start, compile and populate the cache
+static float compile_sources(const std::vector<ShaderSource>& sources, RShaderCache* cache, uint64_t& checksum)
+{
+    size_t us;
+    checksum = 0;
+    {
+        ScopeTimer timer(&us);
+
+        for (const ShaderSource& source : sources)
+        {
+            RShaderCompiler compiler;
+            std::vector<uint32_t> spirv;
+            RShaderReflection reflection;
+
+            if (!compiler.compile_to_spirv(source.type, source.glsl.c_str(), spirv, &reflection))
+                continue;
+
+            if (cache)
+                cache->save(RShaderCache::get_key(source.type, source.glsl.c_str()), spirv, reflection);
+
+            checksum += spirv.size() + reflection.bindings.size();
+        }
+    }
+
+    return us / 1000.0f;
+}
+
+/// what RDevice::create_shader does on a warm start, every shader is a cache hit
+static float load_sources(const std::vector<ShaderSource>& sources, RShaderCache& cache, uint64_t& checksum)
+{
+    size_t us;
+    checksum = 0;
+    {
+        ScopeTimer timer(&us);
+
+        for (const ShaderSource& source : sources)
+        {
+            std::vector<uint32_t> spirv;
+            RShaderReflection reflection;
+
+            if (cache.load(RShaderCache::get_key(source.type, source.glsl.c_str()), spirv, reflection))
+                checksum += spirv.size() + reflection.bindings.size();
+        }
+    }
+
+    return us / 1000.0f;
+}
+
+static float median(std::vector<float> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+/// usage: LDShaderCacheBench [directory of .vert, .frag, or .comp Vulkan GLSL files]
+int main(int argc, char** argv)
+{
+    FS::Path root = FS::temp_directory_path() / "ld_shader_cache_bench";
+    std::vector<ShaderSource> sources;
+
+    std::filesystem::remove_all(root);
+
+    if (argc > 1)
+    {
+        if (!read_sources(argv[1], sources))
+            return 1;
+    }
+    else
+        generate_sources(sources);
+
+    RShaderCache cache;
+    if (!cache.set_directory(root))
+    {
+        printf("failed to create cache directory %s\n", root.string().c_str());
+        return 1;
+    }
+
+    // the first compilation also pays for one-time compiler initialization, as a real startup does
+    uint64_t compileChecksum, loadChecksum;
+    float firstCompile = compile_sources(sources, &cache, compileChecksum);
+
+    std::vector<float> compileSamples;
+    std::vector<float> loadSamples;
+
+    for (int i = 0; i < ITERATIONS; i++)
+    {
+        compileSamples.push_back(compile_sources(sources, nullptr, compileChecksum));
+        loadSamples.push_back(load_sources(sources, cache, loadChecksum));
+    }
+
+    uint64_t cacheSize = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(root))
+        cacheSize += entry.file_size();
+
+    RShaderCacheStats stats = cache.get_stats();
+    float compileTime = median(compileSamples);
+    float loadTime = median(loadSamples);
+
+    printf("%zu shaders, median of %d runs\n", sources.size(), ITERATIONS);
+    printf("first compile: %8.3f ms\n", firstCompile);
+    printf("compile      : %8.3f ms\n", compileTime);
+    printf("cache load   : %8.3f ms, %.2fx faster, %8.2f KB on disk\n", loadTime, compileTime / std::max(loadTime, 0.001f), cacheSize / 1024.0);
+    printf("cache stats  : %u hits, %u misses, %u rejected, %u writes\n", stats.hitCount, stats.missCount, stats.rejectCount, stats.writeCount);
+
+    if (compileChecksum != loadChecksum)
+        printf("checksum mismatch\n");
+
+    std::filesystem::remove_all(root);
+}
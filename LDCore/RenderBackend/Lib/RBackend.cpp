@@ -10,6 +10,7 @@
 
 #include <algorithm>
 #include <format>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 
@@ -27,6 +28,10 @@ static HashMap<Hash64, RSetLayoutObj*> sSetLayouts;
 static HashMap<Hash64, RPipelineLayoutObj*> sPipelineLayouts;
 static HashMap<Hash64, RFramebufferObj*> sFramebuffers;
 
+/// @brief Guards the lazily created objects above and graphics pipeline variants,
+///        command lists may be recorded on multiple threads.
+static std::recursive_mutex sLazyObjMutex;
+
 static std::string print_shader_binding(const RShaderBinding& shaderBinding);
 static std::string print_set_bindings(uint32_t setIndex, uint32_t bindingCount, const RSetBindingInfo* bindings);
 static std::string print_shader_reflection(const RShaderReflection& reflection);
@@ -351,6 +356,10 @@ RDevice RDevice::create(const RDeviceInfo& info)
 
     obj->id = get_ruid();
     obj->frameIndex = 0;
+    obj->cacheStats = {};
+
+    if (info.cacheDirectory && !obj->shaderCache.set_directory(info.cacheDirectory))
+        sLog.warn("RDevice failed to use cache directory {}", info.cacheDirectory);
 
     if (info.backend == RDEVICE_BACKEND_VULKAN)
     {
@@ -419,6 +428,14 @@ void RDevice::destroy(RDevice device)
     sLog.info("RDevice destroyed {} framebuffers", (int)sFramebuffers.size());
     sFramebuffers.clear();
 
+    if (obj->shaderCache.has_directory())
+    {
+        RDeviceCacheStats stats = device.get_cache_stats();
+        sLog.info("RDevice shader cache {} hits, {} misses, {} rejected, pipeline cache {} hits, {} misses",
+                  stats.shaderHitCount, stats.shaderMissCount, stats.shaderRejectCount,
+                  stats.pipelineHitCount, stats.pipelineMissCount);
+    }
+
     if (obj->backend == RDEVICE_BACKEND_VULKAN)
     {
         vk_destroy_device(obj);
@@ -559,6 +576,58 @@ void RDevice::destroy_image(RImage image)
     heap_free(obj);
 }
 
+RMemoryRequirements RDevice::get_image_memory_requirements(const RImageInfo& imageI)
+{
+    LD_PROFILE_SCOPE;
+
+    return mObj->api->get_image_memory_requirements(mObj, imageI);
+}
+
+RMemory RDevice::create_memory(const RMemoryRequirements& req)
+{
+    LD_PROFILE_SCOPE;
+
+    size_t objSize = mObj->api->get_obj_size(RTYPE_MEMORY);
+    RMemoryObj* memoryObj = (RMemoryObj*)heap_malloc(objSize, MEMORY_USAGE_RENDER);
+    mObj->api->memory_ctor(memoryObj);
+
+    memoryObj->id = get_ruid();
+    memoryObj->req = req;
+    memoryObj->device = *this;
+
+    return mObj->api->create_memory(mObj, req, memoryObj);
+}
+
+void RDevice::destroy_memory(RMemory memory)
+{
+    LD_PROFILE_SCOPE;
+
+    mObj->api->destroy_memory(mObj, memory);
+
+    RMemoryObj* obj = memory.unwrap();
+    mObj->api->memory_dtor(obj);
+    heap_free(obj);
+}
+
+RImage RDevice::create_placed_image(const RImageInfo& imageI, RMemory memory, uint64_t offset)
+{
+    LD_PROFILE_SCOPE;
+
+    LD_ASSERT(!(imageI.type == RIMAGE_TYPE_2D && imageI.layers != 1));
+    LD_ASSERT(!(imageI.type == RIMAGE_TYPE_CUBE && imageI.layers != 6));
+    LD_ASSERT(memory && offset < memory.size());
+
+    size_t objSize = mObj->api->get_obj_size(RTYPE_IMAGE);
+    RImageObj* imageObj = (RImageObj*)heap_malloc(objSize, MEMORY_USAGE_RENDER);
+    mObj->api->image_ctor(imageObj);
+
+    imageObj->id = get_ruid();
+    imageObj->info = imageI;
+    imageObj->device = *this;
+
+    return mObj->api->create_placed_image(mObj, imageI, memory, offset, imageObj);
+}
+
 RCommandPool RDevice::create_command_pool(const RCommandPoolInfo& poolI)
 {
     LD_PROFILE_SCOPE;
@@ -606,8 +675,18 @@ RShader RDevice::create_shader(const RShaderInfo& shaderI)
 
     // NOTE: Compiling to SPIRV is common across backends, OpenGL backend
     //       will later descompile the SPIRV back to OpenGL-compatible GLSL.
-    RShaderCompiler compiler;
-    bool success = compiler.compile_to_spirv(shaderI.type, shaderI.glsl, shaderObj->spirv, &shaderObj->reflection);
+    RShaderCache& cache = mObj->shaderCache;
+    Hash64 cacheKey = RShaderCache::get_key(shaderI.type, shaderI.glsl);
+    bool success = cache.load(cacheKey, shaderObj->spirv, shaderObj->reflection);
+
+    if (!success)
+    {
+        RShaderCompiler compiler;
+        success = compiler.compile_to_spirv(shaderI.type, shaderI.glsl, shaderObj->spirv, &shaderObj->reflection);
+
+        if (success)
+            cache.save(cacheKey, shaderObj->spirv, shaderObj->reflection);
+    }
 
     if (!success)
     {
@@ -790,6 +869,24 @@ uint32_t RDevice::get_frames_in_flight_count()
     return mObj->api->get_frames_in_flight_count(mObj);
 }
 
+RDeviceBackend RDevice::get_backend()
+{
+    return mObj->backend;
+}
+
+RDeviceCacheStats RDevice::get_cache_stats()
+{
+    RShaderCacheStats shaderStats = mObj->shaderCache.get_stats();
+
+    RDeviceCacheStats stats = mObj->cacheStats;
+    stats.shaderHitCount = shaderStats.hitCount;
+    stats.shaderMissCount = shaderStats.missCount;
+    stats.shaderRejectCount = shaderStats.rejectCount;
+    stats.shaderWriteCount = shaderStats.writeCount;
+
+    return stats;
+}
+
 uint32_t RDevice::get_frame_index()
 {
     return mObj->frameIndex;
@@ -848,6 +945,11 @@ uint64_t RImage::size() const
     return mObj->info.layers * layerSize * texelSize;
 }
 
+uint64_t RMemory::size() const
+{
+    return mObj->req.size;
+}
+
 uint64_t RBuffer::size() const
 {
     return mObj->info.size;
@@ -893,6 +995,7 @@ void RBuffer::unmap()
 
 void RPipeline::set_color_write_mask(uint32_t index, RColorComponentFlags mask)
 {
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     RDeviceObj* deviceObj = mObj->deviceObj;
 
     deviceObj->api->pipeline_variant_color_write_mask(deviceObj, mObj, index, mask);
@@ -900,6 +1003,7 @@ void RPipeline::set_color_write_mask(uint32_t index, RColorComponentFlags mask)
 
 void RPipeline::set_depth_test_enable(bool enable)
 {
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     RDeviceObj* deviceObj = mObj->deviceObj;
 
     deviceObj->api->pipeline_variant_depth_test_enable(deviceObj, mObj, enable);
@@ -983,6 +1087,10 @@ void RCommandList::cmd_bind_graphics_pipeline(RPipeline pipeline)
 
     RPipelineObj* pipelineObj = pipeline.unwrap();
 
+    // the variant is pipeline state shared by all command lists,
+    // selected and bound without interleaving with other threads.
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
+
     // get or create graphics pipeline variant
     mObj->deviceObj->api->pipeline_variant_pass(mObj->deviceObj, pipelineObj, passI);
     pipelineObj->api->create_variant(pipelineObj);
@@ -1226,6 +1334,25 @@ void RCommandList::cmd_image_memory_barrier(RPipelineStageFlags srcStages, RPipe
         mObj->api->cmd_image_memory_barrier(mObj, srcStages, dstStages, barrier);
 }
 
+void RCommandList::cmd_image_memory_barriers(RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, uint32_t barrierCount, const RImageMemoryBarrier* barriers)
+{
+    if (barrierCount == 0)
+        return;
+
+    if (mObj->captureLA)
+    {
+        for (uint32_t i = 0; i < barrierCount; i++)
+        {
+            auto* cmd = (RCommandImageMemoryBarrier*)mObj->captureLA.allocate(sizeof(RCommandImageMemoryBarrier));
+            new (cmd) RCommandImageMemoryBarrier(srcStages, dstStages, barriers[i]);
+            mObj->captures.push_back((const RCommandType*)cmd);
+        }
+    }
+
+    if (mObj->api)
+        mObj->api->cmd_image_memory_barriers(mObj, srcStages, dstStages, barrierCount, barriers);
+}
+
 void RCommandList::cmd_copy_buffer(RBuffer srcBuffer, RBuffer dstBuffer, uint32_t regionCount, const RBufferCopy* regions)
 {
     LD_ASSERT(srcBuffer.usage() & RBUFFER_USAGE_TRANSFER_SRC_BIT);
@@ -1490,6 +1617,7 @@ void RSetPool::reset()
 
 RPassObj* RDeviceObj::get_or_create_pass_obj(const RPassInfo& passI)
 {
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     Hash64 passHash = hash64_pass_info(passI);
 
     if (!sPasses.contains(passHash))
@@ -1512,6 +1640,7 @@ RPassObj* RDeviceObj::get_or_create_pass_obj(const RPassInfo& passI)
 
 RSetLayoutObj* RDeviceObj::get_or_create_set_layout_obj(const RSetLayoutInfo& layoutI)
 {
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     Hash64 layoutHash = hash64_set_layout_info(layoutI);
 
     if (!sSetLayouts.contains(layoutHash))
@@ -1537,6 +1666,7 @@ RPipelineLayoutObj* RDeviceObj::get_or_create_pipeline_layout_obj(const RPipelin
 {
     LD_ASSERT(layoutI.setLayoutCount <= PIPELINE_LAYOUT_MAX_RESOURCE_SETS);
 
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     Hash64 layoutHash = hash64_pipeline_layout_info(layoutI);
 
     if (!sPipelineLayouts.contains(layoutHash))
@@ -1559,6 +1689,7 @@ RPipelineLayoutObj* RDeviceObj::get_or_create_pipeline_layout_obj(const RPipelin
 
 RFramebufferObj* RDeviceObj::get_or_create_framebuffer_obj(const RFramebufferInfo& framebufferI)
 {
+    std::lock_guard<std::recursive_mutex> lock(sLazyObjMutex);
     Hash64 framebufferHash = hash64_framebuffer_info(framebufferI);
 
     if (!sFramebuffers.contains(framebufferHash))
@@ -235,6 +235,13 @@ static void gl_device_image_dtor(RImageObj* baseObj);
 static RImage gl_device_create_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RImageObj* baseObj);
 static void gl_device_destroy_image(RDeviceObj* baseSelf, RImage image);
 
+static void gl_device_memory_ctor(RMemoryObj* baseObj);
+static void gl_device_memory_dtor(RMemoryObj* baseObj);
+static RMemory gl_device_create_memory(RDeviceObj* baseSelf, const RMemoryRequirements& req, RMemoryObj* baseObj);
+static void gl_device_destroy_memory(RDeviceObj* baseSelf, RMemory memory);
+static RMemoryRequirements gl_device_get_image_memory_requirements(RDeviceObj* baseSelf, const RImageInfo& imageI);
+static RImage gl_device_create_placed_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RMemory memory, uint64_t offset, RImageObj* baseObj);
+
 static void gl_device_pass_ctor(RPassObj* baseObj);
 static void gl_device_pass_dtor(RPassObj* baseObj);
 static void gl_device_create_pass(RDeviceObj* baseSelf, const RPassInfo& passI, RPassObj* baseObj);
@@ -305,6 +312,12 @@ static constexpr RDeviceAPI sRDeviceGLAPI = {
     .image_dtor = &gl_device_image_dtor,
     .create_image = &gl_device_create_image,
     .destroy_image = &gl_device_destroy_image,
+    .memory_ctor = &gl_device_memory_ctor,
+    .memory_dtor = &gl_device_memory_dtor,
+    .create_memory = &gl_device_create_memory,
+    .destroy_memory = &gl_device_destroy_memory,
+    .get_image_memory_requirements = &gl_device_get_image_memory_requirements,
+    .create_placed_image = &gl_device_create_placed_image,
     .pass_ctor = &gl_device_pass_ctor,
     .pass_dtor = &gl_device_pass_dtor,
     .create_pass = &gl_device_create_pass,
@@ -448,6 +461,7 @@ struct RTypeGL
     { RTYPE_COMMAND_LIST,    sizeof(RCommandListGLObj) },
     { RTYPE_COMMAND_POOL,    sizeof(RCommandPoolGLObj) },
     { RTYPE_QUEUE,           sizeof(RQueueGLObj) },
+    { RTYPE_MEMORY,          sizeof(RMemoryObj) },
 };
 // clang-format on
 
@@ -772,6 +786,52 @@ static void gl_device_destroy_image(RDeviceObj* baseSelf, RImage image)
     glDeleteTextures(1, &obj->gl.handle);
 }
 
+static void gl_device_memory_ctor(RMemoryObj* baseObj)
+{
+    new (baseObj) RMemoryObj();
+}
+
+static void gl_device_memory_dtor(RMemoryObj* baseObj)
+{
+    baseObj->~RMemoryObj();
+}
+
+static RMemory gl_device_create_memory(RDeviceObj* baseSelf, const RMemoryRequirements& req, RMemoryObj* baseObj)
+{
+    (void)baseSelf;
+    (void)req;
+
+    // OpenGL has no explicit memory, placed images fall back to dedicated textures
+    return RMemory(baseObj);
+}
+
+static void gl_device_destroy_memory(RDeviceObj* baseSelf, RMemory memory)
+{
+    (void)baseSelf;
+    (void)memory;
+}
+
+static RMemoryRequirements gl_device_get_image_memory_requirements(RDeviceObj* baseSelf, const RImageInfo& imageI)
+{
+    (void)baseSelf;
+
+    uint64_t texelSize = (uint64_t)RUtil::get_format_texel_size(imageI.format);
+
+    return {
+        .size = texelSize * imageI.width * imageI.height * imageI.depth * imageI.layers,
+        .alignment = 1,
+        .typeBits = ~0u,
+    };
+}
+
+static RImage gl_device_create_placed_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RMemory memory, uint64_t offset, RImageObj* baseObj)
+{
+    (void)memory;
+    (void)offset;
+
+    return gl_device_create_image(baseSelf, imageI, baseObj);
+}
+
 static void gl_device_pass_ctor(RPassObj* baseObj)
 {
     auto* obj = (RPassGLObj*)baseObj;
@@ -10,6 +10,7 @@
 
 #include "RCommand.h"
 #include "RData.h"
+#include "RShaderCache.h"
 #include "RShaderCompiler.h"
 
 // RBackendObj.h
@@ -45,6 +46,7 @@ enum RType
     RTYPE_COMMAND_LIST,
     RTYPE_COMMAND_POOL,
     RTYPE_QUEUE,
+    RTYPE_MEMORY,
     RTYPE_ENUM_COUNT,
 };
 
@@ -75,6 +77,14 @@ struct RImageObj
     HashSet<Hash64> fboHashes;
 };
 
+/// @brief Base device memory object.
+struct RMemoryObj
+{
+    RUID id;
+    RDevice device;
+    RMemoryRequirements req;
+};
+
 /// @brief Base render pass object.
 struct RPassObj
 {
@@ -135,6 +145,7 @@ struct RCommandListAPI
     void (*cmd_end_pass)(RCommandListObj* self);
     void (*cmd_buffer_memory_barrier)(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RBufferMemoryBarrier& barrier);
     void (*cmd_image_memory_barrier)(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RImageMemoryBarrier& barrier);
+    void (*cmd_image_memory_barriers)(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, uint32_t barrierCount, const RImageMemoryBarrier* barriers);
     void (*cmd_copy_buffer)(RCommandListObj* self, RBuffer srcBuffer, RBuffer dstBuffer, uint32_t regionCount, const RBufferCopy* regions);
     void (*cmd_copy_buffer_to_image)(RCommandListObj* self, RBuffer srcBuffer, RImage dstImage, RImageLayout dstImageLayout, uint32_t regionCount, const RBufferImageCopy* regions);
     void (*cmd_copy_image_to_buffer)(RCommandListObj* self, RImage srcImage, RImageLayout srcImageLayout, RBuffer dstBuffer, uint32_t regionCount, const RBufferImageCopy* regions);
@@ -294,6 +305,13 @@ struct RDeviceAPI
     RImage (*create_image)(RDeviceObj* self, const RImageInfo& imageI, RImageObj* imageObj);
     void (*destroy_image)(RDeviceObj* self, RImage image);
 
+    void (*memory_ctor)(RMemoryObj* memoryObj);
+    void (*memory_dtor)(RMemoryObj* memoryObj);
+    RMemory (*create_memory)(RDeviceObj* self, const RMemoryRequirements& req, RMemoryObj* memoryObj);
+    void (*destroy_memory)(RDeviceObj* self, RMemory memory);
+    RMemoryRequirements (*get_image_memory_requirements)(RDeviceObj* self, const RImageInfo& imageI);
+    RImage (*create_placed_image)(RDeviceObj* self, const RImageInfo& imageI, RMemory memory, uint64_t offset, RImageObj* imageObj);
+
     void (*pass_ctor)(RPassObj* passObj);
     void (*pass_dtor)(RPassObj* passObj);
     void (*create_pass)(RDeviceObj* self, const RPassInfo& passI, RPassObj* passObj);
@@ -367,6 +385,8 @@ struct RDeviceObj
     uint32_t frameIndex;
     RDeviceBackend backend;
     RDeviceLimits limits;
+    RShaderCache shaderCache;     /// persistent SPIR-V cache, disabled without a cache directory
+    RDeviceCacheStats cacheStats; /// pipeline cache counters of the backend, shader counters are kept by shaderCache
 
     RPassObj* get_or_create_pass_obj(const RPassInfo& passI);
     RSetLayoutObj* get_or_create_set_layout_obj(const RSetLayoutInfo& layoutI);
@@ -50,6 +50,7 @@
 // clang-format on
 
 #define FRAMES_IN_FLIGHT 2
+#define LD_PIPELINE_CACHE_FILE_NAME "pipeline_cache.bin"
 
 namespace LD {
 
@@ -245,6 +246,13 @@ static void vk_device_image_dtor(RImageObj* baseObj);
 static RImage vk_device_create_image(RDeviceObj* self, const RImageInfo& imageI, RImageObj* obj);
 static void vk_device_destroy_image(RDeviceObj* self, RImage image);
 
+static void vk_device_memory_ctor(RMemoryObj* baseObj);
+static void vk_device_memory_dtor(RMemoryObj* baseObj);
+static RMemory vk_device_create_memory(RDeviceObj* self, const RMemoryRequirements& req, RMemoryObj* obj);
+static void vk_device_destroy_memory(RDeviceObj* self, RMemory memory);
+static RMemoryRequirements vk_device_get_image_memory_requirements(RDeviceObj* self, const RImageInfo& imageI);
+static RImage vk_device_create_placed_image(RDeviceObj* self, const RImageInfo& imageI, RMemory memory, uint64_t offset, RImageObj* obj);
+
 static void vk_device_pass_ctor(RPassObj* baseObj);
 static void vk_device_pass_dtor(RPassObj* baseObj);
 static void vk_device_create_pass(RDeviceObj* self, const RPassInfo& passI, RPassObj* obj);
@@ -325,6 +333,12 @@ static constexpr RDeviceAPI sRDeviceVKAPI = {
     .image_dtor = &vk_device_image_dtor,
     .create_image = &vk_device_create_image,
     .destroy_image = &vk_device_destroy_image,
+    .memory_ctor = &vk_device_memory_ctor,
+    .memory_dtor = &vk_device_memory_dtor,
+    .create_memory = &vk_device_create_memory,
+    .destroy_memory = &vk_device_destroy_memory,
+    .get_image_memory_requirements = &vk_device_get_image_memory_requirements,
+    .create_placed_image = &vk_device_create_placed_image,
     .pass_ctor = &vk_device_pass_ctor,
     .pass_dtor = &vk_device_pass_dtor,
     .create_pass = &vk_device_create_pass,
@@ -404,6 +418,7 @@ struct RDeviceVKObj : RDeviceObj
         HashMap<WindowID, WindowSurface*> windowCache;
         HashSet<WindowSurface*> acquiredSurfaces;
         RFenceVKObj frameCompleteObj[FRAMES_IN_FLIGHT];
+        VkPipelineCache pipelineCache;
     } vk;
 
     VkSampler get_or_create_sampler(const RSamplerInfo& samplerI)
@@ -484,6 +499,15 @@ struct RImageVKObj : RImageObj
     } vk;
 };
 
+/// @brief Vulkan device memory object.
+struct RMemoryVKObj : RMemoryObj
+{
+    struct VK
+    {
+        VmaAllocation vma;
+    } vk;
+};
+
 /// @brief Vulkan render pass object.
 struct RPassVKObj : RPassObj
 {
@@ -523,6 +547,7 @@ static void vk_command_list_cmd_draw_indexed_indirect(RCommandListObj* self, con
 static void vk_command_list_cmd_end_pass(RCommandListObj* self);
 static void vk_command_list_cmd_buffer_memory_barrier(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RBufferMemoryBarrier& barrier);
 static void vk_command_list_cmd_image_memory_barrier(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RImageMemoryBarrier& barrier);
+static void vk_command_list_cmd_image_memory_barriers(RCommandListObj* self, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, uint32_t barrierCount, const RImageMemoryBarrier* barriers);
 static void vk_command_list_cmd_copy_buffer(RCommandListObj* self, RBuffer srcBuffer, RBuffer dstBuffer, uint32_t regionCount, const RBufferCopy* regions);
 static void vk_command_list_cmd_copy_buffer_to_image(RCommandListObj* self, RBuffer srcBuffer, RImage dstImage, RImageLayout dstImageLayout, uint32_t regionCount, const RBufferImageCopy* regions);
 static void vk_command_list_cmd_copy_image_to_buffer(RCommandListObj* self, RImage srcImage, RImageLayout srcImageLayout, RBuffer dstBuffer, uint32_t regionCount, const RBufferImageCopy* regions);
@@ -550,6 +575,7 @@ static const RCommandListAPI sRCommandListVKAPI = {
     .cmd_end_pass = &vk_command_list_cmd_end_pass,
     .cmd_buffer_memory_barrier = &vk_command_list_cmd_buffer_memory_barrier,
     .cmd_image_memory_barrier = &vk_command_list_cmd_image_memory_barrier,
+    .cmd_image_memory_barriers = &vk_command_list_cmd_image_memory_barriers,
     .cmd_copy_buffer = &vk_command_list_cmd_copy_buffer,
     .cmd_copy_buffer_to_image = &vk_command_list_cmd_copy_buffer_to_image,
     .cmd_copy_image_to_buffer = &vk_command_list_cmd_copy_image_to_buffer,
@@ -719,6 +745,7 @@ struct RTypeVK
     { RTYPE_COMMAND_LIST,    sizeof(RCommandListVKObj)},
     { RTYPE_COMMAND_POOL,    sizeof(RCommandPoolVKObj)},
     { RTYPE_QUEUE,           sizeof(RQueueVKObj)},
+    { RTYPE_MEMORY,          sizeof(RMemoryVKObj)},
 };
 // clang-format on
 
@@ -744,6 +771,93 @@ size_t vk_device_byte_size()
     return sizeof(RDeviceVKObj);
 }
 
+/// @brief Check that pipeline cache data was written for the same physical device and driver,
+///        the driver is expected to reject mismatching data but not all drivers do.
+static bool is_pipeline_cache_compatible(const PhysicalDevice& pdevice, const Vector<byte>& data)
+{
+    VkPipelineCacheHeaderVersionOne header;
+    if (data.size() < sizeof(header))
+        return false;
+
+    memcpy(&header, data.data(), sizeof(header));
+
+    return header.headerSize >= sizeof(header) && header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+           header.vendorID == pdevice.deviceProps.vendorID && header.deviceID == pdevice.deviceProps.deviceID &&
+           !memcmp(header.pipelineCacheUUID, pdevice.deviceProps.pipelineCacheUUID, VK_UUID_SIZE);
+}
+
+/// @brief Create the pipeline cache, seeded from the cache directory if it contains data from a previous run.
+static void create_pipeline_cache(RDeviceVKObj* self)
+{
+    LD_PROFILE_SCOPE;
+
+    Vector<byte> data;
+
+    if (self->shaderCache.has_directory())
+    {
+        FS::Path path = self->shaderCache.get_directory() / FS::Path(LD_PIPELINE_CACHE_FILE_NAME);
+        String err;
+
+        if (!FS::exists(path) || !FS::read_file_to_vector(path, data, err))
+            data.clear();
+        else if (!is_pipeline_cache_compatible(self->vk.pdevice, data))
+        {
+            sLog.info("discarding incompatible pipeline cache {}", path.string());
+            data.clear();
+        }
+    }
+
+    VkPipelineCacheCreateInfo cacheCI{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO,
+        .initialDataSize = data.size(),
+        .pInitialData = data.empty() ? nullptr : data.data(),
+    };
+    VK_CHECK(vkCreatePipelineCache(self->vk.device, &cacheCI, nullptr, &self->vk.pipelineCache));
+
+    self->cacheStats.pipelineCacheLoadSize = (uint64_t)data.size();
+}
+
+/// @brief Write pipeline cache data to the cache directory and destroy the pipeline cache.
+static void destroy_pipeline_cache(RDeviceVKObj* self)
+{
+    LD_PROFILE_SCOPE;
+
+    size_t size = 0;
+
+    if (self->shaderCache.has_directory() && vkGetPipelineCacheData(self->vk.device, self->vk.pipelineCache, &size, nullptr) == VK_SUCCESS && size > 0)
+    {
+        Vector<byte> data(size);
+        FS::Path path = self->shaderCache.get_directory() / FS::Path(LD_PIPELINE_CACHE_FILE_NAME);
+        FS::Path tmpPath = FS::get_unique_tmp_path(path);
+        String err;
+
+        // write to a temporary file first, the next run never loads partial data
+        if (vkGetPipelineCacheData(self->vk.device, self->vk.pipelineCache, &size, data.data()) != VK_SUCCESS ||
+            !FS::write_file(tmpPath, View(data.data(), size), err))
+            sLog.warn("failed to save pipeline cache {}", path.string());
+        else if (!FS::rename(tmpPath, path, err))
+        {
+            sLog.warn("failed to save pipeline cache {}: {}", path.string(), err);
+            FS::remove(tmpPath, err);
+        }
+    }
+
+    vkDestroyPipelineCache(self->vk.device, self->vk.pipelineCache, nullptr);
+    self->vk.pipelineCache = VK_NULL_HANDLE;
+}
+
+/// @brief Count pipeline cache hits, drivers are not required to provide creation feedback.
+static void record_pipeline_creation_feedback(RDeviceVKObj* self, const VkPipelineCreationFeedback& feedback)
+{
+    if (!(feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_VALID_BIT))
+        return;
+
+    if (feedback.flags & VK_PIPELINE_CREATION_FEEDBACK_APPLICATION_PIPELINE_CACHE_HIT_BIT)
+        self->cacheStats.pipelineHitCount++;
+    else
+        self->cacheStats.pipelineMissCount++;
+}
+
 void vk_device_ctor(RDeviceObj* baseObj)
 {
     auto* obj = (RDeviceVKObj*)baseObj;
@@ -980,6 +1094,8 @@ void vk_create_device(RDeviceObj* baseSelf, const RDeviceInfo& deviceI)
     // delegate memory management to VMA
     create_vma_allocator(self);
 
+    create_pipeline_cache(self);
+
     if (rootSurface && rootSurface->handle)
     {
         rootSurface->create_swapchain(self);
@@ -1034,6 +1150,8 @@ void vk_destroy_device(RDeviceObj* baseSelf)
     // all VMA allocations should be freed by now
     destroy_vma_allocator(self);
 
+    destroy_pipeline_cache(self);
+
     if (self->vk.queuePresent)
         destroy_queue(self->vk.queuePresent);
 
@@ -1202,29 +1320,22 @@ static void vk_device_image_dtor(RImageObj* baseObj)
     obj->~RImageVKObj();
 }
 
-static RImage vk_device_create_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RImageObj* baseObj)
+static VkImageCreateInfo vk_make_image_create_info(const RImageInfo& imageI)
 {
-    auto* self = (RDeviceVKObj*)baseSelf;
-    auto* obj = (RImageVKObj*)baseObj;
-
     VkFormat vkFormat;
     VkImageType vkType;
-    VkImageViewType vkViewType;
     VkImageUsageFlags vkUsage;
-    VkImageAspectFlags vkAspect;
     VkSampleCountFlagBits vkSamples;
     RUtil::cast_format_vk(imageI.format, vkFormat);
     RUtil::cast_image_type_vk(imageI.type, vkType);
-    RUtil::cast_image_view_type_vk(imageI.type, vkViewType);
     RUtil::cast_image_usage_vk(imageI.usage, vkUsage);
-    RUtil::cast_format_image_aspect_vk(imageI.format, vkAspect);
     RUtil::cast_sample_count_vk(imageI.samples, vkSamples);
 
     VkImageCreateFlags imageFlags = 0;
     if (imageI.type == RIMAGE_TYPE_CUBE)
         imageFlags |= VK_IMAGE_CREATE_CUBE_COMPATIBLE_BIT;
 
-    VkImageCreateInfo imageCI{
+    return VkImageCreateInfo{
         .sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
         .flags = imageFlags,
         .imageType = vkType,
@@ -1239,12 +1350,15 @@ static RImage vk_device_create_image(RDeviceObj* baseSelf, const RImageInfo& ima
         .queueFamilyIndexCount = 0,
         .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED,
     };
+}
 
-    VmaAllocationCreateInfo allocationCI{
-        .usage = VMA_MEMORY_USAGE_AUTO,
-    };
-
-    VK_CHECK(vmaCreateImage(self->vk.vma, &imageCI, &allocationCI, &obj->vk.handle, &obj->vk.vma, nullptr));
+/// @brief create image view and sampler after the image handle is bound to memory
+static void vk_create_image_view(RDeviceVKObj* self, const RImageInfo& imageI, const VkImageCreateInfo& imageCI, RImageVKObj* obj)
+{
+    VkImageViewType vkViewType;
+    VkImageAspectFlags vkAspect;
+    RUtil::cast_image_view_type_vk(imageI.type, vkViewType);
+    RUtil::cast_format_image_aspect_vk(imageI.format, vkAspect);
 
     VkImageSubresourceRange viewRange{
         .aspectMask = vkAspect,
@@ -1258,16 +1372,32 @@ static RImage vk_device_create_image(RDeviceObj* baseSelf, const RImageInfo& ima
         .sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO,
         .image = obj->vk.handle,
         .viewType = vkViewType,
-        .format = vkFormat,
+        .format = imageCI.format,
         .subresourceRange = viewRange,
     };
 
     VK_CHECK(vkCreateImageView(self->vk.device, &viewCI, nullptr, &obj->vk.viewHandle));
 
-    if (vkUsage & VK_IMAGE_USAGE_SAMPLED_BIT)
+    if (imageCI.usage & VK_IMAGE_USAGE_SAMPLED_BIT)
         obj->vk.samplerHandle = self->get_or_create_sampler(imageI.sampler);
     else
         obj->vk.samplerHandle = VK_NULL_HANDLE;
+}
+
+static RImage vk_device_create_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RImageObj* baseObj)
+{
+    auto* self = (RDeviceVKObj*)baseSelf;
+    auto* obj = (RImageVKObj*)baseObj;
+
+    VkImageCreateInfo imageCI = vk_make_image_create_info(imageI);
+
+    VmaAllocationCreateInfo allocationCI{
+        .usage = VMA_MEMORY_USAGE_AUTO,
+    };
+
+    VK_CHECK(vmaCreateImage(self->vk.vma, &imageCI, &allocationCI, &obj->vk.handle, &obj->vk.vma, nullptr));
+
+    vk_create_image_view(self, imageI, imageCI, obj);
 
     return {obj};
 }
@@ -1278,7 +1408,91 @@ static void vk_device_destroy_image(RDeviceObj* baseSelf, RImage image)
     auto* obj = (RImageVKObj*)image.unwrap();
 
     vkDestroyImageView(self->vk.device, obj->vk.viewHandle, nullptr);
-    vmaDestroyImage(self->vk.vma, obj->vk.handle, obj->vk.vma);
+
+    // placed images do not own their memory
+    if (obj->vk.vma)
+        vmaDestroyImage(self->vk.vma, obj->vk.handle, obj->vk.vma);
+    else
+        vkDestroyImage(self->vk.device, obj->vk.handle, nullptr);
+}
+
+static void vk_device_memory_ctor(RMemoryObj* baseObj)
+{
+    auto* obj = (RMemoryVKObj*)baseObj;
+
+    new (obj) RMemoryVKObj();
+}
+
+static void vk_device_memory_dtor(RMemoryObj* baseObj)
+{
+    auto* obj = (RMemoryVKObj*)baseObj;
+
+    obj->~RMemoryVKObj();
+}
+
+static RMemory vk_device_create_memory(RDeviceObj* baseSelf, const RMemoryRequirements& req, RMemoryObj* baseObj)
+{
+    auto* self = (RDeviceVKObj*)baseSelf;
+    auto* obj = (RMemoryVKObj*)baseObj;
+
+    VkMemoryRequirements vkReq{
+        .size = req.size,
+        .alignment = req.alignment,
+        .memoryTypeBits = req.typeBits,
+    };
+
+    VmaAllocationCreateInfo allocationCI{
+        .requiredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+    };
+
+    VK_CHECK(vmaAllocateMemory(self->vk.vma, &vkReq, &allocationCI, &obj->vk.vma, nullptr));
+
+    return {obj};
+}
+
+static void vk_device_destroy_memory(RDeviceObj* baseSelf, RMemory memory)
+{
+    auto* self = (RDeviceVKObj*)baseSelf;
+    auto* obj = (RMemoryVKObj*)memory.unwrap();
+
+    vmaFreeMemory(self->vk.vma, obj->vk.vma);
+}
+
+static RMemoryRequirements vk_device_get_image_memory_requirements(RDeviceObj* baseSelf, const RImageInfo& imageI)
+{
+    auto* self = (RDeviceVKObj*)baseSelf;
+
+    VkImageCreateInfo imageCI = vk_make_image_create_info(imageI);
+
+    // a handle without memory is enough to query requirements
+    VkImage handle;
+    VK_CHECK(vkCreateImage(self->vk.device, &imageCI, nullptr, &handle));
+
+    VkMemoryRequirements vkReq;
+    vkGetImageMemoryRequirements(self->vk.device, handle, &vkReq);
+    vkDestroyImage(self->vk.device, handle, nullptr);
+
+    return {
+        .size = (uint64_t)vkReq.size,
+        .alignment = (uint64_t)vkReq.alignment,
+        .typeBits = vkReq.memoryTypeBits,
+    };
+}
+
+static RImage vk_device_create_placed_image(RDeviceObj* baseSelf, const RImageInfo& imageI, RMemory memory, uint64_t offset, RImageObj* baseObj)
+{
+    auto* self = (RDeviceVKObj*)baseSelf;
+    auto* obj = (RImageVKObj*)baseObj;
+    auto* memoryObj = (RMemoryVKObj*)memory.unwrap();
+
+    VkImageCreateInfo imageCI = vk_make_image_create_info(imageI);
+
+    VK_CHECK(vmaCreateAliasingImage2(self->vk.vma, memoryObj->vk.vma, (VkDeviceSize)offset, &imageCI, &obj->vk.handle));
+    obj->vk.vma = VK_NULL_HANDLE;
+
+    vk_create_image_view(self, imageI, imageCI, obj);
+
+    return {obj};
 }
 
 static void vk_device_pass_ctor(RPassObj* baseObj)
@@ -1874,14 +2088,24 @@ static RPipeline vk_device_create_compute_pipeline(RDeviceObj* baseSelf, const R
         .pSpecializationInfo = nullptr,
     };
 
+    VkPipelineCreationFeedback feedback{};
+    VkPipelineCreationFeedbackCreateInfo feedbackCI{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+        .pPipelineCreationFeedback = &feedback,
+        .pipelineStageCreationFeedbackCount = 0,
+        .pPipelineStageCreationFeedbacks = nullptr,
+    };
+
     VkComputePipelineCreateInfo pipelineCI{
         .sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+        .pNext = &feedbackCI,
         .stage = stage,
         .layout = layoutObj->vk.handle,
     };
 
     VkPipeline vkHandle;
-    VK_CHECK(vkCreateComputePipelines(self->vk.device, VK_NULL_HANDLE, 1, &pipelineCI, nullptr, &vkHandle));
+    VK_CHECK(vkCreateComputePipelines(self->vk.device, self->vk.pipelineCache, 1, &pipelineCI, nullptr, &vkHandle));
+    record_pipeline_creation_feedback(self, feedback);
 
     // compute pipelines currently have no variant properties
     pipelineObj->vk.handles[0] = vkHandle;
@@ -2560,46 +2784,58 @@ static void vk_command_list_cmd_buffer_memory_barrier(RCommandListObj* baseSelf,
 }
 
 static void vk_command_list_cmd_image_memory_barrier(RCommandListObj* baseSelf, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, const RImageMemoryBarrier& barrier)
+{
+    vk_command_list_cmd_image_memory_barriers(baseSelf, srcStages, dstStages, 1, &barrier);
+}
+
+static void vk_command_list_cmd_image_memory_barriers(RCommandListObj* baseSelf, RPipelineStageFlags srcStages, RPipelineStageFlags dstStages, uint32_t barrierCount, const RImageMemoryBarrier* barriers)
 {
     auto* self = (RCommandListVKObj*)baseSelf;
 
     VkPipelineStageFlags vkSrcStages;
     VkPipelineStageFlags vkDstStages;
-    VkImageLayout vkOldLayout;
-    VkImageLayout vkNewLayout;
-    VkAccessFlags vkSrcAccess;
-    VkAccessFlags vkDstAccess;
-    VkImageAspectFlags vkAspect;
-
     RUtil::cast_pipeline_stage_flags_vk(srcStages, vkSrcStages);
     RUtil::cast_pipeline_stage_flags_vk(dstStages, vkDstStages);
-    RUtil::cast_image_layout_vk(barrier.oldLayout, vkOldLayout);
-    RUtil::cast_image_layout_vk(barrier.newLayout, vkNewLayout);
-    RUtil::cast_access_flags_vk(barrier.srcAccess, vkSrcAccess);
-    RUtil::cast_access_flags_vk(barrier.dstAccess, vkDstAccess);
-    RUtil::cast_format_image_aspect_vk(barrier.image.format(), vkAspect);
 
-    VkImageSubresourceRange range{
-        .aspectMask = vkAspect,
-        .baseMipLevel = 0,
-        .levelCount = VK_REMAINING_MIP_LEVELS,
-        .baseArrayLayer = 0,
-        .layerCount = VK_REMAINING_ARRAY_LAYERS,
-    };
+    Vector<VkImageMemoryBarrier> vkBarriers(barrierCount);
+
+    for (uint32_t i = 0; i < barrierCount; i++)
+    {
+        const RImageMemoryBarrier& barrier = barriers[i];
+        VkImageLayout vkOldLayout;
+        VkImageLayout vkNewLayout;
+        VkAccessFlags vkSrcAccess;
+        VkAccessFlags vkDstAccess;
+        VkImageAspectFlags vkAspect;
+
+        RUtil::cast_image_layout_vk(barrier.oldLayout, vkOldLayout);
+        RUtil::cast_image_layout_vk(barrier.newLayout, vkNewLayout);
+        RUtil::cast_access_flags_vk(barrier.srcAccess, vkSrcAccess);
+        RUtil::cast_access_flags_vk(barrier.dstAccess, vkDstAccess);
+        RUtil::cast_format_image_aspect_vk(barrier.image.format(), vkAspect);
+
+        VkImageSubresourceRange range{
+            .aspectMask = vkAspect,
+            .baseMipLevel = 0,
+            .levelCount = VK_REMAINING_MIP_LEVELS,
+            .baseArrayLayer = 0,
+            .layerCount = VK_REMAINING_ARRAY_LAYERS,
+        };
 
-    VkImageMemoryBarrier vkBarrier{
-        .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
-        .srcAccessMask = vkSrcAccess,
-        .dstAccessMask = vkDstAccess,
-        .oldLayout = vkOldLayout,
-        .newLayout = vkNewLayout,
-        .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-        .image = static_cast<const RImageVKObj*>(barrier.image.unwrap())->vk.handle,
-        .subresourceRange = range,
-    };
+        vkBarriers[i] = {
+            .sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+            .srcAccessMask = vkSrcAccess,
+            .dstAccessMask = vkDstAccess,
+            .oldLayout = vkOldLayout,
+            .newLayout = vkNewLayout,
+            .srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+            .image = static_cast<const RImageVKObj*>(barrier.image.unwrap())->vk.handle,
+            .subresourceRange = range,
+        };
+    }
 
-    vkCmdPipelineBarrier(self->vk.handle, vkSrcStages, vkDstStages, 0, 0, nullptr, 0, nullptr, 1, &vkBarrier);
+    vkCmdPipelineBarrier(self->vk.handle, vkSrcStages, vkDstStages, 0, 0, nullptr, 0, nullptr, barrierCount, vkBarriers.data());
 }
 
 static void vk_command_list_cmd_copy_buffer(RCommandListObj* baseSelf, RBuffer srcBuffer, RBuffer dstBuffer, uint32_t regionCount, const RBufferCopy* regions)
@@ -2768,8 +3004,17 @@ static void vk_pipeline_create_variant(RPipelineObj* baseSelf)
         .pDynamicStates = dynamicStates.data(),
     };
 
+    VkPipelineCreationFeedback feedback{};
+    VkPipelineCreationFeedbackCreateInfo feedbackCI{
+        .sType = VK_STRUCTURE_TYPE_PIPELINE_CREATION_FEEDBACK_CREATE_INFO,
+        .pPipelineCreationFeedback = &feedback,
+        .pipelineStageCreationFeedbackCount = 0,
+        .pPipelineStageCreationFeedbacks = nullptr,
+    };
+
     VkGraphicsPipelineCreateInfo pipelineCI{
         .sType = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO,
+        .pNext = &feedbackCI,
         .stageCount = (uint32_t)self->vk.shaderStageCI.size(),
         .pStages = self->vk.shaderStageCI.data(),
         .pVertexInputState = &self->vk.vertexInputSCI,
@@ -2786,9 +3031,10 @@ static void vk_pipeline_create_variant(RPipelineObj* baseSelf)
     };
 
     VkPipeline vkHandle;
-    VkDevice vkDeviceHandle = static_cast<RDeviceVKObj*>(self->deviceObj)->vk.device;
+    auto* deviceObj = static_cast<RDeviceVKObj*>(self->deviceObj);
 
-    VK_CHECK(vkCreateGraphicsPipelines(vkDeviceHandle, VK_NULL_HANDLE, 1, &pipelineCI, nullptr, &vkHandle));
+    VK_CHECK(vkCreateGraphicsPipelines(deviceObj->vk.device, deviceObj->vk.pipelineCache, 1, &pipelineCI, nullptr, &vkHandle));
+    record_pipeline_creation_feedback(deviceObj, feedback);
 
     self->vk.variantHash = variantHash;
     self->vk.handles[variantHash] = vkHandle;
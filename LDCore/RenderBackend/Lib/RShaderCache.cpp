@@ -0,0 +1,295 @@
+#include <Ludens/Profiler/Profiler.h>
+#include <Ludens/Serial/Serial.h>
+
+#include <cstdio>
+#include <cstring>
+
+#include "RShaderCache.h"
+
+// RShaderCache.cpp
+// - entry file: "LDSC", u32 version, u64 key, u64 payload size, u64 payload checksum, payload
+// - payload: SPIR-V words followed by shader reflection, vectors are prefixed by a u32 count
+
+#define LD_SHADER_CACHE_MAGIC "LDSC"
+#define LD_SHADER_CACHE_HEADER_SIZE 32
+
+namespace LD {
+
+/// @brief Bounds checked reads of an entry payload, a cache file is untrusted input.
+struct RShaderCacheReader
+{
+    const byte* now;
+    const byte* end;
+
+    inline bool read_u32(uint32_t& u32)
+    {
+        if (end - now < 4)
+            return false;
+
+        le_bytes_to_u32(now, u32);
+        now += 4;
+        return true;
+    }
+
+    inline bool read_u64(uint64_t& u64)
+    {
+        if (end - now < 8)
+            return false;
+
+        le_bytes_to_u64(now, u64);
+        now += 8;
+        return true;
+    }
+
+    inline bool read_string(std::string& str)
+    {
+        uint32_t len;
+        if (!read_u32(len) || (uint64_t)(end - now) < len)
+            return false;
+
+        str.assign((const char*)now, len);
+        now += len;
+        return true;
+    }
+
+    inline bool read_words(std::vector<uint32_t>& words)
+    {
+        uint32_t count;
+        if (!read_u32(count) || (uint64_t)(end - now) / 4 < count)
+            return false;
+
+        words.resize(count);
+        memcpy(words.data(), now, (size_t)count * 4);
+        now += (size_t)count * 4;
+        return true;
+    }
+
+    /// @brief Read a vector count, each element takes at least minSize bytes.
+    inline bool read_count(uint32_t& count, size_t minSize)
+    {
+        return read_u32(count) && (uint64_t)(end - now) / minSize >= count;
+    }
+};
+
+static inline void write_string(Serializer& serial, const std::string& str)
+{
+    serial.write_u32((uint32_t)str.size());
+    serial.write((const byte*)str.data(), str.size());
+}
+
+static void write_locations(Serializer& serial, const std::vector<RShaderLocation>& locations)
+{
+    serial.write_u32((uint32_t)locations.size());
+
+    for (const RShaderLocation& loc : locations)
+    {
+        write_string(serial, loc.name);
+        serial.write_u32(loc.location);
+        serial.write_u32(loc.arraySize);
+        serial.write_u32((uint32_t)loc.glslType);
+    }
+}
+
+static bool read_locations(RShaderCacheReader& reader, std::vector<RShaderLocation>& locations)
+{
+    uint32_t count;
+    if (!reader.read_count(count, 16))
+        return false;
+
+    locations.resize(count);
+
+    for (RShaderLocation& loc : locations)
+    {
+        uint32_t glslType;
+        if (!reader.read_string(loc.name) || !reader.read_u32(loc.location) || !reader.read_u32(loc.arraySize) || !reader.read_u32(glslType))
+            return false;
+
+        loc.glslType = (GLSLType)glslType;
+    }
+
+    return true;
+}
+
+static void write_reflection(Serializer& serial, const RShaderReflection& reflection)
+{
+    write_locations(serial, reflection.inputs);
+    write_locations(serial, reflection.outputs);
+
+    serial.write_u32((uint32_t)reflection.bindings.size());
+    for (const RShaderBinding& binding : reflection.bindings)
+    {
+        write_string(serial, binding.name);
+        serial.write_u32(binding.setIndex);
+        serial.write_u32(binding.bindingIndex);
+        serial.write_u32(binding.arraySize);
+        serial.write_u32((uint32_t)binding.type);
+        serial.write_u32((uint32_t)binding.glslType);
+    }
+
+    serial.write_u32((uint32_t)reflection.pushConstants.size());
+    for (const RShaderPushConstant& pc : reflection.pushConstants)
+    {
+        serial.write_u32(pc.size);
+        serial.write_u32(pc.offset);
+        serial.write_u32(pc.uniformArraySize);
+        serial.write_u32((uint32_t)pc.uniformGLSLType);
+        write_string(serial, pc.uniformName);
+    }
+}
+
+static bool read_reflection(RShaderCacheReader& reader, RShaderReflection& reflection)
+{
+    if (!read_locations(reader, reflection.inputs) || !read_locations(reader, reflection.outputs))
+        return false;
+
+    uint32_t count;
+    if (!reader.read_count(count, 24))
+        return false;
+
+    reflection.bindings.resize(count);
+    for (RShaderBinding& binding : reflection.bindings)
+    {
+        uint32_t type, glslType;
+        if (!reader.read_string(binding.name) || !reader.read_u32(binding.setIndex) || !reader.read_u32(binding.bindingIndex) ||
+            !reader.read_u32(binding.arraySize) || !reader.read_u32(type) || !reader.read_u32(glslType))
+            return false;
+
+        binding.type = (RBindingType)type;
+        binding.glslType = (GLSLType)glslType;
+    }
+
+    if (!reader.read_count(count, 20))
+        return false;
+
+    reflection.pushConstants.resize(count);
+    for (RShaderPushConstant& pc : reflection.pushConstants)
+    {
+        uint32_t glslType;
+        if (!reader.read_u32(pc.size) || !reader.read_u32(pc.offset) || !reader.read_u32(pc.uniformArraySize) ||
+            !reader.read_u32(glslType) || !reader.read_string(pc.uniformName))
+            return false;
+
+        pc.uniformGLSLType = (GLSLType)glslType;
+    }
+
+    return true;
+}
+
+bool RShaderCache::set_directory(const FS::Path& directory)
+{
+    String err;
+    mDirectory.clear();
+
+    if (directory.empty() || !FS::create_directories(directory, err))
+        return false;
+
+    mDirectory = directory;
+    return true;
+}
+
+Hash64 RShaderCache::get_key(RShaderType type, const char* glsl)
+{
+    std::size_t hash = (std::size_t)hash64_FNV_1a(glsl, (int)strlen(glsl));
+
+    // invalidation by shader stage, source language version, and entry format
+    hash_combine(hash, (uint32_t)type);
+    hash_combine(hash, (uint32_t)LD_GLSL_VERSION);
+    hash_combine(hash, (uint32_t)LD_SHADER_CACHE_VERSION);
+
+    return Hash64((uint64_t)hash);
+}
+
+bool RShaderCache::load(Hash64 key, std::vector<uint32_t>& spirv, RShaderReflection& reflection)
+{
+    LD_PROFILE_SCOPE;
+
+    if (!has_directory())
+        return false;
+
+    FS::Path path = get_entry_path(key);
+    String err;
+    Vector<byte> file;
+
+    if (!FS::exists(path) || !FS::read_file_to_vector(path, file, err))
+    {
+        mStats.missCount++;
+        return false;
+    }
+
+    RShaderCacheReader reader{file.data(), file.data() + file.size()};
+    uint32_t version;
+    uint64_t entryKey, payloadSize, checksum;
+
+    bool isValid = file.size() >= LD_SHADER_CACHE_HEADER_SIZE && !memcmp(file.data(), LD_SHADER_CACHE_MAGIC, 4);
+    if (isValid)
+        reader.now += 4;
+
+    isValid = isValid && reader.read_u32(version) && version == LD_SHADER_CACHE_VERSION;
+    isValid = isValid && reader.read_u64(entryKey) && entryKey == (uint64_t)key;
+    isValid = isValid && reader.read_u64(payloadSize) && reader.read_u64(checksum);
+    isValid = isValid && payloadSize == (uint64_t)(reader.end - reader.now);
+    isValid = isValid && checksum == hash64_FNV_1a((const char*)reader.now, (int)payloadSize);
+
+    std::vector<uint32_t> entrySpirv;
+    RShaderReflection entryReflection;
+
+    if (!isValid || !reader.read_words(entrySpirv) || entrySpirv.empty() || !read_reflection(reader, entryReflection) || reader.now != reader.end)
+    {
+        mStats.rejectCount++;
+        return false;
+    }
+
+    spirv = std::move(entrySpirv);
+    reflection = std::move(entryReflection);
+    mStats.hitCount++;
+
+    return true;
+}
+
+bool RShaderCache::save(Hash64 key, const std::vector<uint32_t>& spirv, const RShaderReflection& reflection)
+{
+    LD_PROFILE_SCOPE;
+
+    if (!has_directory())
+        return false;
+
+    Serializer payload;
+    payload.write_u32((uint32_t)spirv.size());
+    payload.write((const byte*)spirv.data(), spirv.size() * 4);
+    write_reflection(payload, reflection);
+
+    Serializer serial;
+    serial.write((const byte*)LD_SHADER_CACHE_MAGIC, 4);
+    serial.write_u32(LD_SHADER_CACHE_VERSION);
+    serial.write_u64((uint64_t)key);
+    serial.write_u64((uint64_t)payload.size());
+    serial.write_u64(hash64_FNV_1a((const char*)payload.data(), (int)payload.size()));
+    serial.write(payload.data(), payload.size());
+
+    // write to a temporary file first, a concurrent load never sees a partial entry
+    FS::Path path = get_entry_path(key);
+    FS::Path tmpPath = FS::get_unique_tmp_path(path);
+
+    String err;
+    if (!FS::write_file(tmpPath, serial.view(), err))
+        return false;
+
+    if (!FS::rename(tmpPath, path, err))
+    {
+        FS::remove(tmpPath, err);
+        return false;
+    }
+
+    mStats.writeCount++;
+    return true;
+}
+
+FS::Path RShaderCache::get_entry_path(Hash64 key) const
+{
+    char name[32];
+    snprintf(name, sizeof(name), "%016llx.spv", (unsigned long long)(uint64_t)key);
+
+    return mDirectory / FS::Path(name);
+}
+
+} // namespace LD
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <Ludens/Header/Hash.h>
+#include <Ludens/RenderBackend/RBackend.h>
+#include <Ludens/System/FileSystem.h>
+
+#include <cstdint>
+#include <vector>
+
+#include "RShaderCompiler.h"
+
+/// @brief Version of the SPIR-V cache entry format, bump this whenever the shader compiler,
+///        its SPIR-V targets, or the reflection data changes so stale entries are recompiled.
+#define LD_SHADER_CACHE_VERSION 1
+
+namespace LD {
+
+/// @brief Counters of a shader cache since it was created.
+struct RShaderCacheStats
+{
+    uint32_t hitCount;    /// shaders loaded from disk
+    uint32_t missCount;   /// shaders without a cache entry
+    uint32_t rejectCount; /// cache entries discarded as truncated, corrupt, or of another version
+    uint32_t writeCount;  /// cache entries written to disk
+};
+
+/// @brief Persistent cache of compiled SPIR-V and reflection data, one file per shader
+///        in the cache directory, keyed by a hash of the shader type and GLSL source.
+///        The cache is disabled until a directory is set.
+class RShaderCache
+{
+public:
+    /// @brief Set the cache directory, creating it if necessary.
+    /// @return True if the directory can be used, the cache stays disabled otherwise.
+    bool set_directory(const FS::Path& directory);
+
+    inline bool has_directory() const { return !mDirectory.empty(); }
+
+    inline const FS::Path& get_directory() const { return mDirectory; }
+
+    /// @brief Get the cache key of a shader, any change to the source is a different key.
+    static Hash64 get_key(RShaderType type, const char* glsl);
+
+    /// @brief Load SPIR-V and reflection of a cache key.
+    /// @return True on cache hit, outputs are left untouched on miss.
+    bool load(Hash64 key, std::vector<uint32_t>& spirv, RShaderReflection& reflection);
+
+    /// @brief Write SPIR-V and reflection of a cache key to disk.
+    bool save(Hash64 key, const std::vector<uint32_t>& spirv, const RShaderReflection& reflection);
+
+    inline RShaderCacheStats get_stats() const { return mStats; }
+
+private:
+    FS::Path get_entry_path(Hash64 key) const;
+
+    FS::Path mDirectory;
+    RShaderCacheStats mStats{};
+};
+
+} // namespace LD
@@ -0,0 +1,167 @@
+#include <Extra/doctest/doctest.h>
+#include <LDCore/RenderBackend/Lib/RShaderCache.h>
+#include <Ludens/System/FileSystem.h>
+
+#include <filesystem>
+
+using namespace LD;
+
+static const char sVertexGLSL[] = R"(
+layout (location = 0) in vec3 aPos;
+layout (location = 0) out vec2 vUV;
+layout (set = 0, binding = 0) uniform Frame { mat4 viewProj; } uFrame;
+void main() { gl_Position = uFrame.viewProj * vec4(aPos, 1.0); }
+)";
+
+static FS::Path get_cache_directory()
+{
+    FS::Path dir = FS::temp_directory_path() / "ld_shader_cache_test";
+    std::filesystem::remove_all(dir);
+    return dir;
+}
+
+static void get_test_entry(std::vector<uint32_t>& spirv, RShaderReflection& reflection)
+{
+    spirv = {0x07230203, 0x00010000, 0x0008000b, 42, 0};
+    reflection.inputs = {{"aPos", 0, 1, GLSL_TYPE_VEC3}};
+    reflection.outputs = {{"vUV", 0, 1, GLSL_TYPE_VEC2}};
+    reflection.bindings = {{"uFrame", 0, 0, 1, RBINDING_TYPE_UNIFORM_BUFFER, GLSL_TYPE_STRUCT}};
+    reflection.pushConstants = {{64, 0, 1, GLSL_TYPE_MAT4, "uPC"}};
+}
+
+static FS::Path find_entry_file(const FS::Path& dir)
+{
+    for (const auto& entry : std::filesystem::directory_iterator(dir))
+    {
+        if (entry.path().extension() == ".spv")
+            return entry.path();
+    }
+
+    return {};
+}
+
+TEST_CASE("RShaderCache key")
+{
+    Hash64 key = RShaderCache::get_key(RSHADER_TYPE_VERTEX, sVertexGLSL);
+    CHECK(key == RShaderCache::get_key(RSHADER_TYPE_VERTEX, sVertexGLSL));
+    CHECK(key != RShaderCache::get_key(RSHADER_TYPE_FRAGMENT, sVertexGLSL));
+
+    std::string edited(sVertexGLSL);
+    edited[edited.find("1.0")] = '2';
+    CHECK(key != RShaderCache::get_key(RSHADER_TYPE_VERTEX, edited.c_str()));
+}
+
+TEST_CASE("RShaderCache roundtrip")
+{
+    FS::Path dir = get_cache_directory();
+    Hash64 key = RShaderCache::get_key(RSHADER_TYPE_VERTEX, sVertexGLSL);
+
+    std::vector<uint32_t> spirv;
+    RShaderReflection reflection;
+    get_test_entry(spirv, reflection);
+
+    {
+        RShaderCache cache;
+        REQUIRE(cache.set_directory(dir));
+
+        std::vector<uint32_t> loadedSpirv;
+        RShaderReflection loadedReflection;
+        CHECK(!cache.load(key, loadedSpirv, loadedReflection));
+        CHECK(cache.save(key, spirv, reflection));
+
+        RShaderCacheStats stats = cache.get_stats();
+        CHECK(stats.missCount == 1);
+        CHECK(stats.writeCount == 1);
+    }
+
+    // a new cache instance represents the next startup
+    RShaderCache cache;
+    REQUIRE(cache.set_directory(dir));
+
+    std::vector<uint32_t> loadedSpirv;
+    RShaderReflection loadedReflection;
+    REQUIRE(cache.load(key, loadedSpirv, loadedReflection));
+    CHECK(loadedSpirv == spirv);
+
+    REQUIRE(loadedReflection.inputs.size() == 1);
+    CHECK(loadedReflection.inputs[0].name == "aPos");
+    CHECK(loadedReflection.inputs[0].glslType == GLSL_TYPE_VEC3);
+    REQUIRE(loadedReflection.outputs.size() == 1);
+    CHECK(loadedReflection.outputs[0].name == "vUV");
+    REQUIRE(loadedReflection.bindings.size() == 1);
+    CHECK(loadedReflection.bindings[0].name == "uFrame");
+    CHECK(loadedReflection.bindings[0].type == RBINDING_TYPE_UNIFORM_BUFFER);
+    REQUIRE(loadedReflection.pushConstants.size() == 1);
+    CHECK(loadedReflection.pushConstants[0].size == 64);
+    CHECK(loadedReflection.pushConstants[0].uniformGLSLType == GLSL_TYPE_MAT4);
+    CHECK(loadedReflection.pushConstants[0].uniformName == "uPC");
+
+    RShaderCacheStats stats = cache.get_stats();
+    CHECK(stats.hitCount == 1);
+    CHECK(stats.missCount == 0);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("RShaderCache reject")
+{
+    FS::Path dir = get_cache_directory();
+    Hash64 key = RShaderCache::get_key(RSHADER_TYPE_VERTEX, sVertexGLSL);
+
+    std::vector<uint32_t> spirv;
+    RShaderReflection reflection;
+    get_test_entry(spirv, reflection);
+
+    RShaderCache cache;
+    REQUIRE(cache.set_directory(dir));
+    REQUIRE(cache.save(key, spirv, reflection));
+
+    FS::Path entryPath = find_entry_file(dir);
+    REQUIRE(!entryPath.empty());
+
+    String err;
+    Vector<byte> file;
+    REQUIRE(FS::read_file_to_vector(entryPath, file, err));
+
+    // corrupt payload byte
+    Vector<byte> corrupt(file);
+    corrupt.back() ^= 0xFF;
+    REQUIRE(FS::write_file(entryPath, View(corrupt.data(), corrupt.size()), err));
+
+    std::vector<uint32_t> loadedSpirv;
+    RShaderReflection loadedReflection;
+    CHECK(!cache.load(key, loadedSpirv, loadedReflection));
+    CHECK(loadedSpirv.empty());
+
+    // truncated entry
+    REQUIRE(FS::write_file(entryPath, View(file.data(), file.size() / 2), err));
+    CHECK(!cache.load(key, loadedSpirv, loadedReflection));
+
+    // entry of another key
+    REQUIRE(FS::write_file(entryPath, View(file.data(), file.size()), err));
+    std::filesystem::rename(entryPath, dir / "0000000000000001.spv");
+    CHECK(!cache.load(Hash64((uint64_t)1), loadedSpirv, loadedReflection));
+
+    RShaderCacheStats stats = cache.get_stats();
+    CHECK(stats.rejectCount == 3);
+    CHECK(stats.hitCount == 0);
+
+    std::filesystem::remove_all(dir);
+}
+
+TEST_CASE("RShaderCache disabled")
+{
+    std::vector<uint32_t> spirv;
+    RShaderReflection reflection;
+    get_test_entry(spirv, reflection);
+
+    RShaderCache cache;
+    CHECK(!cache.has_directory());
+    CHECK(!cache.set_directory({}));
+    CHECK(!cache.save(1, spirv, reflection));
+    CHECK(!cache.load(1, spirv, reflection));
+
+    RShaderCacheStats stats = cache.get_stats();
+    CHECK(stats.missCount == 0);
+    CHECK(stats.writeCount == 0);
+}
@@ -23,6 +23,12 @@ RGraphImageObj* RComponentObj::create_image(NodeType type, const char* nameStr,
     if (sampler)
         image->sampler = *sampler;
 
+    hash_combine(structureHash, (uint32_t)type);
+    hash_combine(structureHash, (uint32_t)imageName);
+    hash_combine(structureHash, (uint32_t)format);
+    hash_combine(structureHash, width);
+    hash_combine(structureHash, height);
+
     return image;
 }
 
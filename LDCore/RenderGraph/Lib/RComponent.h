@@ -63,8 +63,6 @@ struct RComponentPassObj
     Hash32 name;                                   /// hash of user declared name
     std::string debugName;                         /// name for debugging, globally unique
     RComponentObj* compObj;                        /// owning component
-    RPipelineStageFlags stageFlags;                /// compute pass stages
-    RAccessFlags accessFlags;                      /// compute pass access
     void* user;                                    /// arbitrary user data
     bool isCallbackScope;                          /// whether the component is within the RCommandList recording scope
     bool isComputePass;                            /// distinguishes between a GraphicsPass and ComputePass
@@ -76,7 +74,6 @@ struct RGraphicsPassObj : RComponentPassObj
 {
     uint32_t width;
     uint32_t height;
-    RPassDependency passDep;
     RGraphicsPassCallback callback;                             /// command recording callback for the graphics pass
     Vector<RGraphicsPassColorAttachment> colorAttachments;      /// graphics pass color attachment description
     Vector<RPassColorAttachment> colorAttachmentInfos;          /// consumed by the render backend API
@@ -110,6 +107,7 @@ struct RComponentObj
     HashMap<Hash32, RComponentPassObj*> passes; /// all passes declared in this component
     HashMap<Hash32, RGraphImageObj*> images;    /// all images declared in this component
     HashMap<Hash32, RGraphImageObj*> imageRefs; /// for input and IO images, reference the an image from some upstream component
+    std::size_t structureHash = 0;              /// hash of declared images, passes and image usages
 
     inline bool operator==(const RComponentObj& other) const { return name == other.name; }
     inline bool operator!=(const RComponentObj& other) const { return !operator==(other); }
@@ -3,6 +3,7 @@
 #include <Ludens/DSA/Stack.h>
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/Header/Assert.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Memory/Memory.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/RenderBackend/RUtil.h>
@@ -16,19 +17,23 @@
 #include <utility>
 
 #include "RComponent.h"
+#include "RGraphAlias.h"
+#include "RGraphBarrier.h"
+#include "RGraphCompiled.h"
 #include "RGraphObj.h"
 
 namespace LD {
 
 struct ImageState
 {
-    RImageLayout lastLayout;
+    RGraphImageSync sync; /// layout and last accesses, tracked across frames
     RImageUsageFlags usage;
     RImage handle;
     uint32_t width;
     uint32_t height;
     uint32_t depth;
     Hash32 hash;
+    bool isTransient; /// placed in memory shared with other transient images, contents do not survive the frame
 };
 
 /// @brief Physical resource storage for a component.
@@ -48,9 +53,34 @@ struct RComponentStorage
 ///        Component has its own storage.
 static HashMap<Hash32, RComponentStorage> sStorages;
 
+/// @brief Shared memory of transient images, replanned only when the set of transient images
+///        or their lifetimes change.
+struct RTransientStorage
+{
+    Hash32 planHash;
+    Vector<RMemory> heaps;
+    Vector<std::pair<Hash32, Hash32>> images; /// component name and image name of each placed image
+    RGraphMemoryReport report;
+};
+
+static RTransientStorage sTransient;
+
+static RGraphCompiled sCompiled;
+
 static Stack<std::pair<void*, RGraph::OnReleaseCallback>> sReleaseCallbacks;
 static Stack<std::pair<void*, RGraph::OnReleaseCallback>> sDestroyCallbacks;
 
+/// @brief fold a declared image usage into the structure hash of the pass component
+static inline void hash_image_usage(RComponentPassObj* pass, Hash32 imageName, RGraphImageUsage usage, uint32_t loadOp)
+{
+    std::size_t& hash = pass->compObj->structureHash;
+
+    hash_combine(hash, (uint32_t)pass->name);
+    hash_combine(hash, (uint32_t)imageName);
+    hash_combine(hash, (uint32_t)usage);
+    hash_combine(hash, loadOp);
+}
+
 /// @brief returns true if srcUsage and dstUsage might cause pipeline hazards, and needs a happens-before access separation.
 static bool has_image_dependency(RGraphImageUsage srcUsage, RGraphImageUsage dstUsage)
 {
@@ -60,18 +90,6 @@ static bool has_image_dependency(RGraphImageUsage srcUsage, RGraphImageUsage dst
            (srcUsage == RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT && dstUsage == RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT);    // WAW
 }
 
-static bool has_pass_dependency(RComponentPassObj* srcObj, RComponentPassObj* dstObj, RPassDependency& dep)
-{
-    // TODO:
-
-    dep.srcAccessMask = srcObj->accessFlags;
-    dep.dstAccessMask = dstObj->accessFlags;
-    dep.srcStageMask = srcObj->stageFlags;
-    dep.dstStageMask = dstObj->stageFlags;
-
-    return true;
-}
-
 static inline bool pass_image_first_use(RComponentPassObj* passObj, RGraphImageObj* image)
 {
     RComponentObj* comp = passObj->compObj;
@@ -156,6 +174,25 @@ static RImageUsageFlags get_native_image_usage(RGraphImageUsage renderGraphUsage
     return (RImageUsageFlags)0;
 }
 
+/// @brief get the layout an image is in while used by a pass
+static RImageLayout get_image_usage_layout(RGraphImageUsage usage)
+{
+    switch (usage)
+    {
+    case RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT:
+        return RIMAGE_LAYOUT_COLOR_ATTACHMENT;
+    case RGRAPH_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT:
+        return RIMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT;
+    case RGRAPH_IMAGE_USAGE_SAMPLED:
+        return RIMAGE_LAYOUT_SHADER_READ_ONLY;
+    case RGRAPH_IMAGE_USAGE_STORAGE_READ_ONLY:
+        return RIMAGE_LAYOUT_GENERAL;
+    }
+
+    LD_UNREACHABLE;
+    return RIMAGE_LAYOUT_UNDEFINED;
+}
+
 /// @brief hash of an image based on physical dimensions and declared name
 static Hash32 get_image_hash(const RImageInfo& imageI, Hash32 name)
 {
@@ -171,13 +208,9 @@ static Hash32 get_image_hash(const RImageInfo& imageI, Hash32 name)
     return (Hash32)hash;
 }
 
-/// @brief get or create a single sampled image
-static RImage get_or_create_image(RDevice device, RComponentObj* compObj, Hash32 name)
+/// @brief physical image description of a declared image, with usage generalized across frames
+static RImageInfo make_image_info(const RGraphImageObj* graphImage, const ImageState& state)
 {
-    LD_PROFILE_SCOPE;
-
-    RGraphImageObj* graphImage = dereference_image(&compObj, &name);
-
     RImageInfo imageI{};
     imageI.type = RIMAGE_TYPE_2D;
     imageI.samples = RSAMPLE_COUNT_1_BIT;
@@ -189,13 +222,24 @@ static RImage get_or_create_image(RDevice device, RComponentObj* compObj, Hash32
     imageI.sampler = graphImage->sampler;
     imageI.depth = 1;
 
+    // usage generalization: dont invalidate image when usage narrows
+    imageI.usage |= state.usage;
+
+    return imageI;
+}
+
+/// @brief get or create a single sampled image
+static RImage get_or_create_image(RDevice device, RComponentObj* compObj, Hash32 name)
+{
+    LD_PROFILE_SCOPE;
+
+    RGraphImageObj* graphImage = dereference_image(&compObj, &name);
+
     RComponentStorage& storage = sStorages[compObj->name];
     LD_ASSERT(storage.images.contains(name));
     ImageState& state = storage.images[name];
 
-    // usage generalization: dont invalidate image when usage narrows
-    imageI.usage |= state.usage;
-
+    RImageInfo imageI = make_image_info(graphImage, state);
     Hash32 imageHash = get_image_hash(imageI, name);
 
     // create or invalidate image
@@ -203,6 +247,9 @@ static RImage get_or_create_image(RDevice device, RComponentObj* compObj, Hash32
     {
         LD_PROFILE_SCOPE_NAME("get_or_create_image invalidate");
 
+        // transient images are placed before recording and should not be invalidated here
+        LD_ASSERT(!state.isTransient);
+
         if (!state.handle)
             state.usage = imageI.usage;
 
@@ -214,7 +261,11 @@ static RImage get_or_create_image(RDevice device, RComponentObj* compObj, Hash32
             device.destroy_image(state.handle);
         }
 
-        state.lastLayout = RIMAGE_LAYOUT_UNDEFINED;
+        // images are recreated only if the structure changed, the barriers of this
+        // submission are being recorded and will reference the new image.
+        LD_ASSERT(!sCompiled.hasBarriers);
+
+        state.sync = {};
         state.usage = imageI.usage;
         state.width = imageI.width;
         state.height = imageI.height;
@@ -274,7 +325,9 @@ static RImage get_or_create_ms_image(RDevice device, RComponentObj* comp, Hash32
             device.destroy_image(multiSampledState.handle);
         }
 
-        multiSampledState.lastLayout = RIMAGE_LAYOUT_UNDEFINED;
+        LD_ASSERT(!sCompiled.hasBarriers);
+
+        multiSampledState.sync = {};
         multiSampledState.usage = imageI.usage;
         multiSampledState.width = imageI.width;
         multiSampledState.height = imageI.height;
@@ -327,15 +380,74 @@ static void topological_sort(const HashMap<Hash32, RComponent>& components, Vect
     std::reverse(order.begin(), order.end());
 }
 
-void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
+void RGraphObj::sync_image(RGraphImageSync& sync, RImage image, const RGraphImageAccess& access)
+{
+    // sync states are updated in flush_barriers
+    if (isBarrierReplay)
+        return;
+
+    if (syncTouched.insert(&sync).second)
+        sCompiled.save_sync_begin(&sync);
+
+    RGraphImageBarrier barrier;
+    bool hasBarrier = sync_image_access(sync, access, (uint32_t)barrierImages.size(), barrier);
+
+    syncUpdates.push_back({&sync, sync});
+
+    if (!hasBarrier)
+        return;
+
+    merge_image_barrier(barrierBatch, barrier);
+    barrierImages.push_back(image);
+}
+
+static void cmd_barrier_batch(RCommandList list, const RGraphCompiledBarriers& compiled)
+{
+    const RGraphBarrierBatch& batch = compiled.batch;
+
+    if (batch.empty())
+        return;
+
+    LD_PROFILE_SCOPE;
+
+    Vector<RImageMemoryBarrier> barriers(batch.barriers.size());
+
+    for (size_t i = 0; i < barriers.size(); i++)
+    {
+        const RGraphImageBarrier& barrier = batch.barriers[i];
+        barriers[i] = RUtil::make_image_memory_barrier(compiled.images[barrier.image], barrier.oldLayout, barrier.newLayout, barrier.srcAccess, barrier.dstAccess);
+    }
+
+    list.cmd_image_memory_barriers(batch.srcStages, batch.dstStages, (uint32_t)barriers.size(), barriers.data());
+}
+
+uint32_t RGraphObj::flush_barriers()
+{
+    if (isBarrierReplay)
+    {
+        sCompiled.replay_barriers(barrierFlushIndex);
+        return barrierFlushIndex++;
+    }
+
+    uint32_t index = sCompiled.push_barriers({std::move(barrierBatch), std::move(barrierImages), std::move(syncUpdates)});
+    barrierBatch.clear();
+    barrierImages.clear();
+    syncUpdates.clear();
+
+    return index;
+}
+
+void RGraphObj::prepare_graphics_pass(RGraphicsPassObj* pass, RGraphPassRecord& record)
 {
     LD_PROFILE_SCOPE;
 
     RComponentObj* comp = pass->compObj;
     uint32_t colorAttachmentCount = (uint32_t)pass->colorAttachments.size();
-    Vector<RImage> colorHandles(colorAttachmentCount);
-    Vector<RImage> resolveHandles(colorAttachmentCount);
+    Vector<RImage>& colorHandles = record.colorHandles;
+    Vector<RImage>& resolveHandles = record.resolveHandles;
     RImage depthStencilHandle = {};
+    colorHandles.resize(colorAttachmentCount);
+    resolveHandles.resize(colorAttachmentCount);
 
     // build render pass info
     RPassInfo passI = {};
@@ -388,11 +500,11 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
 
             // update single-sample resolve attachment state
             RPassResolveAttachment* resolveAttachmentInfo = pass->resolveAttachmentInfos.data() + colorIdx;
-            resolveAttachmentInfo->initialLayout = imageState->lastLayout;
             resolveAttachmentInfo->passLayout = RIMAGE_LAYOUT_COLOR_ATTACHMENT;
+            resolveAttachmentInfo->initialLayout = resolveAttachmentInfo->passLayout;
             resolveAttachmentInfo->loadOp = resolveAttachmentLoadOp;
             resolveAttachmentInfo->storeOp = colorAttachmentInfo->colorStoreOp;
-            imageState->lastLayout = resolveAttachmentInfo->passLayout;
+            sync_image(imageState->sync, imageHandle, get_color_attachment_access(resolveAttachmentLoadOp != RATTACHMENT_LOAD_OP_LOAD));
             imageState->handle = imageHandle;
 
             // multi-sample color attachment load op is either clear or dont-care
@@ -400,9 +512,9 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
                 colorAttachmentInfo->colorLoadOp = RATTACHMENT_LOAD_OP_DONT_CARE;
 
             // update multi-sampled color attachment state
-            colorAttachmentInfo->initialLayout = msImageState->lastLayout;
+            colorAttachmentInfo->initialLayout = colorAttachmentInfo->passLayout;
             colorAttachmentInfo->colorStoreOp = RATTACHMENT_STORE_OP_DONT_CARE; // avoid writing back to main memory.
-            msImageState->lastLayout = colorAttachmentInfo->passLayout;
+            sync_image(msImageState->sync, msImageHandle, get_color_attachment_access(true));
             msImageState->handle = msImageHandle;
         }
         else
@@ -410,14 +522,15 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
             colorHandles[colorIdx] = imageHandle;
 
             // update single-sample color attachment state
-            colorAttachmentInfo->initialLayout = imageState->lastLayout;
-            imageState->lastLayout = colorAttachmentInfo->passLayout;
+            colorAttachmentInfo->initialLayout = colorAttachmentInfo->passLayout;
+            sync_image(imageState->sync, imageHandle, get_color_attachment_access(colorAttachmentInfo->colorLoadOp != RATTACHMENT_LOAD_OP_LOAD));
             imageState->handle = imageHandle;
         }
     }
 
     // clear colors
-    Vector<RClearColorValue> clearColors(colorAttachmentCount);
+    Vector<RClearColorValue>& clearColors = record.clearColors;
+    clearColors.resize(colorAttachmentCount);
     for (size_t i = 0; i < clearColors.size(); i++)
         clearColors[i] = pass->colorAttachments[i].clearValue.value_or(RClearColorValue{});
 
@@ -435,13 +548,17 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
         RComponentStorage& compStorage = sStorages[srcCompObj->name];
         RImage imageHandle = {};
 
+        // the render pass does not transition layouts, attachments are in pass layout before the pass begins
+        RPassDepthStencilAttachment& depthStencilInfo = pass->depthStencilAttachmentInfo;
+        bool isDiscard = depthStencilInfo.depthLoadOp != RATTACHMENT_LOAD_OP_LOAD && depthStencilInfo.stencilLoadOp != RATTACHMENT_LOAD_OP_LOAD;
+        depthStencilInfo.initialLayout = depthStencilInfo.passLayout;
+
         if (hasMultiSampleResolve)
         {
             imageHandle = get_or_create_ms_image(device, srcCompObj, srcOutputName, depthStencilDecl->format, depthStencilDecl->width, depthStencilDecl->height);
             ImageState& msImageState = compStorage.msImages[srcOutputName];
 
-            pass->depthStencilAttachmentInfo.initialLayout = msImageState.lastLayout;
-            msImageState.lastLayout = pass->depthStencilAttachmentInfo.passLayout;
+            sync_image(msImageState.sync, imageHandle, get_depth_stencil_attachment_access(isDiscard));
             msImageState.handle = imageHandle;
         }
         else
@@ -449,8 +566,7 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
             imageHandle = get_or_create_image(device, srcCompObj, srcOutputName);
             ImageState& imageState = compStorage.images[srcOutputName];
 
-            pass->depthStencilAttachmentInfo.initialLayout = imageState.lastLayout;
-            imageState.lastLayout = pass->depthStencilAttachmentInfo.passLayout;
+            sync_image(imageState.sync, imageHandle, get_depth_stencil_attachment_access(isDiscard));
             imageState.handle = imageHandle;
         }
 
@@ -463,11 +579,7 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
     if (pass->hasDepthStencil && pass->depthStencilAttachment.clearValue.has_value())
         clearDepthStencil = pass->depthStencilAttachment.clearValue.value();
 
-    // dependency on previous pass
-    if (passIdx > 0 && has_pass_dependency(passOrder[passIdx - 1], passOrder[passIdx], pass->passDep))
-        passI.dependency = &pass->passDep;
-
-    // perform image layout transitions for sampled images, right before render pass
+    // sampled images are made visible to fragment shaders, transitioned only if not already shader read only
     for (Hash32 imageName : pass->sampledImages)
     {
         LD_PROFILE_SCOPE_NAME("render pass sampled images");
@@ -480,13 +592,14 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
         RComponentStorage& storage = sStorages[srcCompObj->name];
         ImageState* state = &storage.images[imageName];
 
-        RImage image = state->handle;
-        RImageMemoryBarrier barrier = RUtil::make_image_memory_barrier(image, state->lastLayout, RIMAGE_LAYOUT_SHADER_READ_ONLY, RACCESS_COLOR_ATTACHMENT_WRITE_BIT, RACCESS_SHADER_READ_BIT);
-        list.cmd_image_memory_barrier(RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, RPIPELINE_STAGE_FRAGMENT_SHADER_BIT, barrier);
-        state->lastLayout = RIMAGE_LAYOUT_SHADER_READ_ONLY;
+        sync_image(state->sync, state->handle, get_sampled_access());
     }
 
-    RPassBeginInfo passBI{
+    // all hazards of this pass are resolved in a single pipeline barrier,
+    // the render pass itself needs no external dependency.
+    record.pass = pass;
+    record.barrierIndex = flush_barriers();
+    record.passBI = RPassBeginInfo{
         .width = pass->width,
         .height = pass->height,
         .depthStencilAttachment = depthStencilHandle,
@@ -497,12 +610,6 @@ void RGraphObj::record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx)
         .clearDepthStencil = clearDepthStencil,
         .pass = passI,
     };
-
-    list.cmd_begin_pass(passBI);
-    pass->isCallbackScope = true;
-    pass->callback({pass}, list, pass->user);
-    pass->isCallbackScope = false;
-    list.cmd_end_pass();
 }
 
 void RGraphObj::sort()
@@ -516,7 +623,228 @@ void RGraphObj::sort()
     graphState = RGRAPH_STATE_SORTED;
 }
 
-void RGraphObj::record_compute_pass(RComputePassObj* pass, uint32_t passIdx)
+std::size_t RGraphObj::get_structure_hash()
+{
+    std::size_t hash = structureHash;
+
+    hash_combine(hash, screenWidth);
+    hash_combine(hash, screenHeight);
+
+    for (const auto& ite : components)
+        hash_combine(hash, ite.second.unwrap()->structureHash);
+
+    return hash;
+}
+
+/// @brief destroy all transient images and the memory they are placed in
+static void destroy_transient_images(RDevice device)
+{
+    for (const auto& [compName, imageName] : sTransient.images)
+    {
+        if (!sStorages.contains(compName) || !sStorages[compName].images.contains(imageName))
+            continue;
+
+        ImageState& state = sStorages[compName].images[imageName];
+
+        if (state.handle)
+            device.destroy_image(state.handle);
+
+        state = {};
+    }
+
+    for (RMemory memory : sTransient.heaps)
+        device.destroy_memory(memory);
+
+    sTransient.heaps.clear();
+    sTransient.images.clear();
+    sTransient.report = {};
+}
+
+/// @brief Transient images do not carry contents between frames,
+///        the first access in each frame waits for any image aliasing the same memory.
+static void reset_transient_images()
+{
+    for (const auto& [compName, imageName] : sTransient.images)
+        sync_image_aliased(sStorages[compName].images[imageName].sync);
+}
+
+/// @brief returns true if the pass overwrites the entire image as an attachment,
+///        so the previous contents of its memory are never observed.
+static bool is_discarding_write(RComponentPassObj* passObj, Hash32 imageName)
+{
+    if (passObj->isComputePass)
+        return false;
+
+    RGraphicsPassObj* pass = (RGraphicsPassObj*)passObj;
+
+    if (pass->samples != RSAMPLE_COUNT_1_BIT)
+        return false;
+
+    switch (pass->imageUsages[imageName])
+    {
+    case RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT:
+        for (size_t i = 0; i < pass->colorAttachments.size(); i++)
+        {
+            if (pass->colorAttachments[i].name == imageName)
+                return pass->colorAttachmentInfos[i].colorLoadOp != RATTACHMENT_LOAD_OP_LOAD;
+        }
+        return false;
+    case RGRAPH_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT:
+        return pass->depthStencilAttachmentInfo.depthLoadOp != RATTACHMENT_LOAD_OP_LOAD &&
+               pass->depthStencilAttachmentInfo.stencilLoadOp != RATTACHMENT_LOAD_OP_LOAD;
+    default:
+        break;
+    }
+
+    return false;
+}
+
+void RGraphObj::place_transient_images()
+{
+    LD_PROFILE_SCOPE;
+
+    struct TransientCandidate
+    {
+        RComponentObj* compObj;
+        Hash32 name;
+        uint32_t firstPass;
+        uint32_t lastPass;
+        bool isEligible;
+    };
+
+    // private images are never observed outside their component,
+    // find the lifetime of each one in the sorted pass order.
+    HashMap<Hash32, HashMap<Hash32, TransientCandidate>> candidates;
+
+    for (uint32_t passIdx = 0; passIdx < (uint32_t)passOrder.size(); passIdx++)
+    {
+        RComponentPassObj* passObj = passOrder[passIdx];
+        RComponentObj* compObj = passObj->compObj;
+
+        for (const auto& [imageName, usage] : passObj->imageUsages)
+        {
+            if (!compObj->images.contains(imageName) || compObj->images[imageName]->type != NODE_TYPE_PRIVATE)
+                continue;
+
+            auto& compCandidates = candidates[compObj->name];
+
+            if (!compCandidates.contains(imageName))
+            {
+                compCandidates[imageName] = {compObj, imageName, passIdx, passIdx, is_discarding_write(passObj, imageName)};
+                continue;
+            }
+
+            compCandidates[imageName].lastPass = passIdx;
+        }
+    }
+
+    // the swapchain blit reads its source after all passes
+    for (const auto& it : swapchains)
+    {
+        const RGraphImageObj* blitSrc = it.second.blitSrc;
+
+        if (blitSrc && candidates.contains(blitSrc->compObj->name) && candidates[blitSrc->compObj->name].contains(blitSrc->name))
+            candidates[blitSrc->compObj->name][blitSrc->name].isEligible = false;
+    }
+
+    Vector<TransientCandidate> transients;
+
+    for (auto& compIte : candidates)
+    {
+        for (auto& imageIte : compIte.second)
+        {
+            if (imageIte.second.isEligible && imageIte.second.compObj->samples == RSAMPLE_COUNT_1_BIT)
+                transients.push_back(imageIte.second);
+        }
+    }
+
+    // plan hash should not depend on hash map iteration order
+    std::sort(transients.begin(), transients.end(), [](const TransientCandidate& lhs, const TransientCandidate& rhs) {
+        if (lhs.compObj->name != rhs.compObj->name)
+            return (uint32_t)lhs.compObj->name < (uint32_t)rhs.compObj->name;
+
+        return (uint32_t)lhs.name < (uint32_t)rhs.name;
+    });
+
+    Vector<RImageInfo> transientInfos;
+    std::size_t planHash = 0;
+
+    for (const TransientCandidate& candidate : transients)
+    {
+        const RGraphImageObj* graphImage = candidate.compObj->images[candidate.name];
+        ImageState& state = sStorages[candidate.compObj->name].images[candidate.name];
+        RImageInfo imageI = make_image_info(graphImage, state);
+
+        hash_combine(planHash, (uint32_t)candidate.compObj->name);
+        hash_combine(planHash, (uint32_t)get_image_hash(imageI, candidate.name));
+        hash_combine(planHash, candidate.firstPass);
+        hash_combine(planHash, candidate.lastPass);
+
+        transientInfos.push_back(imageI);
+    }
+
+    if (sTransient.planHash == (Hash32)planHash)
+    {
+        reset_transient_images();
+        return;
+    }
+
+    LD_PROFILE_SCOPE_NAME("place_transient_images replan");
+
+    // NOTE: replanning is slow path, we must wait until GPU finishes work
+    //       from frames in flight before destroying images and memory.
+    device.wait_idle();
+    destroy_transient_images(device);
+    sCompiled.invalidate_barriers();
+    sTransient.planHash = (Hash32)planHash;
+
+    const uint32_t transientCount = (uint32_t)transients.size();
+    Vector<RGraphTransientImage> planImages(transientCount);
+
+    for (uint32_t i = 0; i < transientCount; i++)
+    {
+        RMemoryRequirements req = device.get_image_memory_requirements(transientInfos[i]);
+        planImages[i] = {transients[i].firstPass, transients[i].lastPass, req.size, req.alignment, req.typeBits};
+    }
+
+    RGraphAliasPlan plan;
+    plan_transient_aliasing(planImages, plan);
+
+    sTransient.heaps.resize(plan.heaps.size());
+    for (size_t i = 0; i < plan.heaps.size(); i++)
+    {
+        const RGraphAliasHeap& heap = plan.heaps[i];
+        sTransient.heaps[i] = device.create_memory({heap.size, heap.alignment, heap.typeBits});
+    }
+
+    for (uint32_t i = 0; i < transientCount; i++)
+    {
+        const RImageInfo& imageI = transientInfos[i];
+        const RGraphAliasPlacement& placement = plan.placements[i];
+        ImageState& state = sStorages[transients[i].compObj->name].images[transients[i].name];
+
+        // image was previously in dedicated memory
+        if (state.handle)
+            device.destroy_image(state.handle);
+
+        sync_image_aliased(state.sync);
+        state.usage = imageI.usage;
+        state.width = imageI.width;
+        state.height = imageI.height;
+        state.handle = device.create_placed_image(imageI, sTransient.heaps[placement.heapIndex], placement.offset);
+        state.hash = get_image_hash(imageI, transients[i].name);
+        state.isTransient = true;
+
+        sTransient.images.push_back({transients[i].compObj->name, transients[i].name});
+    }
+
+    sTransient.report.transientImageCount = transientCount;
+    sTransient.report.heapCount = (uint32_t)plan.heaps.size();
+    sTransient.report.unaliasedSize = plan.unaliasedSize;
+    sTransient.report.aliasedSize = plan.aliasedSize;
+}
+
+void RGraphObj::prepare_compute_pass(RComputePassObj* pass, RGraphPassRecord& record)
 {
     LD_PROFILE_SCOPE;
 
@@ -535,15 +863,71 @@ void RGraphObj::record_compute_pass(RComputePassObj* pass, uint32_t passIdx)
         dereference_image(&comp, &imageName);
         ImageState& state = sStorages[comp->name].images[imageName];
 
-        RImage image = state.handle;
-        RImageMemoryBarrier barrier = RUtil::make_image_memory_barrier(image, state.lastLayout, RIMAGE_LAYOUT_GENERAL, 0, RACCESS_SHADER_READ_BIT);
-        list.cmd_image_memory_barrier(RPIPELINE_STAGE_TOP_OF_PIPE_BIT, RPIPELINE_STAGE_COMPUTE_SHADER_BIT, barrier);
-        state.lastLayout = RIMAGE_LAYOUT_GENERAL;
+        sync_image(state.sync, state.handle, get_storage_read_only_access());
+    }
+
+    record.pass = pass;
+    record.barrierIndex = flush_barriers();
+}
+
+void RGraphObj::record_passes(RCommandList list, uint32_t passBegin, uint32_t passEnd)
+{
+    LD_PROFILE_SCOPE;
+
+    if (prePassCB)
+        prePassCB(list, user);
+
+    for (uint32_t passIdx = passBegin; passIdx < passEnd; passIdx++)
+    {
+        LD_PROFILE_SCOPE_NAME("record pass");
+
+        RGraphPassRecord& record = passRecords[passIdx];
+        cmd_barrier_batch(list, sCompiled.barriers[record.barrierIndex]);
+
+        if (record.pass->isComputePass)
+        {
+            RComputePassObj* pass = (RComputePassObj*)record.pass;
+            pass->isCallbackScope = true;
+            pass->callback({pass}, list, pass->user);
+            pass->isCallbackScope = false;
+            continue;
+        }
+
+        RGraphicsPassObj* pass = (RGraphicsPassObj*)record.pass;
+        list.cmd_begin_pass(record.passBI);
+        pass->isCallbackScope = true;
+        pass->callback({pass}, list, pass->user);
+        pass->isCallbackScope = false;
+        list.cmd_end_pass();
     }
+}
+
+bool RGraphObj::record_passes_parallel()
+{
+    JobSystem jobSystem = JobSystem::get();
+    const uint32_t passCount = (uint32_t)passRecords.size();
+    const uint32_t listCount = std::min<uint32_t>((uint32_t)passLists.size(), passCount);
+
+    // lazily created OpenGL objects can only be created on the context thread
+    if (listCount <= 1 || !jobSystem || device.get_backend() != RDEVICE_BACKEND_VULKAN)
+        return false;
+
+    LD_PROFILE_SCOPE;
+
+    passLists.resize(listCount);
 
-    pass->isCallbackScope = true;
-    pass->callback({pass}, list, pass->user);
-    pass->isCallbackScope = false;
+    // each list records a contiguous range of the pass order, and is submitted in range order
+    jobSystem.parallel_for(0, listCount, 1, [&](size_t listBegin, size_t listEnd) {
+        for (size_t listIdx = listBegin; listIdx < listEnd; listIdx++)
+        {
+            RCommandList passList = passLists[listIdx];
+            passList.begin();
+            record_passes(passList, (uint32_t)(listIdx * passCount / listCount), (uint32_t)((listIdx + 1) * passCount / listCount));
+            passList.end();
+        }
+    });
+
+    return true;
 }
 
 static void save_graph_to_dot(RGraphObj* graphObj, const char* path)
@@ -604,6 +988,7 @@ void RGraphicsPass::use_image_sampled(RGraphImage imageH)
 
     // how the pass uses the image
     obj->imageUsages[imageName] = RGRAPH_IMAGE_USAGE_SAMPLED;
+    hash_image_usage(obj, imageName, RGRAPH_IMAGE_USAGE_SAMPLED, 0);
 
     // how the component uses the image
     comp->images[imageName]->usage |= get_native_image_usage(RGRAPH_IMAGE_USAGE_SAMPLED);
@@ -638,6 +1023,7 @@ void RGraphicsPass::use_color_attachment(RGraphImage imageH, RAttachmentLoadOp l
 
     // how the pass uses the image
     obj->imageUsages[imageName] = RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT;
+    hash_image_usage(obj, imageName, RGRAPH_IMAGE_USAGE_COLOR_ATTACHMENT, (uint32_t)loadOp);
 
     // how the component uses the image
     comp->images[imageName]->usage |= RIMAGE_USAGE_COLOR_ATTACHMENT_BIT;
@@ -646,7 +1032,7 @@ void RGraphicsPass::use_color_attachment(RGraphImage imageH, RAttachmentLoadOp l
     {
         // prepare to create ms attachment
         sStorages[comp->name].msImages[imageName] = {
-            .lastLayout = RIMAGE_LAYOUT_UNDEFINED,
+            .sync = {},
             .width = image->width,
             .height = image->height,
             .depth = 1,
@@ -668,9 +1054,6 @@ void RGraphicsPass::use_color_attachment(RGraphImage imageH, RAttachmentLoadOp l
     obj->colorAttachments.push_back(std::move(attachment));
     obj->colorAttachmentInfos.push_back(std::move(attachmentInfo));
 
-    obj->accessFlags |= RACCESS_COLOR_ATTACHMENT_WRITE_BIT;
-    obj->stageFlags |= RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-
     // if existing passes in the component also use this image, check for dependencies
     for (RComponentPassObj* srcPassObj : comp->passOrder)
     {
@@ -709,6 +1092,7 @@ void RGraphicsPass::use_depth_stencil_attachment(RGraphImage imageH, RAttachment
 
     // how the pass uses the image
     obj->imageUsages[imageName] = RGRAPH_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT;
+    hash_image_usage(obj, imageName, RGRAPH_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT, (uint32_t)loadOp);
 
     // how the component uses the image
     comp->images[imageName]->usage |= RIMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
@@ -725,14 +1109,11 @@ void RGraphicsPass::use_depth_stencil_attachment(RGraphImage imageH, RAttachment
     obj->depthStencilAttachmentInfo.stencilStoreOp = RATTACHMENT_STORE_OP_DONT_CARE;     // TODO:
     obj->depthStencilAttachmentInfo.passLayout = RIMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT; // use_depth_stencil_attachment
 
-    obj->accessFlags |= RACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-    obj->stageFlags |= RPIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | RPIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-
     if (obj->samples != RSAMPLE_COUNT_1_BIT && !sStorages[comp->name].msImages.contains(imageName))
     {
         // prepare to create ms attachment
         sStorages[comp->name].msImages[imageName] = {
-            .lastLayout = RIMAGE_LAYOUT_UNDEFINED,
+            .sync = {},
             .width = image->width,
             .height = image->height,
             .depth = 1,
@@ -748,12 +1129,16 @@ RImage RGraphicsPass::get_image(Hash32 name, RImageLayout* layout)
         return {};
     }
 
+    // passes of other command lists may be recorded concurrently,
+    // an image used by this pass is in the layout of its usage.
+    auto usage = mObj->imageUsages.find(name);
+
     RComponentObj* compObj = mObj->compObj;
     dereference_image(&compObj, &name);
     RComponentStorage& storage = sStorages[compObj->name];
 
     if (layout)
-        *layout = storage.images[name].lastLayout;
+        *layout = usage != mObj->imageUsages.end() ? get_image_usage_layout(usage->second) : storage.images[name].sync.layout;
 
     RImage imageHandle = storage.images[name].handle;
     LD_ASSERT(imageHandle);
@@ -778,12 +1163,10 @@ void RComputePass::use_image_storage_read_only(RGraphImage imageH)
 
     // how the pass uses the image
     obj->imageUsages[imageName] = RGRAPH_IMAGE_USAGE_STORAGE_READ_ONLY;
+    hash_image_usage(obj, imageName, RGRAPH_IMAGE_USAGE_STORAGE_READ_ONLY, 0);
 
     // how the component uses the image
     comp->images[imageName]->usage |= RIMAGE_USAGE_STORAGE_BIT;
-
-    obj->accessFlags |= RACCESS_SHADER_READ_BIT;
-    obj->stageFlags |= RPIPELINE_STAGE_COMPUTE_SHADER_BIT;
 }
 
 RImage RComputePass::get_image(Hash32 name)
@@ -817,7 +1200,6 @@ RGraphImage RComponent::add_private_image(const char* nameStr, RFormat format, u
     if (!sStorages[mObj->name].images.contains(imageName))
     {
         ImageState& state = sStorages[mObj->name].images[imageName];
-        state.lastLayout = RIMAGE_LAYOUT_UNDEFINED;
         state.width = width;
         state.height = height;
         state.depth = 1;
@@ -835,7 +1217,6 @@ RGraphImage RComponent::add_output_image(const char* nameStr, RFormat format, ui
     if (!sStorages[mObj->name].images.contains(imageName))
     {
         ImageState& state = sStorages[mObj->name].images[imageName];
-        state.lastLayout = RIMAGE_LAYOUT_UNDEFINED;
         state.width = width;
         state.height = height;
         state.depth = 1;
@@ -874,8 +1255,6 @@ RGraphicsPass RComponent::add_graphics_pass(const RGraphicsPassInfo& gpI, void*
     obj->isCallbackScope = false;
     obj->isComputePass = false;
     obj->hasDepthStencil = false;
-    obj->accessFlags = 0;
-    obj->stageFlags = 0;
     obj->samples = gpI.samples;
 
     // if a component contains multi-sampling graphics passes, all such passes should use the same sample count
@@ -885,6 +1264,11 @@ RGraphicsPass RComponent::add_graphics_pass(const RGraphicsPassInfo& gpI, void*
     mObj->passes[obj->name] = {obj};
     mObj->passOrder.push_back({obj});
 
+    hash_combine(mObj->structureHash, (uint32_t)obj->name);
+    hash_combine(mObj->structureHash, obj->width);
+    hash_combine(mObj->structureHash, obj->height);
+    hash_combine(mObj->structureHash, (uint32_t)obj->samples);
+
     return {obj};
 }
 
@@ -900,12 +1284,12 @@ RComputePass RComponent::add_compute_pass(const RComputePassInfo& cpI, void* use
     obj->compObj = mObj;
     obj->isCallbackScope = false;
     obj->isComputePass = true;
-    obj->accessFlags = 0;
-    obj->stageFlags = 0;
 
     mObj->passes[obj->name] = {obj};
     mObj->passOrder.push_back({obj});
 
+    hash_combine(mObj->structureHash, (uint32_t)obj->name);
+
     return {obj};
 }
 
@@ -916,6 +1300,8 @@ RGraph RGraph::create(const RGraphInfo& graphI)
     RGraphObj* obj = heap_new<RGraphObj>(MEMORY_USAGE_RENDER);
     obj->device = graphI.device;
     obj->list = graphI.list;
+    obj->passLists.resize(graphI.passListCount);
+    std::copy(graphI.passLists, graphI.passLists + graphI.passListCount, obj->passLists.begin());
     obj->prePassCB = graphI.prePassCB;
     obj->preSubmitCB = graphI.preSubmitCB;
     obj->user = graphI.user;
@@ -929,6 +1315,7 @@ RGraph RGraph::create(const RGraphInfo& graphI)
         const WindowID windowID = graphI.swapchains[i].window;
         obj->swapchains[windowID].info = graphI.swapchains[i];
         obj->swapchains[windowID].blitSrc = nullptr;
+        hash_combine(obj->structureHash, windowID);
     }
 
     return {obj};
@@ -1005,6 +1392,24 @@ void RGraph::release(RDevice device)
                 device.destroy_image(msImageIte.second.handle);
         }
     }
+
+    // transient images are destroyed above, before the memory they are placed in
+    for (RMemory memory : sTransient.heaps)
+        device.destroy_memory(memory);
+
+    sTransient = {};
+
+    sCompiled.invalidate();
+}
+
+RGraphMemoryReport RGraph::get_memory_report()
+{
+    return sTransient.report;
+}
+
+RGraphCompileStats RGraph::get_compile_stats()
+{
+    return sCompiled.stats;
 }
 
 RDevice RGraph::get_device()
@@ -1027,6 +1432,7 @@ RComponent RGraph::add_component(const char* nameStr)
     comp->debugName = nameStr;
     comp->name = Hash32(comp->debugName.c_str());
     comp->samples = RSAMPLE_COUNT_1_BIT;
+    comp->structureHash = (uint32_t)comp->name;
 
     LD_ASSERT(!mObj->components.contains(comp->name)); // component name needs to be globally unique
     mObj->components[comp->name] = {comp};
@@ -1087,6 +1493,11 @@ void RGraph::connect_image(RGraphImage src, RGraphImage dst)
 
     // establish reference link
     dstCompObj->imageRefs[dstInImage] = srcImageObj;
+
+    hash_combine(mObj->structureHash, (uint32_t)srcComp);
+    hash_combine(mObj->structureHash, (uint32_t)srcOutImage);
+    hash_combine(mObj->structureHash, (uint32_t)dstComp);
+    hash_combine(mObj->structureHash, (uint32_t)dstInImage);
 }
 
 void RGraph::connect_swapchain_image(RGraphImage src, WindowID dstWindow)
@@ -1102,6 +1513,10 @@ void RGraph::connect_swapchain_image(RGraphImage src, WindowID dstWindow)
     srcImage->usage |= RIMAGE_USAGE_TRANSFER_SRC_BIT;
 
     swp.blitSrc = srcImage;
+
+    hash_combine(mObj->structureHash, dstWindow);
+    hash_combine(mObj->structureHash, (uint32_t)srcCompObj->name);
+    hash_combine(mObj->structureHash, (uint32_t)srcOutImage);
 }
 
 void RGraph::debug(Vector<RComponentPass>& passOrder, bool saveToDisk)
@@ -1122,31 +1537,79 @@ void RGraph::submit()
 {
     LD_PROFILE_SCOPE;
 
-    if (mObj->graphState == RGRAPH_STATE_CREATED)
-        mObj->sort();
+    const std::size_t structureHash = mObj->get_structure_hash();
+    const bool isReuse = sCompiled.is_reuse(structureHash);
 
-    // recording
-    RCommandList list = mObj->list;
-    list.begin();
+    if (isReuse)
+    {
+        LD_PROFILE_SCOPE_NAME("reuse compiled graph");
 
-    if (mObj->prePassCB)
-        mObj->prePassCB(list, mObj->user);
+        mObj->passOrder.resize(sCompiled.passOrder.size());
+        for (size_t i = 0; i < sCompiled.passOrder.size(); i++)
+        {
+            const auto& [compName, passName] = sCompiled.passOrder[i];
+            mObj->passOrder[i] = mObj->components[compName].unwrap()->passes[passName];
+        }
 
-    for (uint32_t passIdx = 0; passIdx < (uint32_t)mObj->passOrder.size(); passIdx++)
+        mObj->graphState = RGRAPH_STATE_SORTED;
+        reset_transient_images();
+        sCompiled.stats.reuseCount++;
+    }
+    else
     {
-        LD_PROFILE_SCOPE_NAME("record pass");
+        LD_PROFILE_SCOPE_NAME("compile graph");
+
+        if (mObj->graphState == RGRAPH_STATE_CREATED)
+            mObj->sort();
+
+        mObj->place_transient_images();
+
+        sCompiled.structureHash = structureHash;
+        sCompiled.isValid = true;
+        sCompiled.passOrder.resize(mObj->passOrder.size());
+        for (size_t i = 0; i < mObj->passOrder.size(); i++)
+            sCompiled.passOrder[i] = {mObj->passOrder[i]->compObj->name, mObj->passOrder[i]->name};
+
+        sCompiled.stats.compileCount++;
+    }
+
+    // barriers recorded from the same image sync states are replayed,
+    // otherwise they are recorded again for the next frame.
+    mObj->isBarrierReplay = sCompiled.begin_barriers(isReuse);
+
+    LD_PROFILE_PLOT("RGraph compile", (int64_t)sCompiled.stats.compileCount);
+    LD_PROFILE_PLOT("RGraph reuse", (int64_t)sCompiled.stats.reuseCount);
+
+    // images and barriers are resolved in pass order before any pass is recorded
+    const uint32_t passCount = (uint32_t)mObj->passOrder.size();
+    mObj->passRecords.resize(passCount);
+
+    for (uint32_t passIdx = 0; passIdx < passCount; passIdx++)
+    {
+        LD_PROFILE_SCOPE_NAME("prepare pass");
 
         if (mObj->passOrder[passIdx]->isComputePass)
         {
             RComputePassObj* pass = (RComputePassObj*)mObj->passOrder[passIdx];
-            mObj->record_compute_pass(pass, passIdx);
+            mObj->prepare_compute_pass(pass, mObj->passRecords[passIdx]);
             continue;
         }
 
         RGraphicsPassObj* pass = (RGraphicsPassObj*)mObj->passOrder[passIdx];
-        mObj->record_graphics_pass(pass, passIdx);
+        mObj->prepare_graphics_pass(pass, mObj->passRecords[passIdx]);
     }
 
+    // recording
+    RCommandList list = mObj->list;
+    const bool isParallel = mObj->record_passes_parallel();
+
+    list.begin();
+
+    if (isParallel)
+        sCompiled.stats.parallelRecordCount++;
+    else
+        mObj->record_passes(list, 0, passCount);
+
     size_t i = 0;
     size_t swapchainCount = mObj->swapchains.size();
     Vector<RPipelineStageFlags> waitStages(swapchainCount);
@@ -1166,9 +1629,8 @@ void RGraph::submit()
         RDevice device = mObj->device;
 
         // transition src image from final layout to transfer src
-        RImageMemoryBarrier barrier = RUtil::make_image_memory_barrier(srcBlit, srcBlitState.lastLayout, RIMAGE_LAYOUT_TRANSFER_SRC, RACCESS_COLOR_ATTACHMENT_WRITE_BIT, RACCESS_TRANSFER_READ_BIT);
-        list.cmd_image_memory_barrier(RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, RPIPELINE_STAGE_TRANSFER_BIT, barrier);
-        srcBlitState.lastLayout = RIMAGE_LAYOUT_TRANSFER_SRC;
+        mObj->sync_image(srcBlitState.sync, srcBlit, get_transfer_src_access());
+        cmd_barrier_batch(list, sCompiled.barriers[mObj->flush_barriers()]);
 
         waitStages[i] = RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
         waitSemaphores[i] = swp.info.imageAcquired;
@@ -1178,7 +1640,7 @@ void RGraph::submit()
         uint32_t swapchainHeight = dstBlit.height();
 
         // transition swapchain image to transfer dst
-        barrier = RUtil::make_image_memory_barrier(dstBlit, RIMAGE_LAYOUT_UNDEFINED, RIMAGE_LAYOUT_TRANSFER_DST, 0, RACCESS_TRANSFER_WRITE_BIT);
+        RImageMemoryBarrier barrier = RUtil::make_image_memory_barrier(dstBlit, RIMAGE_LAYOUT_UNDEFINED, RIMAGE_LAYOUT_TRANSFER_DST, 0, RACCESS_TRANSFER_WRITE_BIT);
         list.cmd_image_memory_barrier(RPIPELINE_STAGE_TOP_OF_PIPE_BIT, RPIPELINE_STAGE_TRANSFER_BIT, barrier);
 
         // insert blit command
@@ -1198,22 +1660,29 @@ void RGraph::submit()
         i++;
     }
 
+    sCompiled.hasBarriers = true;
+
     if (mObj->preSubmitCB)
         mObj->preSubmitCB(list, mObj->user);
 
     list.end();
 
+    // pass lists execute in pass order, followed by the swapchain blits of the main list
+    Vector<RCommandList> submitLists;
+    if (isParallel)
+        submitLists = mObj->passLists;
+    submitLists.push_back(list);
+
     // TODO: Multi queue submission to saturate GPU, need to expand RenderBackend API first.
-    //       This is currently a very coarse one-shot submission.
-    //       1. monolithic command list
-    //       2. waits all swapchains to acquire images before work starts
+    //       This is currently a very coarse one-shot submission,
+    //       waits all swapchains to acquire images before work starts.
     RQueue queue = mObj->device.get_graphics_queue();
     RSubmitInfo submitI{
         .waitCount = (uint32_t)swapchainCount,
         .waitStages = waitStages.data(),
         .waits = waitSemaphores.data(),
-        .listCount = 1,
-        .lists = &list,
+        .listCount = (uint32_t)submitLists.size(),
+        .lists = submitLists.data(),
         .signalCount = (uint32_t)swapchainCount,
         .signals = signalSemaphores.data(),
     };
@@ -0,0 +1,125 @@
+#include <Ludens/Header/Assert.h>
+#include <Ludens/Profiler/Profiler.h>
+
+#include <algorithm>
+
+#include "RGraphAlias.h"
+
+namespace LD {
+
+struct AliasInterval
+{
+    uint64_t begin;
+    uint64_t end;
+};
+
+static inline uint64_t align_up(uint64_t offset, uint64_t alignment)
+{
+    return alignment > 1 ? (offset + alignment - 1) / alignment * alignment : offset;
+}
+
+static inline bool is_lifetime_overlap(const RGraphTransientImage& lhs, const RGraphTransientImage& rhs)
+{
+    return lhs.firstPass <= rhs.lastPass && rhs.firstPass <= lhs.lastPass;
+}
+
+/// @brief find the lowest offset in heap that does not overlap any live interval
+static bool find_heap_offset(const RGraphAliasHeap& heap, Vector<AliasInterval>& live, const RGraphTransientImage& image, uint64_t& outOffset)
+{
+    std::sort(live.begin(), live.end(), [](const AliasInterval& lhs, const AliasInterval& rhs) {
+        return lhs.begin < rhs.begin;
+    });
+
+    uint64_t candidate = 0;
+
+    for (const AliasInterval& interval : live)
+    {
+        uint64_t offset = align_up(candidate, image.alignment);
+
+        if (offset + image.size <= interval.begin)
+            break;
+
+        candidate = std::max(candidate, interval.end);
+    }
+
+    outOffset = align_up(candidate, image.alignment);
+
+    return outOffset + image.size <= heap.size;
+}
+
+void plan_transient_aliasing(const Vector<RGraphTransientImage>& images, RGraphAliasPlan& plan)
+{
+    LD_PROFILE_SCOPE;
+
+    const uint32_t imageCount = (uint32_t)images.size();
+
+    plan.heaps.clear();
+    plan.placements.resize(imageCount);
+    plan.unaliasedSize = 0;
+    plan.aliasedSize = 0;
+
+    Vector<uint32_t> order(imageCount);
+    for (uint32_t i = 0; i < imageCount; i++)
+    {
+        order[i] = i;
+        plan.unaliasedSize += images[i].size;
+    }
+
+    // larger images first, so each heap is sized by its first image
+    std::stable_sort(order.begin(), order.end(), [&](uint32_t lhs, uint32_t rhs) {
+        return images[lhs].size > images[rhs].size;
+    });
+
+    Vector<Vector<uint32_t>> heapImages;
+    Vector<AliasInterval> live;
+
+    for (uint32_t imageIdx : order)
+    {
+        const RGraphTransientImage& image = images[imageIdx];
+        RGraphAliasPlacement& placement = plan.placements[imageIdx];
+        bool isPlaced = false;
+
+        for (uint32_t heapIdx = 0; heapIdx < (uint32_t)plan.heaps.size() && !isPlaced; heapIdx++)
+        {
+            RGraphAliasHeap& heap = plan.heaps[heapIdx];
+
+            if (!(heap.typeBits & image.typeBits))
+                continue;
+
+            live.clear();
+
+            for (uint32_t otherIdx : heapImages[heapIdx])
+            {
+                if (is_lifetime_overlap(image, images[otherIdx]))
+                {
+                    uint64_t begin = plan.placements[otherIdx].offset;
+                    live.push_back({begin, begin + images[otherIdx].size});
+                }
+            }
+
+            uint64_t offset;
+            if (!find_heap_offset(heap, live, image, offset))
+                continue;
+
+            placement.heapIndex = heapIdx;
+            placement.offset = offset;
+            heap.typeBits &= image.typeBits;
+            heap.alignment = std::max(heap.alignment, image.alignment);
+            heapImages[heapIdx].push_back(imageIdx);
+            isPlaced = true;
+        }
+
+        if (isPlaced)
+            continue;
+
+        placement.heapIndex = (uint32_t)plan.heaps.size();
+        placement.offset = 0;
+        plan.heaps.push_back({image.size, image.alignment, image.typeBits});
+        heapImages.push_back({imageIdx});
+    }
+
+    for (const RGraphAliasHeap& heap : plan.heaps)
+        plan.aliasedSize += heap.size;
+}
+
+} // namespace LD
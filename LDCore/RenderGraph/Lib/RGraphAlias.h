@@ -0,0 +1,49 @@
+#pragma once
+
+#include <Ludens/DSA/Vector.h>
+
+#include <cstdint>
+
+namespace LD {
+
+/// @brief A transient image to be placed in shared memory,
+///        alive from its first to last use in the sorted pass order.
+struct RGraphTransientImage
+{
+    uint32_t firstPass; /// index of the first pass using the image
+    uint32_t lastPass;  /// index of the last pass using the image, inclusive
+    uint64_t size;      /// memory requirement size
+    uint64_t alignment; /// memory requirement alignment
+    uint32_t typeBits;  /// memory requirement type bits
+};
+
+/// @brief Memory shared by transient images that are never alive at the same time.
+struct RGraphAliasHeap
+{
+    uint64_t size;      /// byte size to allocate
+    uint64_t alignment; /// largest alignment of placed images
+    uint32_t typeBits;  /// memory types compatible with all placed images
+};
+
+/// @brief Where a transient image lives.
+struct RGraphAliasPlacement
+{
+    uint32_t heapIndex;
+    uint64_t offset;
+};
+
+/// @brief Result of planning, placements are parallel to the input images.
+struct RGraphAliasPlan
+{
+    Vector<RGraphAliasHeap> heaps;
+    Vector<RGraphAliasPlacement> placements;
+    uint64_t unaliasedSize = 0; /// total memory if each image had a dedicated allocation
+    uint64_t aliasedSize = 0;   /// total memory of all heaps
+};
+
+/// @brief Place transient images into as few heaps as possible. Images whose lifetimes
+///        overlap never share a memory range. Largest images are placed first, each image
+///        goes to the lowest offset that fits in an existing heap, otherwise a new heap.
+void plan_transient_aliasing(const Vector<RGraphTransientImage>& images, RGraphAliasPlan& plan);
+
+} // namespace LD
@@ -0,0 +1,109 @@
+#include "RGraphBarrier.h"
+
+namespace LD {
+
+bool sync_image_access(RGraphImageSync& sync, const RGraphImageAccess& access, uint32_t image, RGraphImageBarrier& barrier)
+{
+    const bool isLayoutChange = sync.layout != access.layout;
+
+    // read in the same layout, only the last write needs to be made visible
+    if (!access.isWrite && !isLayoutChange)
+    {
+        sync.readStages |= access.stages;
+
+        bool isVisible = (access.stages & ~sync.visibleStages) == 0 && (access.access & ~sync.visibleAccess) == 0;
+        if (sync.writeStages == 0 || isVisible)
+            return false;
+
+        barrier.image = image;
+        barrier.srcStages = sync.writeStages;
+        barrier.dstStages = access.stages;
+        barrier.srcAccess = sync.writeAccess;
+        barrier.dstAccess = access.access;
+        barrier.oldLayout = sync.layout;
+        barrier.newLayout = sync.layout;
+
+        sync.visibleStages |= access.stages;
+        sync.visibleAccess |= access.access;
+        return true;
+    }
+
+    // the last write is already ordered before the readers if a barrier made it visible to them,
+    // a write after those reads in the same layout then only waits for the reading stages.
+    const bool isWritePending = sync.writeStages != 0 && sync.visibleStages == 0;
+    const bool isWriteAfterRead = !isLayoutChange && !isWritePending && sync.readStages != 0;
+
+    // writes and layout transitions wait for all previous reads and writes,
+    // previous contents need not be preserved if the access discards them.
+    barrier.image = image;
+    barrier.srcStages = isWriteAfterRead ? sync.readStages : (sync.writeStages | sync.readStages);
+    barrier.dstStages = access.stages;
+    barrier.srcAccess = isWriteAfterRead ? 0 : sync.writeAccess;
+    barrier.dstAccess = access.access;
+    barrier.oldLayout = (isLayoutChange && access.isDiscard) ? RIMAGE_LAYOUT_UNDEFINED : sync.layout;
+    barrier.newLayout = access.layout;
+
+    if (barrier.srcStages == 0)
+        barrier.srcStages = RPIPELINE_STAGE_TOP_OF_PIPE_BIT;
+
+    // a layout transition behaves like a write that is visible to the access stages
+    sync.layout = access.layout;
+    sync.writeStages = access.stages;
+    sync.writeAccess = access.isWrite ? access.access : 0;
+    sync.readStages = access.isWrite ? 0 : access.stages;
+    sync.visibleStages = access.isWrite ? 0 : access.stages;
+    sync.visibleAccess = access.isWrite ? 0 : access.access;
+
+    return true;
+}
+
+void sync_image_aliased(RGraphImageSync& sync)
+{
+    sync = {};
+    sync.writeStages = RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | RPIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT |
+                       RPIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT | RPIPELINE_STAGE_FRAGMENT_SHADER_BIT |
+                       RPIPELINE_STAGE_COMPUTE_SHADER_BIT;
+    sync.writeAccess = RACCESS_COLOR_ATTACHMENT_WRITE_BIT | RACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+}
+
+void merge_image_barrier(RGraphBarrierBatch& batch, const RGraphImageBarrier& barrier)
+{
+    batch.srcStages |= barrier.srcStages;
+    batch.dstStages |= barrier.dstStages;
+    batch.barriers.push_back(barrier);
+}
+
+RGraphImageAccess get_color_attachment_access(bool isDiscard)
+{
+    RAccessFlags access = RACCESS_COLOR_ATTACHMENT_WRITE_BIT;
+
+    if (!isDiscard)
+        access |= RACCESS_COLOR_ATTACHMENT_READ_BIT;
+
+    return {RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, access, RIMAGE_LAYOUT_COLOR_ATTACHMENT, true, isDiscard};
+}
+
+RGraphImageAccess get_depth_stencil_attachment_access(bool isDiscard)
+{
+    RPipelineStageFlags stages = RPIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | RPIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
+    RAccessFlags access = RACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | RACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+
+    return {stages, access, RIMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT, true, isDiscard};
+}
+
+RGraphImageAccess get_sampled_access()
+{
+    return {RPIPELINE_STAGE_FRAGMENT_SHADER_BIT, RACCESS_SHADER_READ_BIT, RIMAGE_LAYOUT_SHADER_READ_ONLY, false, false};
+}
+
+RGraphImageAccess get_storage_read_only_access()
+{
+    return {RPIPELINE_STAGE_COMPUTE_SHADER_BIT, RACCESS_SHADER_READ_BIT, RIMAGE_LAYOUT_GENERAL, false, false};
+}
+
+RGraphImageAccess get_transfer_src_access()
+{
+    return {RPIPELINE_STAGE_TRANSFER_BIT, RACCESS_TRANSFER_READ_BIT, RIMAGE_LAYOUT_TRANSFER_SRC, false, false};
+}
+
+} // namespace LD
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <Ludens/DSA/Vector.h>
+#include <Ludens/RenderBackend/RBackend.h>
+
+#include <cstdint>
+
+namespace LD {
+
+/// @brief How a pass accesses an image.
+struct RGraphImageAccess
+{
+    RPipelineStageFlags stages; /// pipeline stages the image is accessed in
+    RAccessFlags access;        /// memory access types, read or write
+    RImageLayout layout;        /// layout the image must be in during the pass
+    bool isWrite;               /// whether the pass writes to the image
+    bool isDiscard;             /// whether the pass overwrites the image without reading previous contents
+};
+
+/// @brief Synchronization state of an image, tracked across passes and frames.
+struct RGraphImageSync
+{
+    RImageLayout layout = RIMAGE_LAYOUT_UNDEFINED; /// current image layout
+    RPipelineStageFlags writeStages = 0;          /// stages of the last write or layout transition
+    RAccessFlags writeAccess = 0;                 /// access of the last write, made available by the next barrier
+    RPipelineStageFlags readStages = 0;           /// stages that read the image since the last write
+    RPipelineStageFlags visibleStages = 0;        /// stages the last write is already visible to
+    RAccessFlags visibleAccess = 0;               /// access types the last write is already visible to
+
+    bool operator==(const RGraphImageSync& other) const = default;
+};
+
+/// @brief A barrier required before an image access, stages are kept per image
+///        until barriers of the same pass are merged.
+struct RGraphImageBarrier
+{
+    uint32_t image; /// user index of the image
+    RPipelineStageFlags srcStages;
+    RPipelineStageFlags dstStages;
+    RAccessFlags srcAccess;
+    RAccessFlags dstAccess;
+    RImageLayout oldLayout;
+    RImageLayout newLayout;
+};
+
+/// @brief All barriers at a pass boundary, recorded as a single pipeline barrier.
+struct RGraphBarrierBatch
+{
+    RPipelineStageFlags srcStages = 0;
+    RPipelineStageFlags dstStages = 0;
+    Vector<RGraphImageBarrier> barriers;
+
+    inline bool empty() const { return barriers.empty(); }
+    inline void clear() { srcStages = dstStages = 0, barriers.clear(); }
+};
+
+/// @brief Update the image synchronization state for an access, returns true if a barrier is
+///        required before the access. Read after read in the same layout never requires a barrier,
+///        read after write only if the write is not yet visible to the reading stage,
+///        write after read in the same layout only requires an execution dependency once the
+///        last write is visible to the readers.
+bool sync_image_access(RGraphImageSync& sync, const RGraphImageAccess& access, uint32_t image, RGraphImageBarrier& barrier);
+
+/// @brief Reset the synchronization state of an image whose memory may alias other images.
+///        The next access waits for all attachment and shader writes to the memory.
+void sync_image_aliased(RGraphImageSync& sync);
+
+/// @brief Add a barrier to the batch of a pass boundary.
+void merge_image_barrier(RGraphBarrierBatch& batch, const RGraphImageBarrier& barrier);
+
+/// @brief Image access of a render graph image usage in a graphics or compute pass.
+RGraphImageAccess get_color_attachment_access(bool isDiscard);
+RGraphImageAccess get_depth_stencil_attachment_access(bool isDiscard);
+RGraphImageAccess get_sampled_access();
+RGraphImageAccess get_storage_read_only_access();
+RGraphImageAccess get_transfer_src_access();
+
+} // namespace LD
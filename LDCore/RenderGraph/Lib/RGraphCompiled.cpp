@@ -0,0 +1,56 @@
+#include <Ludens/Header/Assert.h>
+
+#include "RGraphCompiled.h"
+
+namespace LD {
+
+bool RGraphCompiled::begin_barriers(bool isReuse)
+{
+    bool isReplay = isReuse && hasBarriers;
+
+    for (size_t i = 0; isReplay && i < syncBegin.size(); i++)
+    {
+        const auto& [sync, state] = syncBegin[i];
+        isReplay = *sync == state;
+    }
+
+    if (isReplay)
+        stats.replayCount++;
+    else
+        invalidate_barriers();
+
+    return isReplay;
+}
+
+uint32_t RGraphCompiled::push_barriers(RGraphCompiledBarriers&& boundary)
+{
+    barriers.push_back(std::move(boundary));
+
+    return (uint32_t)barriers.size() - 1;
+}
+
+const RGraphCompiledBarriers& RGraphCompiled::replay_barriers(uint32_t index)
+{
+    LD_ASSERT(index < barriers.size());
+    const RGraphCompiledBarriers& boundary = barriers[index];
+
+    for (const auto& [sync, state] : boundary.updates)
+        *sync = state;
+
+    return boundary;
+}
+
+void RGraphCompiled::invalidate_barriers()
+{
+    barriers.clear();
+    syncBegin.clear();
+    hasBarriers = false;
+}
+
+void RGraphCompiled::invalidate()
+{
+    invalidate_barriers();
+    isValid = false;
+}
+
+} // namespace LD
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <Ludens/DSA/Vector.h>
+#include <Ludens/Header/Hash.h>
+#include <Ludens/RenderBackend/RBackend.h>
+#include <Ludens/RenderGraph/RGraph.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+#include "RGraphBarrier.h"
+
+namespace LD {
+
+/// @brief Barriers recorded at a single pass boundary.
+struct RGraphCompiledBarriers
+{
+    RGraphBarrierBatch batch;
+    Vector<RImage> images;                                        /// images referenced by batch
+    Vector<std::pair<RGraphImageSync*, RGraphImageSync>> updates; /// image sync states after the barriers
+};
+
+/// @brief Compiled graph of the last submission. Components declare the same structure
+///        in most frames, in which case the pass order, transient image placement and
+///        barriers are reused instead of compiled again.
+struct RGraphCompiled
+{
+    std::size_t structureHash = 0;
+    bool isValid = false;
+    Vector<std::pair<Hash32, Hash32>> passOrder;                    /// component name and pass name in sorted order
+    Vector<RGraphCompiledBarriers> barriers;                        /// barriers at each pass boundary of the last recording
+    Vector<std::pair<RGraphImageSync*, RGraphImageSync>> syncBegin; /// image sync states the barriers were recorded from
+    bool hasBarriers = false;
+    RGraphCompileStats stats{};
+
+    /// @brief Check if the compiled pass order is reused for the declared structure.
+    inline bool is_reuse(std::size_t hash) const { return isValid && structureHash == hash; }
+
+    /// @brief Begin a recording. Barriers of the last recording are replayed only if the structure
+    ///        is reused and every image starts from the sync state they were recorded from,
+    ///        otherwise they are discarded and recorded again.
+    /// @return True if barriers are replayed.
+    bool begin_barriers(bool isReuse);
+
+    /// @brief Save the sync state of an image before its first access in a recording.
+    inline void save_sync_begin(RGraphImageSync* sync) { syncBegin.push_back({sync, *sync}); }
+
+    /// @brief Append the barriers of the next pass boundary.
+    /// @return Index of the pass boundary.
+    uint32_t push_barriers(RGraphCompiledBarriers&& boundary);
+
+    /// @brief Apply the image sync states after the barriers of a replayed pass boundary.
+    const RGraphCompiledBarriers& replay_barriers(uint32_t index);
+
+    /// @brief Recorded barriers reference physical images, they can not be reused once images are recreated.
+    void invalidate_barriers();
+
+    /// @brief Compile the graph again on the next submission.
+    void invalidate();
+};
+
+} // namespace LD
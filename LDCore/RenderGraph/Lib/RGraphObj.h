@@ -7,6 +7,7 @@
 #include <Ludens/RenderGraph/RGraph.h>
 
 #include "RComponent.h"
+#include "RGraphBarrier.h"
 
 namespace LD {
 
@@ -17,6 +18,18 @@ struct RGraphSwapchain
     RGraphImageObj* blitSrc = nullptr;
 };
 
+/// @brief Commands of a pass, prepared in pass order on the calling thread,
+///        then recorded into a command list, possibly on a job system thread.
+struct RGraphPassRecord
+{
+    RComponentPassObj* pass;
+    uint32_t barrierIndex;                /// barriers at the pass boundary in the compiled graph
+    Vector<RImage> colorHandles;          /// graphics pass color attachments
+    Vector<RImage> resolveHandles;        /// graphics pass resolve attachments, if multi-sampled
+    Vector<RClearColorValue> clearColors; /// graphics pass color attachment clear values
+    RPassBeginInfo passBI;                /// graphics pass begin info, referencing the vectors above
+};
+
 enum RGraphState
 {
     RGRAPH_STATE_CREATED = 0,
@@ -28,20 +41,35 @@ struct RGraphObj
 {
     RDevice device;
     RCommandList list;
+    Vector<RCommandList> passLists;
     RFence frameComplete;
     RGraphCommandListCallback prePassCB = nullptr;
     RGraphCommandListCallback preSubmitCB = nullptr;
     HashMap<Hash32, RComponent> components;
     Vector<RComponentPassObj*> passOrder;
+    Vector<RGraphPassRecord> passRecords; /// parallel to passOrder
     HashMap<WindowID, RGraphSwapchain> swapchains;
     uint32_t screenWidth;
     uint32_t screenHeight;
     RGraphState graphState = RGRAPH_STATE_CREATED;
+    RGraphBarrierBatch barrierBatch;                                  /// barriers before the next pass
+    Vector<RImage> barrierImages;                                     /// images referenced by barrierBatch
+    Vector<std::pair<RGraphImageSync*, RGraphImageSync>> syncUpdates; /// image sync states after barrierBatch
+    HashSet<RGraphImageSync*> syncTouched;                            /// images synchronized in this recording
+    bool isBarrierReplay = false;                                     /// replaying barriers compiled in a previous frame
+    uint32_t barrierFlushIndex = 0;                                   /// next pass boundary to replay
+    std::size_t structureHash = 0;                                    /// hash of swapchains and connections between components
     void* user = nullptr;
 
     void sort();
-    void record_compute_pass(RComputePassObj* pass, uint32_t passIdx);
-    void record_graphics_pass(RGraphicsPassObj* pass, uint32_t passIdx);
+    std::size_t get_structure_hash();
+    void place_transient_images();
+    void sync_image(RGraphImageSync& sync, RImage image, const RGraphImageAccess& access);
+    uint32_t flush_barriers();
+    void prepare_compute_pass(RComputePassObj* pass, RGraphPassRecord& record);
+    void prepare_graphics_pass(RGraphicsPassObj* pass, RGraphPassRecord& record);
+    void record_passes(RCommandList list, uint32_t passBegin, uint32_t passEnd);
+    bool record_passes_parallel();
 };
 
 } // namespace LD
\ No newline at end of file
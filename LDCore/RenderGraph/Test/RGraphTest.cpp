@@ -1,5 +1,9 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #include <Extra/doctest/doctest.h>
+#include <LDCore/RenderGraph/Lib/RGraphAlias.h>
+#include <LDCore/RenderGraph/Lib/RGraphBarrier.h>
+#include <LDCore/RenderGraph/Lib/RGraphCompiled.h>
+#include <LDCore/RenderGraph/Lib/RGraphObj.h>
 #include <Ludens/RenderGraph/RGraph.h>
 
 using namespace LD;
@@ -48,4 +52,402 @@ TEST_CASE("RGraph basic")
     CHECK(order[1] == c1gp1);
 
     RGraph::destroy(graph);
-}
\ No newline at end of file
+}
+
+static std::size_t get_declared_structure_hash(uint32_t width, RAttachmentLoadOp loadOp)
+{
+    RGraphInfo graphI{};
+    RGraph graph = RGraph::create(graphI);
+
+    RComponent c1 = graph.add_component("c1");
+    RGraphImage c1color = c1.add_private_image("color", RFORMAT_RGBA8, width, 512, nullptr);
+    RGraphImage c1out = c1.add_output_image("out", RFORMAT_RGBA8, width, 512, nullptr);
+    RGraphicsPassInfo gpI{};
+    gpI.width = width;
+    gpI.height = 512;
+    gpI.name = "gp1";
+    gpI.samples = RSAMPLE_COUNT_1_BIT;
+    RGraphicsPass c1gp1 = c1.add_graphics_pass(gpI, nullptr, nullptr);
+    c1gp1.use_color_attachment(c1color, loadOp, nullptr);
+    gpI.name = "gp2";
+    RGraphicsPass c1gp2 = c1.add_graphics_pass(gpI, nullptr, nullptr);
+    c1gp2.use_image_sampled(c1color);
+    c1gp2.use_color_attachment(c1out, RATTACHMENT_LOAD_OP_DONT_CARE, nullptr);
+
+    RComponent c2 = graph.add_component("c2");
+    RGraphImage c2in = c2.add_input_image("in", RFORMAT_RGBA8, width, 512);
+    RGraphicsPass c2gp1 = c2.add_graphics_pass(gpI, nullptr, nullptr);
+    c2gp1.use_color_attachment(c2in, RATTACHMENT_LOAD_OP_LOAD, nullptr);
+    graph.connect_image(c1out, c2in);
+
+    std::size_t hash = graph.unwrap()->get_structure_hash();
+    RGraph::destroy(graph);
+
+    return hash;
+}
+
+TEST_CASE("RGraph structure hash")
+{
+    std::size_t hash = get_declared_structure_hash(512, RATTACHMENT_LOAD_OP_DONT_CARE);
+
+    // same declarations in another frame
+    CHECK(hash == get_declared_structure_hash(512, RATTACHMENT_LOAD_OP_DONT_CARE));
+
+    // image dimensions and image usages are part of the structure
+    CHECK(hash != get_declared_structure_hash(1024, RATTACHMENT_LOAD_OP_DONT_CARE));
+    CHECK(hash != get_declared_structure_hash(512, RATTACHMENT_LOAD_OP_LOAD));
+}
+
+// one submission of a graph where pass 0 clears an image and pass 1 samples it,
+// barriers are compiled or replayed in the same steps as RGraph::submit.
+static bool submit_compiled(RGraphCompiled& compiled, std::size_t structureHash, RGraphImageSync& sync)
+{
+    const bool isReuse = compiled.is_reuse(structureHash);
+
+    if (isReuse)
+        compiled.stats.reuseCount++;
+    else
+    {
+        compiled.structureHash = structureHash;
+        compiled.isValid = true;
+        compiled.stats.compileCount++;
+    }
+
+    const bool isReplay = compiled.begin_barriers(isReuse);
+
+    // images may only be recreated while barriers are being recorded
+    CHECK((isReplay || !compiled.hasBarriers));
+
+    const RGraphImageAccess accesses[2] = {get_color_attachment_access(true), get_sampled_access()};
+
+    for (uint32_t i = 0; i < 2; i++)
+    {
+        if (isReplay)
+        {
+            compiled.replay_barriers(i);
+            continue;
+        }
+
+        if (i == 0)
+            compiled.save_sync_begin(&sync);
+
+        RGraphCompiledBarriers boundary;
+        RGraphImageBarrier barrier;
+        if (sync_image_access(sync, accesses[i], 0, barrier))
+        {
+            merge_image_barrier(boundary.batch, barrier);
+            boundary.images.push_back({});
+        }
+        boundary.updates.push_back({&sync, sync});
+
+        CHECK(compiled.push_barriers(std::move(boundary)) == i);
+    }
+
+    compiled.hasBarriers = true;
+    return isReplay;
+}
+
+TEST_CASE("RGraph compiled barrier replay")
+{
+    RGraphCompiled compiled;
+    RGraphImageSync sync;
+    const std::size_t hash = 42;
+
+    // first frame compiles, second frame starts from another layout and records again
+    CHECK(!submit_compiled(compiled, hash, sync));
+    CHECK(!submit_compiled(compiled, hash, sync));
+    CHECK(compiled.stats.compileCount == 1);
+    CHECK(compiled.stats.reuseCount == 1);
+    CHECK(compiled.stats.replayCount == 0);
+
+    // steady state, barriers are replayed and leave the image in the same state
+    RGraphImageSync recorded = sync;
+    CHECK(submit_compiled(compiled, hash, sync));
+    CHECK(submit_compiled(compiled, hash, sync));
+    CHECK(sync == recorded);
+    CHECK(compiled.barriers.size() == 2);
+    CHECK(compiled.stats.replayCount == 2);
+
+    // replayed clear waits for the sampling of the previous frame
+    const RGraphBarrierBatch& clear = compiled.barriers[0].batch;
+    REQUIRE(clear.barriers.size() == 1);
+    CHECK(clear.barriers[0].srcStages == RPIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    CHECK(clear.barriers[0].newLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+}
+
+TEST_CASE("RGraph compiled barrier invalidation")
+{
+    RGraphCompiled compiled;
+    RGraphImageSync sync;
+    const std::size_t hash = 42;
+
+    submit_compiled(compiled, hash, sync);
+    submit_compiled(compiled, hash, sync);
+    REQUIRE(submit_compiled(compiled, hash, sync));
+
+    // a recreated image starts from an undefined layout, barriers are recorded again
+    sync = {};
+    CHECK(!submit_compiled(compiled, hash, sync));
+    CHECK(compiled.barriers.size() == 2);
+    CHECK(compiled.barriers[0].batch.barriers[0].oldLayout == RIMAGE_LAYOUT_UNDEFINED);
+
+    // structure change compiles the graph again
+    submit_compiled(compiled, hash, sync);
+    REQUIRE(submit_compiled(compiled, hash, sync));
+    CHECK(!submit_compiled(compiled, hash + 1, sync));
+    CHECK(compiled.stats.compileCount == 2);
+    CHECK(compiled.barriers.size() == 2);
+
+    // transient image replanning discards barriers but keeps the pass order
+    compiled.invalidate_barriers();
+    CHECK(compiled.is_reuse(hash + 1));
+    CHECK(!compiled.hasBarriers);
+    CHECK(compiled.barriers.empty());
+    CHECK(compiled.syncBegin.empty());
+    CHECK(!submit_compiled(compiled, hash + 1, sync));
+
+    // release compiles the graph again on the next submission
+    compiled.invalidate();
+    CHECK(!compiled.is_reuse(hash + 1));
+    CHECK(!submit_compiled(compiled, hash + 1, sync));
+    CHECK(compiled.stats.compileCount == 3);
+}
+
+TEST_CASE("RGraph transient aliasing disjoint lifetimes")
+{
+    Vector<RGraphTransientImage> images = {
+        {0, 1, 1024, 256, 0b1},
+        {2, 3, 1024, 256, 0b1},
+        {4, 4, 512, 256, 0b1},
+    };
+
+    RGraphAliasPlan plan;
+    plan_transient_aliasing(images, plan);
+
+    CHECK(plan.heaps.size() == 1);
+    CHECK(plan.heaps[0].size == 1024);
+    for (const RGraphAliasPlacement& placement : plan.placements)
+    {
+        CHECK(placement.heapIndex == 0);
+        CHECK(placement.offset == 0);
+    }
+    CHECK(plan.unaliasedSize == 2560);
+    CHECK(plan.aliasedSize == 1024);
+}
+
+TEST_CASE("RGraph transient aliasing overlapping lifetimes")
+{
+    Vector<RGraphTransientImage> images = {
+        {0, 2, 1024, 256, 0b1},
+        {1, 3, 1024, 256, 0b1},
+        {2, 4, 256, 256, 0b1},
+        {3, 4, 512, 256, 0b1},
+    };
+
+    RGraphAliasPlan plan;
+    plan_transient_aliasing(images, plan);
+
+    // live images never share a memory range
+    for (size_t i = 0; i < images.size(); i++)
+    {
+        for (size_t j = i + 1; j < images.size(); j++)
+        {
+            bool isLifetimeOverlap = images[i].firstPass <= images[j].lastPass && images[j].firstPass <= images[i].lastPass;
+            if (!isLifetimeOverlap || plan.placements[i].heapIndex != plan.placements[j].heapIndex)
+                continue;
+
+            uint64_t iBegin = plan.placements[i].offset;
+            uint64_t jBegin = plan.placements[j].offset;
+            CHECK((iBegin + images[i].size <= jBegin || jBegin + images[j].size <= iBegin));
+        }
+    }
+
+    // the last image reuses the range of the first image after its lifetime ends
+    CHECK(plan.placements[3].heapIndex == plan.placements[0].heapIndex);
+    CHECK(plan.placements[3].offset == plan.placements[0].offset);
+    CHECK(plan.aliasedSize < plan.unaliasedSize);
+}
+
+TEST_CASE("RGraph transient aliasing alignment")
+{
+    Vector<RGraphTransientImage> images = {
+        {0, 1, 1000, 8, 0b1},
+        {0, 1, 100, 512, 0b1},
+    };
+
+    RGraphAliasPlan plan;
+    plan_transient_aliasing(images, plan);
+
+    CHECK(plan.placements[1].offset % 512 == 0);
+    CHECK(plan.heaps.size() == 2);
+}
+
+TEST_CASE("RGraph transient aliasing memory types")
+{
+    Vector<RGraphTransientImage> images = {
+        {0, 0, 1024, 256, 0b01},
+        {1, 1, 1024, 256, 0b10},
+        {2, 2, 1024, 256, 0b11},
+    };
+
+    RGraphAliasPlan plan;
+    plan_transient_aliasing(images, plan);
+
+    CHECK(plan.heaps.size() == 2);
+    CHECK(plan.placements[0].heapIndex != plan.placements[1].heapIndex);
+    CHECK((plan.heaps[plan.placements[2].heapIndex].typeBits & 0b11) != 0);
+    CHECK(plan.heaps[0].typeBits == 0b01);
+    CHECK(plan.heaps[1].typeBits == 0b10);
+}
+
+/// @brief Records the barrier batch at each pass boundary of a synthetic graph, without a GPU.
+struct BarrierRecorder
+{
+    Vector<RGraphImageSync> images;
+    Vector<RGraphBarrierBatch> batches;
+
+    BarrierRecorder(uint32_t imageCount)
+        : images(imageCount)
+    {
+    }
+
+    const RGraphBarrierBatch& pass(std::initializer_list<std::pair<uint32_t, RGraphImageAccess>> accesses)
+    {
+        RGraphBarrierBatch& batch = batches.emplace_back();
+
+        for (const auto& [image, access] : accesses)
+        {
+            RGraphImageBarrier barrier;
+            if (sync_image_access(images[image], access, image, barrier))
+                merge_image_barrier(batch, barrier);
+        }
+
+        return batch;
+    }
+};
+
+TEST_CASE("RGraph barrier read after write")
+{
+    BarrierRecorder rec(2);
+
+    // pass 0 clears A
+    const RGraphBarrierBatch& b0 = rec.pass({{0, get_color_attachment_access(true)}});
+    REQUIRE(b0.barriers.size() == 1);
+    CHECK(b0.barriers[0].oldLayout == RIMAGE_LAYOUT_UNDEFINED);
+    CHECK(b0.barriers[0].newLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+    CHECK(b0.barriers[0].srcStages == RPIPELINE_STAGE_TOP_OF_PIPE_BIT);
+    CHECK(b0.barriers[0].srcAccess == 0);
+
+    // pass 1 samples A and clears B, both barriers merged at the pass boundary
+    const RGraphBarrierBatch& b1 = rec.pass({{0, get_sampled_access()}, {1, get_color_attachment_access(true)}});
+    REQUIRE(b1.barriers.size() == 2);
+    CHECK(b1.barriers[0].image == 0);
+    CHECK(b1.barriers[0].oldLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+    CHECK(b1.barriers[0].newLayout == RIMAGE_LAYOUT_SHADER_READ_ONLY);
+    CHECK(b1.barriers[0].srcStages == RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    CHECK(b1.barriers[0].dstStages == RPIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    CHECK(b1.barriers[0].srcAccess == RACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    CHECK(b1.barriers[0].dstAccess == RACCESS_SHADER_READ_BIT);
+    CHECK(b1.barriers[1].image == 1);
+    CHECK(b1.srcStages == (RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT | RPIPELINE_STAGE_TOP_OF_PIPE_BIT));
+    CHECK(b1.dstStages == (RPIPELINE_STAGE_FRAGMENT_SHADER_BIT | RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+
+    // pass 2 samples A and B, A is already visible to fragment shaders
+    const RGraphBarrierBatch& b2 = rec.pass({{0, get_sampled_access()}, {1, get_sampled_access()}});
+    REQUIRE(b2.barriers.size() == 1);
+    CHECK(b2.barriers[0].image == 1);
+
+    // read after read in the same layout
+    CHECK(rec.pass({{0, get_sampled_access()}, {1, get_sampled_access()}}).empty());
+}
+
+TEST_CASE("RGraph barrier write after read")
+{
+    BarrierRecorder rec(1);
+
+    rec.pass({{0, get_color_attachment_access(true)}});
+    rec.pass({{0, get_sampled_access()}});
+
+    // next frame overwrites A, only waits for the fragment shader reads
+    const RGraphBarrierBatch& b = rec.pass({{0, get_color_attachment_access(true)}});
+    REQUIRE(b.barriers.size() == 1);
+    CHECK(b.barriers[0].srcStages == RPIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    CHECK(b.barriers[0].srcAccess == 0);
+    CHECK(b.barriers[0].oldLayout == RIMAGE_LAYOUT_UNDEFINED);
+    CHECK(b.barriers[0].newLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+}
+
+TEST_CASE("RGraph barrier write after read in the same layout")
+{
+    BarrierRecorder rec(1);
+    RGraphImageAccess storageWrite{RPIPELINE_STAGE_COMPUTE_SHADER_BIT, RACCESS_SHADER_WRITE_BIT, RIMAGE_LAYOUT_GENERAL, true, false};
+    RGraphImageAccess storageRead{RPIPELINE_STAGE_FRAGMENT_SHADER_BIT, RACCESS_SHADER_READ_BIT, RIMAGE_LAYOUT_GENERAL, false, false};
+
+    rec.pass({{0, storageWrite}});
+
+    // the write is not yet visible to the second write
+    const RGraphBarrierBatch& b0 = rec.pass({{0, storageWrite}});
+    REQUIRE(b0.barriers.size() == 1);
+    CHECK(b0.barriers[0].srcStages == RPIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    CHECK(b0.barriers[0].srcAccess == RACCESS_SHADER_WRITE_BIT);
+
+    const RGraphBarrierBatch& b1 = rec.pass({{0, storageRead}});
+    REQUIRE(b1.barriers.size() == 1);
+    CHECK(b1.barriers[0].srcStages == RPIPELINE_STAGE_COMPUTE_SHADER_BIT);
+    CHECK(b1.barriers[0].srcAccess == RACCESS_SHADER_WRITE_BIT);
+
+    // the write is ordered before the fragment shader reads, only an execution dependency remains
+    const RGraphBarrierBatch& b2 = rec.pass({{0, storageWrite}});
+    REQUIRE(b2.barriers.size() == 1);
+    CHECK(b2.barriers[0].srcStages == RPIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+    CHECK(b2.barriers[0].srcAccess == 0);
+    CHECK(b2.barriers[0].oldLayout == RIMAGE_LAYOUT_GENERAL);
+    CHECK(b2.barriers[0].newLayout == RIMAGE_LAYOUT_GENERAL);
+}
+
+TEST_CASE("RGraph barrier write after write")
+{
+    BarrierRecorder rec(1);
+
+    rec.pass({{0, get_color_attachment_access(true)}});
+
+    // loading previous contents keeps the layout, no transition
+    const RGraphBarrierBatch& b = rec.pass({{0, get_color_attachment_access(false)}});
+    REQUIRE(b.barriers.size() == 1);
+    CHECK(b.barriers[0].oldLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+    CHECK(b.barriers[0].newLayout == RIMAGE_LAYOUT_COLOR_ATTACHMENT);
+    CHECK(b.barriers[0].srcStages == RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
+    CHECK(b.barriers[0].srcAccess == RACCESS_COLOR_ATTACHMENT_WRITE_BIT);
+    CHECK(b.barriers[0].dstAccess == (RACCESS_COLOR_ATTACHMENT_READ_BIT | RACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+}
+
+TEST_CASE("RGraph barrier readers in different stages")
+{
+    BarrierRecorder rec(1);
+
+    rec.pass({{0, get_color_attachment_access(true)}});
+    rec.pass({{0, get_storage_read_only_access()}});
+
+    // already in general layout and visible to compute shaders
+    CHECK(rec.pass({{0, get_storage_read_only_access()}}).empty());
+
+    // sampling needs a layout transition after the compute reads
+    const RGraphBarrierBatch& b = rec.pass({{0, get_sampled_access()}});
+    REQUIRE(b.barriers.size() == 1);
+    CHECK(b.barriers[0].oldLayout == RIMAGE_LAYOUT_GENERAL);
+    CHECK(b.barriers[0].newLayout == RIMAGE_LAYOUT_SHADER_READ_ONLY);
+    CHECK((b.barriers[0].srcStages & RPIPELINE_STAGE_COMPUTE_SHADER_BIT));
+}
+
+TEST_CASE("RGraph barrier aliased image")
+{
+    BarrierRecorder rec(1);
+
+    sync_image_aliased(rec.images[0]);
+
+    const RGraphBarrierBatch& b = rec.pass({{0, get_depth_stencil_attachment_access(true)}});
+    REQUIRE(b.barriers.size() == 1);
+    CHECK(b.barriers[0].oldLayout == RIMAGE_LAYOUT_UNDEFINED);
+    CHECK((b.barriers[0].srcStages & RPIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT));
+    CHECK((b.barriers[0].srcAccess & RACCESS_COLOR_ATTACHMENT_WRITE_BIT));
+}
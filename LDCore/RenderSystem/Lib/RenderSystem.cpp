@@ -3,6 +3,7 @@
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/Header/Assert.h>
 #include <Ludens/Header/Math/Geometry.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Log/Log.h>
 #include <Ludens/Memory/Allocator.h>
 #include <Ludens/Memory/Memory.h>
@@ -209,6 +210,8 @@ private:
         FrameUBOManager uboManager;
         RBuffer ubo;
         RSet frameSet;
+        Vector<RCommandPool> passPools; /// one pool per render graph pass list
+        Vector<RCommandList> passLists; /// render graph passes recorded on job system threads
     };
 
 private:
@@ -314,12 +317,25 @@ RenderSystemObj::RenderSystemObj(const RenderSystemInfo& systemI)
     mCmdPools.resize(mFramesInFlight);
     mCmdLists.resize(mFramesInFlight);
 
+    // one pass list per thread that may record, each from its own pool
+    uint32_t passListCount = 0;
+    if (systemI.parallelPassRecording && JobSystem::get() && mDevice.get_backend() == RDEVICE_BACKEND_VULKAN)
+        passListCount = (uint32_t)JobSystem::get().get_worker_thread_count() + 1;
+
     for (uint32_t i = 0; i < mFramesInFlight; i++)
     {
         mCmdPools[i] = mDevice.create_command_pool({RQUEUE_TYPE_GRAPHICS});
         mCmdLists[i] = mCmdPools[i].allocate();
 
         Frame& frame = mFrames[i];
+        frame.passPools.resize(passListCount);
+        frame.passLists.resize(passListCount);
+        for (uint32_t j = 0; j < passListCount; j++)
+        {
+            frame.passPools[j] = mDevice.create_command_pool({RQUEUE_TYPE_GRAPHICS});
+            frame.passLists[j] = frame.passPools[j].allocate();
+        }
+
         frame.ubo = mDevice.create_buffer({.usage = RBUFFER_USAGE_UNIFORM_BIT, .size = sizeof(FrameUBO), .hostVisible = true});
         frame.ubo.map();
         frame.frameSet = mFrameSetPool.allocate();
@@ -349,6 +365,9 @@ RenderSystemObj::~RenderSystemObj()
         frame.ubo.unmap();
         mDevice.destroy_buffer(frame.ubo);
         mDevice.destroy_command_pool(mCmdPools[i]);
+
+        for (RCommandPool pool : frame.passPools)
+            mDevice.destroy_command_pool(pool);
     }
 
     mDevice.destroy_set_pool(mFrameSetPool);
@@ -405,9 +424,14 @@ void RenderSystemObj::next_frame(const RenderSystemFrameInfo& frameI)
     RCommandList list = mCmdLists[mFrameIndex];
     Frame& frame = mFrames[mFrameIndex];
 
+    for (RCommandPool pool : frame.passPools)
+        pool.reset();
+
     RGraphInfo graphI{};
     graphI.device = mDevice;
     graphI.list = list;
+    graphI.passListCount = (uint32_t)frame.passLists.size();
+    graphI.passLists = frame.passLists.data();
     graphI.frameComplete = frameComplete;
     graphI.swapchainCount = (uint32_t)swapchains.size();
     graphI.swapchains = swapchains.data();
@@ -1,6 +1,7 @@
 #include <Ludens/Header/Assert.h>
 #include <Ludens/Header/Math/Mat3.h>
 #include <Ludens/Header/Math/Transform.h>
+#include <Ludens/JobSystem/JobSystem.h>
 #include <Ludens/Memory/Memory.h>
 #include <Ludens/Profiler/Profiler.h>
 
@@ -10,6 +11,8 @@
 #include <cstdint>
 #include <cstring>
 
+#define SCREEN_LAYER_BUILD_GRAIN 256
+
 namespace LD {
 
 static_assert(LD::IsTrivial<Sprite2DDrawObj>);
@@ -175,24 +178,37 @@ void ScreenLayerObj::build_items(RenderSystemMat4Callback mat4CB, void* user)
 {
     LD_PROFILE_SCOPE;
 
-    for (ScreenLayerItem& item : mItemList)
-    {
-        LD_ASSERT(item.type == SCREEN_LAYER_ITEM_SPRITE_2D);
+    ScreenLayerItem* items = mItemList.data();
 
-        if (!item.sprite2D->image)
-            continue;
+    // items are independent, bounding spheres of wide layers are built on worker threads
+    auto buildRange = [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; i++)
+        {
+            ScreenLayerItem& item = items[i];
+            LD_ASSERT(item.type == SCREEN_LAYER_ITEM_SPRITE_2D);
+
+            if (!item.sprite2D->image)
+                continue;
+
+            Mat4 modelMat;
+            bool ok = mat4CB(item.sprite2D->id, modelMat, user);
+            float scaleX2 = modelMat[0][0] * modelMat[0][0] + modelMat[0][1] * modelMat[0][1]; 
+            float scaleY2 = modelMat[1][0] * modelMat[1][0] + modelMat[1][1] * modelMat[1][1]; 
+            float halfW = item.sprite2D->region.w / 2.0f;
+            float halfH = item.sprite2D->region.h / 2.0f;
+            Vec4 sphereCenter = modelMat * Vec4(item.sprite2D->get_local_center(), 0.0f, 1.0f);
+            item.sphereX = sphereCenter.x;
+            item.sphereY = sphereCenter.y;
+            item.sphereR2 = std::max(scaleX2, scaleY2) * ((halfW * halfW) + (halfH * halfH));
+        }
+    };
 
-        Mat4 modelMat;
-        bool ok = mat4CB(item.sprite2D->id, modelMat, user);
-        float scaleX2 = modelMat[0][0] * modelMat[0][0] + modelMat[0][1] * modelMat[0][1]; 
-        float scaleY2 = modelMat[1][0] * modelMat[1][0] + modelMat[1][1] * modelMat[1][1]; 
-        float halfW = item.sprite2D->region.w / 2.0f;
-        float halfH = item.sprite2D->region.h / 2.0f;
-        Vec4 sphereCenter = modelMat * Vec4(item.sprite2D->get_local_center(), 0.0f, 1.0f);
-        item.sphereX = sphereCenter.x;
-        item.sphereY = sphereCenter.y;
-        item.sphereR2 = std::max(scaleX2, scaleY2) * ((halfW * halfW) + (halfH * halfH));
-    }
+    JobSystem js = JobSystem::get();
+
+    if (js)
+        js.parallel_for(0, mItemList.size(), SCREEN_LAYER_BUILD_GRAIN, buildRange);
+    else
+        buildRange(0, mItemList.size());
 }
 
 } // namespace LD
\ No newline at end of file
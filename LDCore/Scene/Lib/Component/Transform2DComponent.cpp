@@ -83,8 +83,8 @@ bool Transform2DMeta::load_from_props(SceneObj* scene, ComponentBase** data, con
         }
     }
 
-    auto* dstTransform2D = (Transform2DComponent*)data;
-    *dstTransform2D->transform = transform2D;
+    Transform2DView view(data);
+    view.set_transform_2d(transform2D);
 
     return true;
 }
@@ -24,10 +24,177 @@ namespace LD {
 
 static Log sLog(LUDENS_LUA_SCRIPT_LOG_CHANNEL);
 
+// Script update scheduler, evaluated once during bootstrapping.
+// The returned function is the per-frame dispatch taking delta time as argument.
+static const char sSchedulerChunk[] = R"(
+-- - scripts without an update method are never visited
+-- - every-frame scripts are kept in a dense array
+-- - throttled and sleeping scripts wait in a min-heap of wake times
+-- Entry mode is 0 when removed, 1 when updated every frame, 2 when waiting in the heap.
+-- Dense array and heap entries are removed lazily so scripts may reschedule during update.
+local sched = {
+    time = 0,
+    dense = {},
+    heap = {},
+    entries = {},
+}
+_G.ludens.scheduler = sched
+
+local function heap_push(heap, node)
+    local i = #heap + 1
+    heap[i] = node
+    while i > 1 do
+        local parent = math.floor(i / 2)
+        if heap[parent].wake <= node.wake then
+            break
+        end
+        heap[i] = heap[parent]
+        i = parent
+    end
+    heap[i] = node
+end
+
+local function heap_pop(heap)
+    local top = heap[1]
+    local n = #heap
+    local node = heap[n]
+    heap[n] = nil
+    n = n - 1
+    if n == 0 then
+        return top
+    end
+    local i = 1
+    while true do
+        local child = i * 2
+        if child > n then
+            break
+        end
+        if child < n and heap[child + 1].wake < heap[child].wake then
+            child = child + 1
+        end
+        if node.wake <= heap[child].wake then
+            break
+        end
+        heap[i] = heap[child]
+        i = child
+    end
+    heap[i] = node
+    return top
+end
+
+local function schedule(e, wake)
+    local node = { wake = wake, e = e }
+    e.mode = 2
+    e.node = node
+    heap_push(sched.heap, node)
+end
+
+sched.add = function (script)
+    if type(script.update) ~= 'function' or sched.entries[script] then
+        return
+    end
+    local e = { script = script, mode = 1, interval = 0, last = sched.time, inDense = true }
+    sched.entries[script] = e
+    sched.dense[#sched.dense + 1] = e
+end
+
+sched.remove = function (script)
+    local e = sched.entries[script]
+    if e then
+        e.mode = 0
+        e.node = nil
+        sched.entries[script] = nil
+    end
+end
+
+_G.ludens.script = {
+    -- skip updates for some seconds, the next update receives the elapsed time
+    sleep = function (script, seconds)
+        local e = sched.entries[script]
+        if e then
+            schedule(e, sched.time + seconds)
+        end
+    end,
+    -- update at most hz times per second, zero or nil to update every frame
+    set_tick_rate = function (script, hz)
+        local e = sched.entries[script]
+        if not e then
+            return
+        end
+        e.interval = (hz and hz > 0) and 1 / hz or 0
+        if e.interval > 0 and e.mode == 1 then
+            schedule(e, sched.time + e.interval)
+        end
+    end,
+}
+
+local due = {}
+local dueElapsed = {}
+
+return function (delta)
+    local time = sched.time + delta
+    sched.time = time
+
+    local dense = sched.dense
+    local i = 1
+    while i <= #dense do
+        local e = dense[i]
+        if e.mode == 1 then
+            e.last = time
+            e.script:update(delta)
+        end
+        if e.mode ~= 1 then
+            local n = #dense
+            dense[i] = dense[n]
+            dense[n] = nil
+            e.inDense = false
+        else
+            i = i + 1
+        end
+    end
+
+    -- reschedule all due entries before updating them, entries rescheduled
+    -- by their own update wake no earlier than the next frame
+    local heap = sched.heap
+    local count = 0
+    while heap[1] and heap[1].wake <= time do
+        local node = heap_pop(heap)
+        local e = node.e
+        if e.node == node then
+            e.node = nil
+            count = count + 1
+            due[count] = e
+            dueElapsed[count] = time - e.last
+            e.last = time
+            if e.interval > 0 then
+                local wake = node.wake + e.interval
+                schedule(e, wake > time and wake or time + e.interval)
+            else
+                e.mode = 1
+                if not e.inDense then
+                    e.inDense = true
+                    dense[#dense + 1] = e
+                end
+            end
+        end
+    end
+
+    for k = 1, count do
+        local e = due[k]
+        due[k] = nil
+        if e.mode ~= 0 then
+            e.script:update(dueElapsed[k])
+        end
+    end
+end
+)";
+
 namespace LuaScript {
 
 static inline ComponentBase* get_component_base(LuaState& L, DataRegistry* outReg);
 static void get_or_create_component_ref(LuaState& L, CUID cuid);
+static void schedule_script(LuaState& L, const char* method);
+static bool push_script_chunk(LuaState& L, AssetID scriptAssetID);
 static int component_get_id(lua_State* l);
 static int component_get_name(lua_State* l);
 static int component_set_name(lua_State* l);
@@ -90,6 +257,84 @@ static void get_or_create_component_ref(LuaState& L, CUID cuid)
     LD_ASSERT(L.size() == oldSize + 1);
 }
 
+/// @brief Call ludens.scheduler[method] with the script instance at stack top, does not modify stack.
+static void schedule_script(LuaState& L, const char* method)
+{
+    int oldSize = L.size();
+
+    L.get_global("ludens");
+    L.get_field(-1, "scheduler");
+    L.get_field(-1, method);
+    L.push_value(oldSize);
+
+    LuaError error = L.pcall(1, 0, 0);
+    if (error)
+    {
+        sLog.error("{}", L.to_string(-1));
+    }
+    LD_ASSERT(error == 0);
+
+    L.resize(oldSize);
+}
+
+/// @brief Push the compiled chunk of a script asset. Chunks are cached in ludens.scriptChunks
+///        by asset ID, so components sharing a script compile it once per scene load.
+/// @return True on success, otherwise the error message is pushed instead.
+static bool push_script_chunk(LuaState& L, AssetID scriptAssetID)
+{
+    L.get_global("ludens");
+    L.get_field(-1, "scriptChunks");
+    L.remove(-2);
+    L.push_number((double)(uint32_t)scriptAssetID);
+    L.get_table(-2);
+
+    if (L.get_type(-1) == LUA_TYPE_FN)
+    {
+        L.remove(-2);
+        return true;
+    }
+
+    L.pop(1);
+
+    LuaScriptAsset asset = (LuaScriptAsset)AssetManager::get().get_asset(scriptAssetID, ASSET_TYPE_LUA_SCRIPT);
+    LD_ASSERT(asset);
+
+    // prefer bytecode baked by the asset builder, fall back to source
+    // if it was not baked or was produced by an incompatible LuaJIT build
+    bool isLoaded = false;
+    View bytecode = asset.get_bytecode();
+
+    if (bytecode)
+    {
+        isLoaded = L.load_buffer((const char*)bytecode.data, bytecode.size, "=bytecode");
+
+        if (!isLoaded)
+        {
+            sLog.warn("script asset {} bytecode rejected, compiling from source: {}", (uint32_t)scriptAssetID, L.to_string(-1));
+            L.pop(1);
+        }
+    }
+
+    if (!isLoaded)
+    {
+        View luaSourceV = asset.get_source();
+        String luaSource((char*)luaSourceV.data, luaSourceV.size);
+
+        if (!L.load_buffer(luaSource.c_str(), luaSource.size(), luaSource.c_str()))
+        {
+            L.remove(-2);
+            return false;
+        }
+    }
+
+    L.push_number((double)(uint32_t)scriptAssetID);
+    L.push_value(-2);
+    L.set_table(-4); // ludens.scriptChunks[assetID] = chunk
+    L.remove(-2);
+
+    return true;
+}
+
 /// @brief Component:get_id()
 int component_get_id(lua_State* l)
 {
@@ -500,7 +745,7 @@ LuaModule create_ludens_module()
     return LuaModule::create(modI); // caller destroys
 }
 
-void Context::create(Scene scene)
+void Context::create(Scene scene, const SceneLuaGCInfo& gcI)
 {
     LD_PROFILE_SCOPE;
 
@@ -510,6 +755,13 @@ void Context::create(Scene scene)
     stateI.openLibs = true;
     mL = LuaState::create(stateI);
 
+    mL.gc_set_pause(gcI.pause);
+    mL.gc_set_step_multiplier(gcI.stepMultiplier);
+    mGCStepKB = gcI.stepKB;
+
+    if (mGCStepKB > 0)
+        mL.gc_stop();
+
     LuaModule ludensLuaModule = LuaScript::create_ludens_module();
     ludensLuaModule.load(mL);
     LuaModule::destroy(ludensLuaModule);
@@ -544,6 +796,7 @@ void Context::create(Scene scene)
     // - empty ludens.scripts table
     // - empty ludens.componentRefs table
     // - empty ludnes.assetRefs table
+    // - empty ludens.scriptChunks table, compiled script chunks by asset ID
     // - ComponentRef mechanism
 
     if (!mL.do_string(R"(
@@ -551,6 +804,7 @@ local ffi = require 'ffi'
 _G.ludens.scripts = {}
 _G.ludens.componentRefs = {}
 _G.ludens.assetRefs = {}
+_G.ludens.scriptChunks = {}
 
 _G.ludens.ComponentRef = {
     is_valid = function (compRef)
@@ -565,6 +819,13 @@ _G.ludens.ComponentRef = {
         local cuid = ffi.C.ffi_get_parent_id(compRef.cuid)
         return _G.ludens.create_component_ref(cuid)
     end,
+    get_child_transforms = function (compRef)
+        local count = ffi.C.ffi_get_child_ids(compRef.cuid, nil, 0)
+        local batch = _G.ludens.allocate_transform_2d_batch(count)
+        ffi.C.ffi_get_child_ids(compRef.cuid, batch.cuids, count)
+        batch:gather()
+        return batch
+    end,
     create_child = function (compRef, compType, params)
         return _G.ludens.C.create_child(compRef.cuid, compType, params)
     end,
@@ -581,7 +842,7 @@ _G.ludens.ComponentRef = {
         if k == 'transform' then
             local proxy = rawget(compRef, '__transform_proxy')
             if not proxy then
-                proxy = _G.ludens.create_transform_2d_proxy(compRef.cdata.__private_transform)
+                proxy = _G.ludens.create_transform_2d_proxy(compRef.cuid, compRef.cdata.__private_transform)
                 rawset(compRef, '__transform_proxy', proxy)
             end
             return proxy
@@ -593,12 +854,13 @@ _G.ludens.ComponentRef = {
         if k == 'transform' then -- deep copy
             local proxy = rawget(compRef, '__transform_proxy')
             if not proxy then
-                proxy = _G.ludens.create_transform_2d_proxy(compRef.cdata.__private_transform)
+                proxy = _G.ludens.create_transform_2d_proxy(compRef.cuid, compRef.cdata.__private_transform)
                 rawset(compRef, '__transform_proxy', proxy)
             end
             local dst = proxy.__ptr
             local src = v.__ptr
             ffi.copy(dst, src, ffi.sizeof('Transform2D'))
+            ffi.C.ffi_mark_transform_dirty(compRef.cuid)
             return
         end
 
@@ -662,26 +924,111 @@ _G.ludens.get_or_create_asset_ref = function (suid)
 end
 
 -- Proxy for Transform2D* to prevent shallow copy
+-- - reads never mark the transform dirty, writes mark it dirty for the next invalidation
+-- - position and scale are returned as Vec2 proxies, writing through them marks the
+--   owning transform dirty even if the proxy is kept across frames
 _G.ludens.Transform2DProxy = {
     __index = function (self, k)
-        local ptr = rawget(self, "__ptr")
-        return ptr[0][k]
+        if k == 'position' or k == 'scale' then
+            local key = '__' .. k .. '_proxy'
+            local proxy = rawget(self, key)
+            if not proxy then
+                proxy = setmetatable({ __cuid = rawget(self, "__cuid"), __ptr = rawget(self, "__ptr"), __field = k }, _G.ludens.Vec2Proxy)
+                rawset(self, key, proxy)
+            end
+            return proxy
+        end
+        return rawget(self, "__ptr")[0][k]
     end,
     __newindex = function (self, k, v)
         local ptr = rawget(self, "__ptr")
-        ptr[0][k] = v
+        if getmetatable(v) == _G.ludens.Vec2Proxy then
+            ptr[0][k].x = v.x
+            ptr[0][k].y = v.y
+        else
+            ptr[0][k] = v
+        end
+        ffi.C.ffi_mark_transform_dirty(rawget(self, "__cuid"))
     end,
 }
 
-_G.ludens.create_transform_2d_proxy = function (transform2DPtr)
-    return setmetatable({ __ptr = transform2DPtr }, _G.ludens.Transform2DProxy)
+-- Proxy for a Vec2 member of Transform2D, arithmetic returns Vec2 copies
+_G.ludens.Vec2Proxy = {
+    __index = function (self, k)
+        return rawget(self, "__ptr")[0][rawget(self, "__field")][k]
+    end,
+    __newindex = function (self, k, v)
+        rawget(self, "__ptr")[0][rawget(self, "__field")][k] = v
+        ffi.C.ffi_mark_transform_dirty(rawget(self, "__cuid"))
+    end,
+    __add = function (lhs, rhs) return _G.ludens.math.Vec2(lhs.x + rhs.x, lhs.y + rhs.y) end,
+}
+
+_G.ludens.create_transform_2d_proxy = function (cuid, transform2DPtr)
+    return setmetatable({ __cuid = cuid, __ptr = transform2DPtr }, _G.ludens.Transform2DProxy)
+end
+
+-- Batched Transform2D access for scripts touching many components
+-- - gather copies the local transforms into a contiguous Transform2D array in one FFI call
+-- - scripts mutate batch.transforms[0 .. batch.count - 1] in place without crossing into C++
+-- - commit writes the array back and marks all transforms dirty in one FFI call
+_G.ludens.Transform2DBatch = {
+    gather = function (batch)
+        ffi.C.ffi_gather_transforms_2d(batch.cuids, batch.transforms, batch.count)
+    end,
+    commit = function (batch)
+        ffi.C.ffi_commit_transforms_2d(batch.cuids, batch.transforms, batch.count)
+    end,
+}
+_G.ludens.Transform2DBatch.__index = _G.ludens.Transform2DBatch
+
+_G.ludens.allocate_transform_2d_batch = function (count)
+    local batch = { count = count }
+    batch.cuids = ffi.new('void*[?]', count)
+    batch.transforms = ffi.new('Transform2D[?]', count)
+    return setmetatable(batch, _G.ludens.Transform2DBatch)
 end
+
+-- accepts a list of ComponentRefs or component IDs
+_G.ludens.create_transform_2d_batch = function (compRefs)
+    local batch = _G.ludens.allocate_transform_2d_batch(#compRefs)
+    for i = 1, batch.count do
+        local ref = compRefs[i]
+        batch.cuids[i - 1] = type(ref) == 'table' and ref.cuid or ref
+    end
+    batch:gather()
+    return batch
+end
+
+-- Proxy for UI widgets, assigning a function installs a widget callback
+_G.ludens.WidgetProxy = {
+    __newindex = function (proxy, k, v)
+        if type(k) == 'string' and type(v) == 'function' then
+            _G.ludens.ui_driver.install_callback(proxy.__widget, k, v)
+            return
+        end
+        rawset(proxy, k, v)
+    end,
+}
 )"))
     {
         sLog.error("Bootstrapping failed: {}", mL.to_string(-1));
         LD_UNREACHABLE;
     }
 
+    // Compile per-frame dispatch once and keep it in the registry,
+    // script update cost is then independent of the Lua compiler.
+    // - ludens.scheduler tracks scripts with an update method
+    // - ludens.script.sleep and ludens.script.set_tick_rate for scripts
+
+    if (!mL.load_buffer(sSchedulerChunk, sizeof(sSchedulerChunk) - 1, "=ludens.scheduler") || mL.pcall(0, 1, 0) != 0)
+    {
+        sLog.error("scheduler initialization failed: {}", mL.to_string(-1));
+        LD_UNREACHABLE;
+    }
+
+    mUpdateRef = mL.ref(mL.get_registry_index());
+
     mL.clear();
 }
 
@@ -689,6 +1036,11 @@ void Context::destroy()
 {
     LD_PROFILE_SCOPE;
 
+    mL.unref(mL.get_registry_index(), mUpdateRef);
+    mUpdateRef = 0;
+
+    sLog.debug("lua heap {} KB, peak {} KB", mL.get_memory_size() / 1024, mL.get_peak_memory_size() / 1024);
+
     LuaState::destroy(mL);
     mL = {};
     mScene = {};
@@ -704,17 +1056,30 @@ bool Context::update(float delta, String& err)
     mL.push_number((double)delta);
     mL.set_field(-2, "delta");
 
-    bool success = mL.do_string(R"(local ffi = require 'ffi'
-for cuid, script in pairs(_G.ludens.scripts) do
-    script:update(_G.ludens.delta)
-end
-)");
+    // invoke precompiled dispatch chunk
+    mL.push_integer(mUpdateRef);
+    mL.get_table(mL.get_registry_index());
+    LD_ASSERT(mL.get_type(-1) == LUA_TYPE_FN);
+    mL.push_number((double)delta);
 
+    LuaError luaError;
+    {
+        LD_PROFILE_SCOPE_NAME("LuaScript dispatch");
+        luaError = mL.pcall(1, 0, 0);
+    }
+
+    bool success = luaError == 0;
     if (!success)
         err = mL.to_string(-1);
 
     mL.resize(oldSize);
 
+    if (mGCStepKB > 0)
+    {
+        LD_PROFILE_SCOPE_NAME("LuaScript GC step");
+        mL.gc_step(mGCStepKB);
+    }
+
     return success;
 }
 
@@ -760,14 +1125,15 @@ bool Context::create_lua_script(CUID compID, AssetID scriptAssetID, String& err)
     mL.get_field(-1, "scripts");
     mL.push_light_userdata(reinterpret_cast<void*>((uint64_t)compID));
 
-    LuaScriptAsset asset = (LuaScriptAsset)AssetManager::get().get_asset(scriptAssetID, ASSET_TYPE_LUA_SCRIPT);
-    LD_ASSERT(asset);
-
-    View luaSourceV = asset.get_source();
-    String luaSource((char*)luaSourceV.data, luaSourceV.size);
+    if (!push_script_chunk(mL, scriptAssetID))
+    {
+        err = mL.to_string(-1);
+        mL.resize(oldSize);
+        return false;
+    }
 
-    // this should push the script instance table onto stack
-    if (!mL.do_string(luaSource.c_str()))
+    // each chunk invocation should push a new script instance table onto stack
+    if (mL.pcall(0, 1, 0) != 0)
     {
         err = mL.to_string(-1);
         mL.resize(oldSize);
@@ -789,6 +1155,13 @@ void Context::destroy_lua_script(CUID compID)
     mL.get_global("ludens");
     mL.get_field(-1, "scripts");
     mL.push_light_userdata(reinterpret_cast<void*>((uint64_t)compID));
+    mL.get_table(-2);
+
+    if (mL.get_type(-1) == LUA_TYPE_TABLE)
+        schedule_script(mL, "remove");
+
+    mL.pop(1);
+    mL.push_light_userdata(reinterpret_cast<void*>((uint64_t)compID));
     mL.push_nil();
     mL.set_table(-3); // ludens.scripts[compID] = nil
 
@@ -804,13 +1177,19 @@ bool Context::attach_lua_script(CUID compID, String& err)
     mL.get_global("ludens");
     mL.get_field(-1, "scripts");
 
-    // call 'attach' lua method on script
     mL.push_light_userdata(reinterpret_cast<void*>((uint64_t)compID));
     mL.get_table(-2);
     LD_ASSERT(mL.get_type(-1) == LUA_TYPE_TABLE); // script instance
 
-    mL.get_field(-1, "attach");
-    LD_ASSERT(mL.get_type(-1) == LUA_TYPE_FN); // script attach method
+    // record whether the script defines 'update' before 'attach' may sleep or set a tick rate
+    schedule_script(mL, "add");
+
+    // call optional 'attach' lua method on script
+    if (!mL.get_field_type(-1, "attach", LUA_TYPE_FN))
+    {
+        mL.resize(oldSize);
+        return true;
+    }
 
     // arg1 is script instance
     mL.push_value(-2);
@@ -824,6 +1203,7 @@ bool Context::attach_lua_script(CUID compID, String& err)
     if (luaError != 0)
     {
         err = mL.to_string(-1);
+        mL.resize(oldSize);
         return false;
     }
 
@@ -840,13 +1220,19 @@ bool Context::detach_lua_script(CUID compID, String& err)
     mL.get_global("ludens");
     mL.get_field(-1, "scripts");
 
-    // call 'detach' lua method on script
     mL.push_light_userdata(reinterpret_cast<void*>((uint64_t)compID));
     mL.get_table(-2);
     LD_ASSERT((type = mL.get_type(-1)) == LUA_TYPE_TABLE); // script instance
 
-    mL.get_field(-1, "detach");
-    LD_ASSERT((type = mL.get_type(-1)) == LUA_TYPE_FN); // script detach method
+    // detached scripts are no longer updated
+    schedule_script(mL, "remove");
+
+    // call optional 'detach' lua method on script
+    if (!mL.get_field_type(-1, "detach", LUA_TYPE_FN))
+    {
+        mL.resize(oldSize);
+        return true;
+    }
 
     // arg1 is script instance
     mL.push_value(-2);
@@ -856,6 +1242,7 @@ bool Context::detach_lua_script(CUID compID, String& err)
     if (luaError != 0)
     {
         err = mL.to_string(-1);
+        mL.resize(oldSize);
         return false;
     }
 
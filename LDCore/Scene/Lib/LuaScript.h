@@ -13,12 +13,14 @@ class Context
 {
 public:
     /// @brief In-place creation, initializes lua state and loads FFI functions.
-    void create(Scene scene);
+    void create(Scene scene, const SceneLuaGCInfo& gcI);
 
     /// @brief In-place destruction, destroys all scripts and lua state.
+    ///        The lua heap of the scene is released wholesale.
     void destroy();
 
-    /// @brief Call update on all scripts.
+    /// @brief Call update on scheduled scripts, skipping sleeping and throttled ones,
+    ///        then perform a bounded garbage collection step if configured.
     /// @param delta Delta time in seconds.
     bool update(float delta, String& err);
 
@@ -37,7 +39,7 @@ public:
     /// @brief Destroy lua script associated with a component
     void destroy_lua_script(CUID compID);
 
-    /// @brief Attach lua script to its data component.
+    /// @brief Attach lua script to its data component, scripts with an update method are scheduled.
     bool attach_lua_script(CUID compID, String& err);
 
     /// @brief Detach lua script from its data component.
@@ -46,6 +48,8 @@ public:
 private:
     LuaState mL{};
     Scene mScene{};
+    int mUpdateRef = 0; /// registry reference to the compiled dispatch chunk
+    int mGCStepKB = 0;  /// per-frame collector step size, zero for automatic collection
 };
 
 /// @brief Get static C string of LuaScript log channel.
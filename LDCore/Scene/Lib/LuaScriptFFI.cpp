@@ -53,6 +53,8 @@ static_assert(offsetof(Transform2D, position) == 0);
 static_assert(offsetof(Transform2D, scale) == 8);
 static_assert(offsetof(Transform2D, rotation) == 16);
 
+static_assert(sizeof(CUID) == sizeof(void*)); // void* arrays from Lua are read as CUID arrays
+
 static_assert(offsetof(AssetObj, type) == 0);
 static_assert(offsetof(AssetObj, id) == 4);
 static_assert(offsetof(AssetObj, manager) == 8);
@@ -130,6 +132,10 @@ typedef struct __attribute__((aligned(8))) AssetObj {
 
 void* ffi_get_parent_id(void* compID);
 void* ffi_get_child_id_by_name(void* compID, const char* name);
+void ffi_mark_transform_dirty(void* compID);
+uint32_t ffi_get_child_ids(void* compID, void** outIDs, uint32_t maxCount);
+uint32_t ffi_gather_transforms_2d(void** compIDs, Transform2D* transforms, uint32_t count);
+uint32_t ffi_commit_transforms_2d(void** compIDs, const Transform2D* transforms, uint32_t count);
 
 typedef struct MeshComponent {
     void* base;
@@ -292,6 +298,39 @@ void* ffi_get_child_id_by_name(void* compID, const char* name)
     return 0;
 }
 
+void ffi_mark_transform_dirty(void* compID)
+{
+    sScene->active->registry.mark_component_transform_dirty(reinterpret_cast<uint64_t>(compID));
+}
+
+uint32_t ffi_get_child_ids(void* compID, void** outIDs, uint32_t maxCount)
+{
+    ComponentBase* base = sScene->active->registry.get_component_base(reinterpret_cast<uint64_t>(compID));
+    LD_ASSERT(base);
+
+    uint32_t childCount = 0;
+
+    for (ComponentBase* child = base->child; child; child = child->next)
+    {
+        if (childCount < maxCount)
+            outIDs[childCount] = reinterpret_cast<void*>((uint64_t)child->cuid);
+
+        childCount++;
+    }
+
+    return childCount;
+}
+
+uint32_t ffi_gather_transforms_2d(void** compIDs, Transform2D* transforms, uint32_t count)
+{
+    return (uint32_t)sScene->active->registry.get_component_transforms_2d(reinterpret_cast<const CUID*>(compIDs), transforms, count);
+}
+
+uint32_t ffi_commit_transforms_2d(void** compIDs, const Transform2D* transforms, uint32_t count)
+{
+    return (uint32_t)sScene->active->registry.set_component_transforms_2d(reinterpret_cast<const CUID*>(compIDs), transforms, count);
+}
+
 void ffi_audio_source_component_play(AudioSourceComponent* comp)
 {
     LD_ASSERT(comp && comp->base);
@@ -16,6 +16,7 @@ namespace LD {
 
 struct AudioSourceComponent;
 struct Sprite2DComponent;
+struct Transform2D;
 
 namespace LuaScript {
 
@@ -36,6 +37,10 @@ struct RectFFI
 
 LD_FFI_EXPORT void* ffi_get_parent_id(void* cuid);
 LD_FFI_EXPORT void* ffi_get_child_id_by_name(void* cuid, const char* name);
+LD_FFI_EXPORT void ffi_mark_transform_dirty(void* cuid);
+LD_FFI_EXPORT uint32_t ffi_get_child_ids(void* cuid, void** outIDs, uint32_t maxCount);
+LD_FFI_EXPORT uint32_t ffi_gather_transforms_2d(void** cuids, Transform2D* transforms, uint32_t count);
+LD_FFI_EXPORT uint32_t ffi_commit_transforms_2d(void** cuids, const Transform2D* transforms, uint32_t count);
 LD_FFI_EXPORT void ffi_audio_source_component_play(AudioSourceComponent* comp);
 LD_FFI_EXPORT void ffi_audio_source_component_pause(AudioSourceComponent* comp);
 LD_FFI_EXPORT void ffi_audio_source_component_resume(AudioSourceComponent* comp);
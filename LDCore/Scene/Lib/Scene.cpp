@@ -1,3 +1,4 @@
+#include <Ludens/Asset/AssetManager.h>
 #include <Ludens/Camera/Camera.h>
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/Header/Assert.h>
@@ -143,7 +144,7 @@ SceneContext::SceneContext(const SceneContextInfo& info)
     LD_PROFILE_SCOPE;
 
     registry = DataRegistry::create();
-    lua.create(Scene(sScene));
+    lua.create(Scene(sScene), info.luaGC);
 
     ScreenUIInfo uiI{};
     uiI.extent = {};
@@ -445,6 +446,166 @@ void SceneContext::unload_subtree(ComponentBase** data, SUIDRegistry suidRegistr
     }
 }
 
+static void get_startup_order(DataRegistry registry, ComponentBase** rootData, Vector<ComponentBase**>& startupOrder)
+{
+    ComponentBase* rootBase = *rootData;
+
+    for (ComponentBase* childBase = rootBase->child; childBase; childBase = childBase->next)
+        get_startup_order(registry, registry.get_component_data(childBase->cuid, nullptr), startupOrder);
+
+    // same post-order as SceneContext::startup_subtree
+    startupOrder.push_back(rootData);
+}
+
+static bool transition_submit_assets(void* user)
+{
+    SceneObj* obj = (SceneObj*)user;
+    SceneObj::TransitionData& data = obj->transitionData;
+    AssetManager assetManager = AssetManager::get();
+    bool hasLoadJob = false;
+
+    for (AssetID assetID : data.assets)
+    {
+        if (assetManager.get_asset(assetID))
+            continue; // already loaded or loading
+
+        if (!hasLoadJob)
+            assetManager.begin_load_batch();
+
+        assetManager.load_asset(assetID);
+        hasLoadJob = true;
+    }
+
+    // other batches may be in flight, the transition only tracks its own
+    if (hasLoadJob)
+        data.assetBatch = assetManager.submit_load_batch();
+
+    return hasLoadJob;
+}
+
+static bool transition_poll_assets(void* user, float* progress)
+{
+    SceneObj* obj = (SceneObj*)user;
+    AssetLoadBatch batch = obj->transitionData.assetBatch;
+
+    *progress = batch.get_progress();
+    return batch.is_complete();
+}
+
+static bool transition_end_assets(void* user)
+{
+    SceneObj* obj = (SceneObj*)user;
+    SceneObj::TransitionData& data = obj->transitionData;
+
+    Vector<AssetLoadStatus> errors;
+    bool loadSuccess = AssetManager::get().end_load_batch(data.assetBatch, errors);
+    data.assetBatch = {};
+
+    for (const AssetLoadStatus& error : errors)
+        sSceneLog.error("failed to load asset for scene transition: {}", error.str);
+
+    return loadSuccess;
+}
+
+static bool transition_load(void* user, size_t* componentCount)
+{
+    LD_PROFILE_SCOPE_NAME("Scene ShadowContext Load");
+
+    SceneObj* obj = (SceneObj*)user;
+    SceneObj::TransitionData& data = obj->transitionData;
+
+    obj->shadow = heap_new<SceneContext>(MEMORY_USAGE_SCENE, obj->contextInfo);
+
+    obj->contextTarget = SCENE_CONTEXT_SHADOW;
+    bool loadSuccess = data.loadFn(obj);
+    obj->contextTarget = SCENE_CONTEXT_ACTIVE;
+
+    if (!loadSuccess)
+    {
+        heap_delete<SceneContext>(obj->shadow);
+        obj->shadow = nullptr;
+        sSceneLog.error("failed to transition to scene, load failed");
+        return false;
+    }
+
+    Vector<ComponentBase**> roots;
+    obj->shadow->registry.get_root_component_data(roots);
+    data.startupOrder.clear();
+
+    for (ComponentBase** rootData : roots)
+        get_startup_order(obj->shadow->registry, rootData, data.startupOrder);
+
+    *componentCount = data.startupOrder.size();
+    return true;
+}
+
+static bool transition_startup(void* user, size_t index)
+{
+    LD_PROFILE_SCOPE_NAME("Scene ShadowContext Startup");
+
+    SceneObj* obj = (SceneObj*)user;
+    ComponentBase** data = obj->transitionData.startupOrder[index];
+    String err;
+
+    if (!obj->shadow->startup_component(data, err))
+    {
+        sSceneLog.error("failed to transition to scene, startup failed for component {}:\n{}", (*data)->name, err);
+        return false;
+    }
+
+    return true;
+}
+
+static void transition_complete(void* user)
+{
+    SceneObj* obj = (SceneObj*)user;
+
+    obj->active->cleanup_registry();
+    heap_delete<SceneContext>(obj->active);
+    obj->active = obj->shadow;
+    obj->shadow = nullptr;
+    obj->transitionData = {};
+
+    sSceneLog.info("scene transition complete");
+}
+
+static void transition_discard(void* user, size_t startupCount)
+{
+    LD_PROFILE_SCOPE;
+
+    SceneObj* obj = (SceneObj*)user;
+    SceneObj::TransitionData& data = obj->transitionData;
+
+    if (obj->shadow)
+    {
+        String err;
+
+        for (size_t i = startupCount; i > 0; i--)
+            (void)obj->shadow->cleanup_component(data.startupOrder[i - 1], err);
+
+        obj->shadow->unload_registry(obj->suidRegistry);
+        heap_delete<SceneContext>(obj->shadow);
+        obj->shadow = nullptr;
+    }
+
+    data = {};
+}
+
+SceneTransitionCallbacks SceneObj::get_transition_callbacks()
+{
+    SceneTransitionCallbacks callbacks{};
+    callbacks.user = this;
+    callbacks.submit_assets = &transition_submit_assets;
+    callbacks.poll_assets = &transition_poll_assets;
+    callbacks.end_assets = &transition_end_assets;
+    callbacks.load = &transition_load;
+    callbacks.startup = &transition_startup;
+    callbacks.complete = &transition_complete;
+    callbacks.discard = &transition_discard;
+
+    return callbacks;
+}
+
 bool SceneObj::load_registry_from_backup()
 {
     LD_PROFILE_SCOPE;
@@ -575,6 +736,7 @@ Scene Scene::create(const SceneInfo& sceneI)
 
     sScene->contextInfo.uiFont = sceneI.uiFont;
     sScene->contextInfo.uiTheme = sceneI.uiTheme;
+    sScene->contextInfo.luaGC = sceneI.luaGC;
     sScene->active = nullptr;
 
     return Scene(sScene);
@@ -586,6 +748,9 @@ void Scene::destroy()
 
     LD_ASSERT(sScene);
     LD_ASSERT(sScene->backup == nullptr);
+
+    sScene->transition.abort();
+
     LD_ASSERT(sScene->shadow == nullptr);
 
     // destroy all components
@@ -611,6 +776,8 @@ void Scene::reset()
 {
     LD_PROFILE_SCOPE;
 
+    mObj->transition.abort();
+
     if (mObj->state == SCENE_STATE_LOADED)
         unload();
 
@@ -655,6 +822,9 @@ void Scene::unload()
 {
     LD_PROFILE_SCOPE;
 
+    // an in-flight transition would later swap its context over the restored or next scene
+    mObj->transition.abort();
+
     if (mObj->state == SCENE_STATE_EMPTY)
         return;
 
@@ -713,6 +883,9 @@ void Scene::cleanup()
 {
     LD_PROFILE_SCOPE;
 
+    // an in-flight transition would later swap its context over the restored or next scene
+    mObj->transition.abort();
+
     if (mObj->state != SCENE_STATE_RUNNING)
         return;
 
@@ -738,50 +911,8 @@ void Scene::update(const SceneUpdateTick& tick)
 
     mObj->tick = tick;
 
-    if (mObj->transition.inProgress)
-    {
-        // NOTE: This is eventually where we do async I/O to load assets
-        //       for next Scene and populate the shadow SceneContext.
-        //       For now this is just a dumb synchronous call that blocks
-        //       until the full transition is complete.
-
-        mObj->shadow = heap_new<SceneContext>(MEMORY_USAGE_SCENE, mObj->contextInfo);
-
-        bool loadSuccess;
-
-        {
-            LD_PROFILE_SCOPE_NAME("Scene ShadowContext Load");
-
-            mObj->contextTarget = SCENE_CONTEXT_SHADOW;
-
-            loadSuccess = mObj->transition.loadFn(sScene);
-            mObj->contextTarget = SCENE_CONTEXT_ACTIVE;
-        }
-
-        if (loadSuccess)
-        {
-            if (mObj->shadow->startup_registry())
-            {
-                mObj->active->cleanup_registry();
-                heap_delete<SceneContext>(mObj->active);
-                mObj->active = mObj->shadow;
-            }
-            else
-            {
-                mObj->shadow->unload_registry(mObj->suidRegistry);
-                heap_delete<SceneContext>(mObj->shadow);
-                sSceneLog.error("failed to transition to scene, startup failed");
-            }
-        }
-        else
-        {
-            heap_delete<SceneContext>(mObj->shadow);
-            sSceneLog.error("failed to transition to scene, load failed");
-        }
-
-        mObj->shadow = nullptr;
-        mObj->transition.inProgress = false;
-    }
+    if (mObj->transition.is_active())
+        mObj->transition.step();
 
     mObj->active->update(mObj->tick);
     mObj->active->post_update();
@@ -792,13 +923,38 @@ void Scene::update(const SceneUpdateTick& tick)
 
 bool Scene::request_transition(const SceneLoadFn& loadFn)
 {
-    if (mObj->transition.inProgress)
+    SceneTransitionInfo transitionI{};
+    transitionI.loadFn = loadFn;
+
+    return request_transition(transitionI);
+}
+
+bool Scene::request_transition(const SceneTransitionInfo& transitionI)
+{
+    if (mObj->transition.is_active())
         return false;
 
-    mObj->transition.loadFn = loadFn;
-    mObj->transition.inProgress = true;
+    SceneObj::TransitionData& data = mObj->transitionData;
+    data.loadFn = transitionI.loadFn;
+    data.assets = transitionI.assets;
+    data.startupOrder.clear();
+    data.assetBatch = {};
+
+    return mObj->transition.begin(mObj->get_transition_callbacks(), transitionI.frameBudgetMS);
+}
+
+void Scene::cancel_transition()
+{
+    if (!mObj->transition.is_active())
+        return;
 
-    return mObj->transition.inProgress;
+    sSceneLog.info("scene transition cancelled");
+    mObj->transition.cancel();
+}
+
+float Scene::get_transition_progress()
+{
+    return mObj->transition.get_progress();
 }
 
 void Scene::render_screen_ui(ScreenRenderComponent renderer)
@@ -1023,9 +1179,10 @@ ComponentView Scene::get_component(CUID compID)
     return ComponentView(mObj->active->registry.get_component_data(compID, nullptr));
 }
 
-Vector<ComponentView> Scene::get_components(ComponentType type)
+FrameVector<ComponentView> Scene::get_components(ComponentType type)
 {
-    Vector<ComponentView> views; // TODO: reserve size...
+    FrameVector<ComponentView> views;
+    views.reserve(mObj->active->registry.get_component_count(type));
 
     for (auto it = mObj->active->registry.get_components(type); it; ++it)
         views.push_back(ComponentView((ComponentBase**)it.data()));
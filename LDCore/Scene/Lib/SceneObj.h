@@ -1,11 +1,13 @@
 #pragma once
 
+#include <Ludens/Asset/AssetManager.h>
 #include <Ludens/DSA/Vector.h>
 #include <Ludens/UI/UIContext.h>
 
 #include "AudioSystemCache.h"
 #include "LuaScript.h"
 #include "RenderSystemCache.h"
+#include "SceneTransition.h"
 #include "ScreenUI.h"
 
 namespace LD {
@@ -28,6 +30,7 @@ struct SceneContextInfo
 {
     UIFont uiFont;
     UITheme uiTheme;
+    SceneLuaGCInfo luaGC;
 };
 
 struct SceneContext
@@ -86,11 +89,19 @@ public:
     SceneState state = SCENE_STATE_EMPTY;
     SceneUpdateTick tick = {};
 
-    struct Transition
+    SceneTransition transition;
+
+    /// @brief Scene side state of the transition in progress.
+    struct TransitionData
     {
-        bool inProgress = false;
         SceneLoadFn loadFn;
-    } transition;
+        Vector<AssetID> assets;               /// assets to load before the load function
+        Vector<ComponentBase**> startupOrder; /// shadow components in post-order
+        AssetLoadBatch assetBatch = {};       /// submitted asset load jobs owned by the transition
+    } transitionData;
+
+    /// @brief Get the operations of a transition on this scene.
+    SceneTransitionCallbacks get_transition_callbacks();
 
     bool load_registry_from_backup();
     bool clone_subtree(ComponentBase** dstData, ComponentBase** srcData, String& err);
@@ -0,0 +1,165 @@
+#include <Ludens/Header/Assert.h>
+#include <Ludens/Profiler/Profiler.h>
+#include <Ludens/System/Timer.h>
+
+#include <algorithm>
+
+#include "SceneTransition.h"
+
+namespace LD {
+
+bool SceneTransition::begin(const SceneTransitionCallbacks& callbacks, float frameBudgetMS)
+{
+    if (is_active())
+        return false;
+
+    reset();
+    mCallbacks = callbacks;
+    mFrameBudgetMS = frameBudgetMS;
+    mPhase = SCENE_TRANSITION_PHASE_ASSETS;
+
+    return true;
+}
+
+void SceneTransition::step()
+{
+    LD_PROFILE_SCOPE;
+
+    void* user = mCallbacks.user;
+
+    // submitted asset load jobs can not be revoked, wait for them to drain before discarding
+    if (mIsCancelRequested)
+    {
+        if (mHasAssetBatch && !mCallbacks.poll_assets(user, &mAssetProgress))
+            return;
+
+        abort();
+        return;
+    }
+
+    switch (mPhase)
+    {
+    case SCENE_TRANSITION_PHASE_ASSETS:
+    {
+        if (!mHasAssetBatch)
+        {
+            if (!mCallbacks.submit_assets(user))
+            {
+                mPhase = SCENE_TRANSITION_PHASE_LOAD;
+                break;
+            }
+
+            mHasAssetBatch = true;
+        }
+
+        // the active scene keeps updating while workers load assets
+        if (!mCallbacks.poll_assets(user, &mAssetProgress))
+            break;
+
+        mHasAssetBatch = false;
+
+        if (!mCallbacks.end_assets(user))
+        {
+            abort();
+            break;
+        }
+
+        mPhase = SCENE_TRANSITION_PHASE_LOAD;
+        break;
+    }
+    case SCENE_TRANSITION_PHASE_LOAD:
+    {
+        if (!mCallbacks.load(user, &mComponentCount))
+        {
+            abort();
+            break;
+        }
+
+        mStartupCount = 0;
+        mPhase = SCENE_TRANSITION_PHASE_STARTUP;
+        break;
+    }
+    case SCENE_TRANSITION_PHASE_STARTUP:
+    {
+        Timer timer;
+        timer.start();
+        size_t budgetUS = (size_t)(mFrameBudgetMS * 1000.0f);
+
+        // at least one component per frame so the transition always makes progress
+        while (mStartupCount < mComponentCount)
+        {
+            if (!mCallbacks.startup(user, mStartupCount))
+            {
+                abort();
+                return;
+            }
+
+            mStartupCount++;
+
+            if (timer.stop() >= budgetUS)
+                break;
+        }
+
+        if (mStartupCount < mComponentCount)
+            break;
+
+        mCallbacks.complete(user);
+        reset();
+        break;
+    }
+    default:
+        break;
+    }
+}
+
+void SceneTransition::cancel()
+{
+    if (is_active())
+        mIsCancelRequested = true;
+}
+
+void SceneTransition::abort()
+{
+    LD_PROFILE_SCOPE;
+
+    if (!is_active())
+        return;
+
+    void* user = mCallbacks.user;
+
+    // loaded assets stay with the asset manager
+    if (mHasAssetBatch)
+        (void)mCallbacks.end_assets(user);
+
+    mCallbacks.discard(user, mPhase == SCENE_TRANSITION_PHASE_STARTUP ? mStartupCount : 0);
+    reset();
+}
+
+float SceneTransition::get_progress() const
+{
+    switch (mPhase)
+    {
+    case SCENE_TRANSITION_PHASE_ASSETS:
+        return mHasAssetBatch ? 0.5f * mAssetProgress : 0.0f;
+    case SCENE_TRANSITION_PHASE_LOAD:
+        return 0.5f;
+    case SCENE_TRANSITION_PHASE_STARTUP:
+        return 0.5f + 0.5f * (float)mStartupCount / (float)std::max<size_t>(mComponentCount, 1);
+    default:
+        break;
+    }
+
+    return -1.0f;
+}
+
+void SceneTransition::reset()
+{
+    mPhase = SCENE_TRANSITION_PHASE_NONE;
+    mComponentCount = 0;
+    mStartupCount = 0;
+    mAssetProgress = 0.0f;
+    mHasAssetBatch = false;
+    mIsCancelRequested = false;
+}
+
+} // namespace LD
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <cstddef>
+
+namespace LD {
+
+enum SceneTransitionPhase
+{
+    SCENE_TRANSITION_PHASE_NONE = 0,
+    SCENE_TRANSITION_PHASE_ASSETS,  // asset load jobs on worker threads
+    SCENE_TRANSITION_PHASE_LOAD,    // load function populates the shadow context
+    SCENE_TRANSITION_PHASE_STARTUP, // shadow components are started up within the frame budget
+};
+
+/// @brief Operations a transition performs on the scene. The scene owns the asset load batch
+///        and the shadow context, the transition only decides when each operation happens.
+struct SceneTransitionCallbacks
+{
+    void* user;
+
+    /// @brief Submit asset load jobs of the next scene.
+    /// @return False if there is nothing to load.
+    bool (*submit_assets)(void* user);
+
+    /// @brief Check if the submitted asset load jobs have completed, does not block.
+    bool (*poll_assets)(void* user, float* progress);
+
+    /// @brief End the submitted asset load jobs.
+    /// @return False if any asset failed to load.
+    bool (*end_assets)(void* user);
+
+    /// @brief Populate the shadow context, the shadow context is discarded by the callback on failure.
+    /// @param componentCount Outputs the number of shadow components to start up.
+    bool (*load)(void* user, size_t* componentCount);
+
+    /// @brief Start up a shadow component, components are started up in increasing index order.
+    bool (*startup)(void* user, size_t index);
+
+    /// @brief Replace the active context with the fully started shadow context.
+    void (*complete)(void* user);
+
+    /// @brief Discard the transition, the first startupCount shadow components were started up.
+    ///        Called on failure and cancellation, the shadow context may not exist yet.
+    void (*discard)(void* user, size_t startupCount);
+};
+
+/// @brief Phases of a scene transition advanced once per frame. Asset loading and
+///        component startup each account for half of the progress.
+class SceneTransition
+{
+public:
+    /// @brief Begin a transition.
+    /// @param frameBudgetMS Time per frame spent starting up components, at least one component is started up each frame.
+    /// @return False if another transition is already in progress.
+    bool begin(const SceneTransitionCallbacks& callbacks, float frameBudgetMS);
+
+    /// @brief Advance the transition by one frame.
+    void step();
+
+    /// @brief Request cancellation, the transition is discarded once submitted asset loads drain.
+    void cancel();
+
+    /// @brief Discard the transition immediately, blocking on submitted asset loads.
+    void abort();
+
+    /// @brief Get normalized progress.
+    /// @return Progress in [0, 1], or a negative value if no transition is in progress.
+    float get_progress() const;
+
+    inline SceneTransitionPhase phase() const { return mPhase; }
+
+    inline bool is_active() const { return mPhase != SCENE_TRANSITION_PHASE_NONE; }
+
+private:
+    void reset();
+
+    SceneTransitionCallbacks mCallbacks{};
+    SceneTransitionPhase mPhase = SCENE_TRANSITION_PHASE_NONE;
+    size_t mComponentCount = 0; /// number of shadow components to start up
+    size_t mStartupCount = 0;   /// number of shadow components already started up
+    float mAssetProgress = 0.0f;
+    float mFrameBudgetMS = 0.0f;
+    bool mHasAssetBatch = false; /// asset load jobs are submitted and not yet ended
+    bool mIsCancelRequested = false;
+};
+
+} // namespace LD
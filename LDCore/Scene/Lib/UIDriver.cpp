@@ -56,22 +56,13 @@ static void push_widget_proxy(LuaState L, UIDriver* driver, const char* pathCstr
 
     // the widget proxy table is responsible for caching the Lua functions
     // so that the UIDriver may invoke the Lua callback later.
-    bool ok = L.do_string(R"(
-local proxyMeta = {
-    __newindex = function (proxy, k, v)
-        if type(k) == 'string' and type(v) == 'function' then
-            _G.ludens.ui_driver.install_callback(proxy.__widget, k, v)
-            return
-        end
-        rawset(proxy, k, v)
-    end,
-}
-local proxy = {}
-
-setmetatable(proxy, proxyMeta)
-return proxy
-)");
-    LD_ASSERT(ok && L.get_type(-1) == LUA_TYPE_TABLE);
+    // The proxy metatable is created once during LuaScript bootstrapping.
+    L.push_table();
+    L.get_global("ludens");
+    L.get_field(-1, "WidgetProxy");
+    L.remove(-2);
+    LD_ASSERT(L.get_type(-1) == LUA_TYPE_TABLE);
+    L.set_meta_table(-2);
 
     // NOTE: This is only possible since UIWidgetObj address is stable.
     //       Will have to refactor once we add widget create/destroy API in Lua
@@ -0,0 +1,288 @@
+#include <Extra/doctest/doctest.h>
+#include <LDCore/Scene/Lib/SceneTransition.h>
+
+#include <vector>
+
+using namespace LD;
+
+// Scene stand-in that records the operations driven by the transition.
+struct TransitionMock
+{
+    bool hasAssets = false;
+    int assetPollsLeft = 0; // polls until the asset batch completes
+    bool assetSuccess = true;
+    bool loadSuccess = true;
+    size_t componentCount = 0;
+    size_t failingComponent = (size_t)-1;
+
+    int submitCount = 0;
+    int endAssetsCount = 0;
+    int loadCount = 0;
+    int completeCount = 0;
+    int discardCount = 0;
+    size_t discardStartupCount = 0;
+    std::vector<size_t> startupOrder;
+};
+
+static SceneTransitionCallbacks get_mock_callbacks(TransitionMock& mock)
+{
+    SceneTransitionCallbacks callbacks{};
+    callbacks.user = &mock;
+    callbacks.submit_assets = [](void* user) -> bool {
+        auto* mock = (TransitionMock*)user;
+        mock->submitCount++;
+        return mock->hasAssets;
+    };
+    callbacks.poll_assets = [](void* user, float* progress) -> bool {
+        auto* mock = (TransitionMock*)user;
+        bool isComplete = mock->assetPollsLeft-- <= 0;
+        *progress = isComplete ? 1.0f : 0.5f;
+        return isComplete;
+    };
+    callbacks.end_assets = [](void* user) -> bool {
+        auto* mock = (TransitionMock*)user;
+        mock->endAssetsCount++;
+        return mock->assetSuccess;
+    };
+    callbacks.load = [](void* user, size_t* componentCount) -> bool {
+        auto* mock = (TransitionMock*)user;
+        mock->loadCount++;
+        *componentCount = mock->componentCount;
+        return mock->loadSuccess;
+    };
+    callbacks.startup = [](void* user, size_t index) -> bool {
+        auto* mock = (TransitionMock*)user;
+        mock->startupOrder.push_back(index);
+        return index != mock->failingComponent;
+    };
+    callbacks.complete = [](void* user) {
+        ((TransitionMock*)user)->completeCount++;
+    };
+    callbacks.discard = [](void* user, size_t startupCount) {
+        auto* mock = (TransitionMock*)user;
+        mock->discardCount++;
+        mock->discardStartupCount = startupCount;
+    };
+
+    return callbacks;
+}
+
+TEST_CASE("SceneTransition phases")
+{
+    TransitionMock mock;
+    mock.hasAssets = true;
+    mock.assetPollsLeft = 2;
+    mock.componentCount = 3;
+
+    SceneTransition tr;
+    CHECK(!tr.is_active());
+    CHECK(tr.get_progress() < 0.0f);
+
+    REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+    CHECK(!tr.begin(get_mock_callbacks(mock), 1000.0f));
+    CHECK(tr.phase() == SCENE_TRANSITION_PHASE_ASSETS);
+    CHECK(tr.get_progress() == 0.0f);
+
+    // the active scene keeps updating while assets load
+    tr.step();
+    tr.step();
+    CHECK(tr.phase() == SCENE_TRANSITION_PHASE_ASSETS);
+    CHECK(tr.get_progress() == 0.25f);
+    CHECK(mock.submitCount == 1);
+    CHECK(mock.endAssetsCount == 0);
+
+    tr.step();
+    CHECK(tr.phase() == SCENE_TRANSITION_PHASE_LOAD);
+    CHECK(tr.get_progress() == 0.5f);
+    CHECK(mock.endAssetsCount == 1);
+    CHECK(mock.loadCount == 0);
+
+    tr.step();
+    CHECK(tr.phase() == SCENE_TRANSITION_PHASE_STARTUP);
+    CHECK(mock.loadCount == 1);
+    CHECK(mock.startupOrder.empty());
+
+    tr.step();
+    CHECK(!tr.is_active());
+    CHECK(mock.startupOrder == std::vector<size_t>{0, 1, 2});
+    CHECK(mock.completeCount == 1);
+    CHECK(mock.discardCount == 0);
+    CHECK(tr.get_progress() < 0.0f);
+}
+
+TEST_CASE("SceneTransition without assets")
+{
+    TransitionMock mock;
+    mock.componentCount = 1;
+
+    SceneTransition tr;
+    REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+
+    tr.step();
+    CHECK(tr.phase() == SCENE_TRANSITION_PHASE_LOAD);
+    CHECK(mock.endAssetsCount == 0);
+
+    tr.step();
+    tr.step();
+    CHECK(!tr.is_active());
+    CHECK(mock.completeCount == 1);
+
+    // the next transition may begin once the previous one completes
+    CHECK(tr.begin(get_mock_callbacks(mock), 1000.0f));
+}
+
+TEST_CASE("SceneTransition frame budget")
+{
+    TransitionMock mock;
+    mock.componentCount = 4;
+
+    // a zero budget still starts up one component per frame
+    SceneTransition tr;
+    REQUIRE(tr.begin(get_mock_callbacks(mock), 0.0f));
+    tr.step();
+    tr.step();
+    REQUIRE(tr.phase() == SCENE_TRANSITION_PHASE_STARTUP);
+
+    for (size_t i = 1; i <= 4; i++)
+    {
+        tr.step();
+        CHECK(mock.startupOrder.size() == i);
+
+        if (i < 4)
+        {
+            CHECK(tr.phase() == SCENE_TRANSITION_PHASE_STARTUP);
+            CHECK(tr.get_progress() == 0.5f + 0.5f * i / 4.0f);
+        }
+    }
+
+    CHECK(!tr.is_active());
+    CHECK(mock.completeCount == 1);
+}
+
+TEST_CASE("SceneTransition cancel")
+{
+    SUBCASE("during asset loading")
+    {
+        TransitionMock mock;
+        mock.hasAssets = true;
+        mock.assetPollsLeft = 2;
+
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+        tr.step();
+        tr.cancel();
+
+        // submitted asset loads drain before the transition is discarded
+        tr.step();
+        CHECK(tr.is_active());
+        CHECK(mock.discardCount == 0);
+
+        tr.step();
+        CHECK(!tr.is_active());
+        CHECK(mock.endAssetsCount == 1);
+        CHECK(mock.loadCount == 0);
+        CHECK(mock.discardCount == 1);
+    }
+
+    SUBCASE("during startup")
+    {
+        TransitionMock mock;
+        mock.componentCount = 4;
+
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 0.0f));
+        tr.step();
+        tr.step();
+        tr.step();
+        tr.step();
+        REQUIRE(mock.startupOrder.size() == 2);
+
+        tr.cancel();
+        tr.step();
+        CHECK(!tr.is_active());
+        CHECK(mock.startupOrder.size() == 2);
+        CHECK(mock.discardCount == 1);
+        CHECK(mock.discardStartupCount == 2);
+        CHECK(mock.completeCount == 0);
+    }
+}
+
+TEST_CASE("SceneTransition failure")
+{
+    SUBCASE("asset load")
+    {
+        TransitionMock mock;
+        mock.hasAssets = true;
+        mock.assetSuccess = false;
+
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+        tr.step();
+        CHECK(!tr.is_active());
+        CHECK(mock.endAssetsCount == 1);
+        CHECK(mock.loadCount == 0);
+        CHECK(mock.discardCount == 1);
+    }
+
+    SUBCASE("component startup")
+    {
+        TransitionMock mock;
+        mock.componentCount = 3;
+        mock.failingComponent = 1;
+
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+        tr.step();
+        tr.step();
+        tr.step();
+        CHECK(!tr.is_active());
+        CHECK(mock.completeCount == 0);
+        CHECK(mock.discardCount == 1);
+        CHECK(mock.discardStartupCount == 1); // only component 0 is cleaned up
+    }
+
+    SUBCASE("abort blocks on submitted assets")
+    {
+        TransitionMock mock;
+        mock.hasAssets = true;
+        mock.assetPollsLeft = 5;
+
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 1000.0f));
+        tr.step();
+        tr.abort();
+        CHECK(!tr.is_active());
+        CHECK(mock.endAssetsCount == 1);
+        CHECK(mock.discardCount == 1);
+    }
+
+    SUBCASE("abort by scene cleanup")
+    {
+        TransitionMock mock;
+        mock.hasAssets = true;
+        mock.componentCount = 4;
+
+        // Scene::cleanup and Scene::unload abort a transition in any phase
+        SceneTransition tr;
+        REQUIRE(tr.begin(get_mock_callbacks(mock), 0.0f));
+        tr.step();
+        tr.step();
+        tr.step();
+        REQUIRE(tr.phase() == SCENE_TRANSITION_PHASE_STARTUP);
+
+        size_t startupCount = mock.startupOrder.size();
+        tr.abort();
+        CHECK(!tr.is_active());
+        CHECK(mock.discardCount == 1);
+        CHECK(mock.discardStartupCount == startupCount);
+
+        // later frames never complete the discarded transition
+        for (int i = 0; i < 8; i++)
+            tr.step();
+
+        CHECK(!tr.is_active());
+        CHECK(mock.startupOrder.size() == startupCount);
+        CHECK(mock.completeCount == 0);
+        CHECK(mock.discardCount == 1);
+    }
+}
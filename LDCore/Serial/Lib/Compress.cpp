@@ -18,11 +18,13 @@ size_t zstd_compress(void* dst, size_t dstCapacity, const void* src, size_t srcS
     return ::ZSTD_compress(dst, dstCapacity, src, srcSize, compressionLevel);
 }
 
-void zstd_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize)
+size_t zstd_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize)
 {
     LD_PROFILE_SCOPE;
 
-    ::ZSTD_decompress(dst, dstCapacity, src, compressedSize);
+    size_t result = ::ZSTD_decompress(dst, dstCapacity, src, compressedSize);
+
+    return ::ZSTD_isError(result) ? 0 : result;
 }
 
 size_t lz4_compress_bound(size_t srcSize)
@@ -37,13 +39,13 @@ size_t lz4_compress(void* dst, size_t dstCapacity, const void* src, size_t srcSi
     return (size_t)::LZ4_compress_default((const char*)src, (char*)dst, (int)srcSize, (int)dstCapacity);
 }
 
-void lz4_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize)
+size_t lz4_decompress(void* dst, size_t dstCapacity, const void* src, size_t compressedSize)
 {
     LD_PROFILE_SCOPE;
 
     int result = ::LZ4_decompress_safe((const char*)src, (char*)dst, (int)compressedSize, (int)dstCapacity);
-    (void)result;
-    // TODO: validate
+
+    return result < 0 ? 0 : (size_t)result;
 }
 
 } // namespace LD
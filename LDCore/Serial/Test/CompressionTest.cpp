@@ -25,9 +25,12 @@ TEST_CASE("zstd")
     std::string restore;
     restore.resize(size);
 
-    LD::zstd_decompress(restore.data(), restore.size(), compressed.data(), compressed.size());
-
+    CHECK(LD::zstd_decompress(restore.data(), restore.size(), compressed.data(), compressed.size()) == size);
     CHECK(restore == std::string(sTinyPayload));
+
+    // malformed input and insufficient capacity are reported
+    CHECK(LD::zstd_decompress(restore.data(), restore.size(), compressed.data(), compressed.size() / 2) == 0);
+    CHECK(LD::zstd_decompress(restore.data(), restore.size() / 2, compressed.data(), compressed.size()) == 0);
 }
 
 TEST_CASE("lz4")
@@ -42,7 +45,10 @@ TEST_CASE("lz4")
     std::string restore;
     restore.resize(size);
 
-    LD::lz4_decompress(restore.data(), restore.size(), compressed.data(), compressed.size());
-
+    CHECK(LD::lz4_decompress(restore.data(), restore.size(), compressed.data(), compressed.size()) == size);
     CHECK(restore == std::string(sTinyPayload));
+
+    // malformed input and insufficient capacity are reported
+    CHECK(LD::lz4_decompress(restore.data(), restore.size(), compressed.data(), compressed.size() / 2) == 0);
+    CHECK(LD::lz4_decompress(restore.data(), restore.size() / 2, compressed.data(), compressed.size()) == 0);
 }
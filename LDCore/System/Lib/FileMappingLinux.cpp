@@ -0,0 +1,84 @@
+#include <Ludens/Header/Platform.h>
+#ifdef LD_PLATFORM_LINUX
+#include <Ludens/Memory/Memory.h>
+#include <Ludens/Profiler/Profiler.h>
+#include <Ludens/System/FileSystem.h>
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace LD {
+namespace FS {
+
+struct FileMappingObj
+{
+    void* data;
+    size_t size;
+};
+
+FileMapping FileMapping::create(const Path& path, String& err)
+{
+    LD_PROFILE_SCOPE;
+
+    int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+    {
+        err = "failed to open file: ";
+        err += strerror(errno);
+        return {};
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+    {
+        err = "failed to map empty or unknown size file";
+        close(fd);
+        return {};
+    }
+
+    size_t size = (size_t)st.st_size;
+    void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+    // the mapping keeps its own reference to the file
+    close(fd);
+
+    if (data == MAP_FAILED)
+    {
+        err = "failed to map file: ";
+        err += strerror(errno);
+        return {};
+    }
+
+    // asset files are consumed front to back right after mapping
+    (void)madvise(data, size, MADV_SEQUENTIAL);
+    (void)madvise(data, size, MADV_WILLNEED);
+
+    auto* obj = heap_new<FileMappingObj>(MEMORY_USAGE_MISC);
+    obj->data = data;
+    obj->size = size;
+
+    return FileMapping(obj);
+}
+
+void FileMapping::destroy(FileMapping mapping)
+{
+    FileMappingObj* obj = mapping.unwrap();
+
+    munmap(obj->data, obj->size);
+
+    heap_delete<FileMappingObj>(obj);
+}
+
+View FileMapping::view()
+{
+    return View((const byte*)mObj->data, mObj->size);
+}
+
+} // namespace FS
+} // namespace LD
+
+#endif // LD_PLATFORM_LINUX
@@ -0,0 +1,82 @@
+#include <Ludens/Header/Platform.h>
+#ifdef LD_PLATFORM_WIN32
+#include <Ludens/Memory/Memory.h>
+#include <Ludens/Profiler/Profiler.h>
+#include <Ludens/System/FileSystem.h>
+#include <Windows.h> // hide
+
+namespace LD {
+namespace FS {
+
+struct FileMappingObj
+{
+    HANDLE mappingHandle;
+    void* data;
+    size_t size;
+};
+
+FileMapping FileMapping::create(const Path& path, String& err)
+{
+    LD_PROFILE_SCOPE;
+
+    HANDLE fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE)
+    {
+        err = "failed to open file";
+        return {};
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart <= 0)
+    {
+        err = "failed to map empty or unknown size file";
+        CloseHandle(fileHandle);
+        return {};
+    }
+
+    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    // the mapping object keeps its own reference to the file
+    CloseHandle(fileHandle);
+
+    if (!mappingHandle)
+    {
+        err = "failed to create file mapping";
+        return {};
+    }
+
+    void* data = MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        err = "failed to map view of file";
+        CloseHandle(mappingHandle);
+        return {};
+    }
+
+    auto* obj = heap_new<FileMappingObj>(MEMORY_USAGE_MISC);
+    obj->mappingHandle = mappingHandle;
+    obj->data = data;
+    obj->size = (size_t)fileSize.QuadPart;
+
+    return FileMapping(obj);
+}
+
+void FileMapping::destroy(FileMapping mapping)
+{
+    FileMappingObj* obj = mapping.unwrap();
+
+    UnmapViewOfFile(obj->data);
+    CloseHandle(obj->mappingHandle);
+
+    heap_delete<FileMappingObj>(obj);
+}
+
+View FileMapping::view()
+{
+    return View((const byte*)mObj->data, mObj->size);
+}
+
+} // namespace FS
+} // namespace LD
+
+#endif // LD_PLATFORM_WIN32
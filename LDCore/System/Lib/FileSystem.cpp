@@ -2,11 +2,13 @@
 #include <Ludens/DSA/StringUtil.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/System/FileSystem.h>
+#include <Ludens/System/Process.h>
 
 #include <algorithm>
 #include <cstring>
 #include <format>
 #include <fstream>
+#include <thread>
 
 namespace fs = std::filesystem;
 
@@ -317,6 +319,31 @@ bool write_file_and_swap_backup(const Path& path, View view, String& err)
     return true;
 }
 
+Path get_unique_tmp_path(const Path& path)
+{
+    size_t threadHash = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+    Path tmpPath = path;
+    tmpPath += std::format(".{}.{:x}.tmp", get_process_id(), threadHash);
+
+    return tmpPath;
+}
+
+bool rename(const Path& src, const Path& dst, String& err)
+{
+    try
+    {
+        fs::rename(src, dst);
+    }
+    catch (const std::filesystem::filesystem_error& e)
+    {
+        err = std::format("failed to rename [{}] to [{}]\nfilesystem_error: {}", src.string(), dst.string(), e.what()).c_str();
+        return false;
+    }
+
+    return true;
+}
+
 bool exists(const Path& path)
 {
     return fs::exists(path);
@@ -21,6 +21,11 @@ void shell_open(const FS::Path& path)
     system(cmd.c_str());
 }
 
+uint32_t get_process_id()
+{
+    return (uint32_t)getpid();
+}
+
 struct ProcessObj
 {
     std::atomic_bool isRunning = false;
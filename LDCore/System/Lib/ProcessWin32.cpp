@@ -24,6 +24,11 @@ void shell_open(const FS::Path& path)
     ShellExecuteA(NULL, "open", pathStr.c_str(), NULL, NULL, SW_SHOWNORMAL);
 }
 
+uint32_t get_process_id()
+{
+    return (uint32_t)GetCurrentProcessId();
+}
+
 /// @brief Win32 process implementation.
 struct ProcessObj
 {
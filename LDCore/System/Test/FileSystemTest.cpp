@@ -3,6 +3,8 @@
 #include <Ludens/System/FileSystem.h>
 #include <LudensUtil/LudensLFS/LudensLFS.h>
 
+#include <cstring>
+#include <fstream>
 #include <string>
 
 using namespace LD;
@@ -37,4 +39,68 @@ TEST_CASE("FS get_positive_file_size" * doctest::skip(!LudensLFS::get_directory_
     uint64_t fileSize;
     CHECK_FALSE(FS::get_positive_file_size(sLudensLFS.test.emptyFilePath, fileSize, diag1));
     CHECK_FALSE(FS::get_positive_file_size(sLudensLFS.test.nonExistentFilePath, fileSize, diag2));
-}
\ No newline at end of file
+}
+
+TEST_CASE("FS FileMapping")
+{
+    String err;
+    FS::Path path = FS::temp_directory_path() / "ld_file_mapping_test.bin";
+    std::string str(10000, ' ');
+    for (size_t i = 0; i < str.size(); i++)
+        str[i] = (char)('a' + i % 26);
+
+    REQUIRE(FS::write_file(path, View(str.data(), str.size()), err));
+
+    FS::FileMapping mapping = FS::FileMapping::create(path, err);
+    REQUIRE(mapping);
+
+    View view = mapping.view();
+    CHECK(view.size == str.size());
+    CHECK(memcmp(view.data, str.data(), str.size()) == 0);
+
+    FS::FileMapping::destroy(mapping);
+
+    // empty files can not be mapped
+    std::ofstream(path, std::ios::binary | std::ios::trunc).close();
+    REQUIRE(FS::exists(path));
+    CHECK_FALSE(FS::FileMapping::create(path, err));
+
+    FS::remove(path, err);
+    CHECK_FALSE(FS::FileMapping::create(path, err));
+}
+
+TEST_CASE("FS rename")
+{
+    String err;
+    FS::Path path = FS::temp_directory_path() / "ld_rename_test.bin";
+    FS::Path tmpPath = FS::get_unique_tmp_path(path);
+    CHECK(tmpPath != path);
+    CHECK(tmpPath.parent_path() == path.parent_path());
+    CHECK(tmpPath == FS::get_unique_tmp_path(path));
+
+    REQUIRE(FS::write_file(path, View("old", 3), err));
+    REQUIRE(FS::write_file(tmpPath, View("new", 3), err));
+
+    // existing file is replaced
+    REQUIRE(FS::rename(tmpPath, path, err));
+    CHECK_FALSE(FS::exists(tmpPath));
+
+    Vector<byte> file;
+    REQUIRE(FS::read_file_to_vector(path, file, err));
+    CHECK(std::string((const char*)file.data(), file.size()) == "new");
+
+    CHECK_FALSE(FS::rename(tmpPath, path, err));
+    CHECK(!err.empty());
+
+    FS::remove(path, err);
+}
+
+TEST_CASE("FS FileMapping LFS" * doctest::skip(!LudensLFS::get_directory_path()))
+{
+    String err;
+    FS::FileMapping mapping = FS::FileMapping::create(sLudensLFS.test.emptyFilePath, err);
+    CHECK_FALSE(mapping);
+
+    mapping = FS::FileMapping::create(sLudensLFS.test.nonExistentFilePath, err);
+    CHECK_FALSE(mapping);
+}
@@ -8,6 +8,7 @@
 #include <Ludens/DataRegistry/DataRegistry.h>
 #include <Ludens/Header/Assert.h>
 #include <Ludens/Log/Log.h>
+#include <Ludens/Memory/Allocator.h>
 #include <Ludens/Memory/Memory.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/Project/Project.h>
@@ -654,6 +655,11 @@ EditorContext EditorContext::create(const EditorContextInfo& info)
     obj->fontMono = obj->fontRegistry.add_font(info.monoFontAtlas, info.monoFontAtlasImage);
     obj->docRegistry = DocumentRegistry::create();
 
+    FrameArenaInfo arenaI{};
+    arenaI.usage = MEMORY_USAGE_MISC;
+    arenaI.pageSize = 256 * 1024;
+    FrameArena::create(arenaI);
+
     for (size_t i = 0; i < info.projectScanResultCount; i++)
         obj->add_project_entry(info.projectScanResults[i]);
 
@@ -711,6 +717,7 @@ void EditorContext::destroy(EditorContext ctx)
     EditorSettings::destroy(obj->settings);
     AssetImporter::destroy(obj->assetImporter);
     AssetBuilder::destroy(obj->assetBuilder);
+    FrameArena::destroy();
 
     heap_delete<EditorContextObj>(obj);
 }
@@ -941,6 +948,9 @@ void EditorContext::update(const Vec2& sceneExtent, float delta)
 {
     LD_PROFILE_SCOPE;
 
+    // transient allocations from two frames ago are recycled
+    FrameArena::get().next_frame();
+
     mObj->update_project_load_async();
     mObj->update_asset_import_async();
 
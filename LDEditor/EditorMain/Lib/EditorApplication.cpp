@@ -64,6 +64,9 @@ EditorApplication::EditorApplication(const EditorApplicationInfo& info)
     RDeviceInfo deviceI{};
     deviceI.backend = RDEVICE_BACKEND_VULKAN;
     deviceI.vsync = info.vsync;
+    // compiled shaders and pipeline cache data persist across runs
+    std::string cacheDirectory = (FS::temp_directory_path() / FS::Path("LudensCache")).string();
+    deviceI.cacheDirectory = cacheDirectory.c_str();
     mRDevice = RDevice::create(deviceI);
 
     RenderSystemInfo serverI{};
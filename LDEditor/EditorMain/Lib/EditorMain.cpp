@@ -7,9 +7,11 @@
 
 #include "EditorApplication.h"
 
+#include <cstring>
 #include <iostream>
 
 #define ARGV_PROJECT_SCHEMA_PATH 0
+#define ARGV_HEAP_BACKEND 1
 
 namespace LD {
 
@@ -42,13 +44,19 @@ private:
 
 EditorArgs::EditorArgs(int argc, char** argv)
 {
-    Array<ArgOption, 1> options;
+    Array<ArgOption, 2> options;
     options[0] = {
         .index = ARGV_PROJECT_SCHEMA_PATH,
         .shortName = "p",
         .longName = "project",
         .payload = ARG_PAYLOAD_REQUIRED,
     };
+    options[1] = {
+        .index = ARGV_HEAP_BACKEND,
+        .shortName = nullptr,
+        .longName = "heap",
+        .payload = ARG_PAYLOAD_REQUIRED,
+    };
 
     mParser = ArgParser::create((int)options.size(), options.data());
     mParser.parse(argc - 1, (const char**)argv + 1);
@@ -64,6 +72,15 @@ EditorArgs::EditorArgs(int argc, char** argv)
         case ARGV_PROJECT_SCHEMA_PATH:
             mProjectSchemaPath = FS::Path(optPayload).lexically_normal();
             break;
+        case ARGV_HEAP_BACKEND:
+            // select the heap backend before the application allocates, e.g. --heap=slab
+            if (!strcmp(optPayload, "slab"))
+                heap_set_backend(HEAP_BACKEND_SLAB);
+            else if (!strcmp(optPayload, "system"))
+                heap_set_backend(HEAP_BACKEND_SYSTEM);
+            else
+                std::cout << "unknown heap backend " << optPayload << std::endl;
+            break;
         default:
             break;
         }
@@ -91,6 +108,8 @@ int main(int argc, char** argv)
         editorApp.run();
     }
 
+    LD::heap_trim();
+
     int count = LD::get_memory_leaks(nullptr);
 
     if (count > 0)
@@ -213,7 +213,7 @@ void EditorUI::on_screen_pass_overlay(ScreenRenderComponent renderer, TView<int>
     if (ctx.is_playing())
         return;
 
-    Vector<ComponentView> camera2Ds = scene.get_components(COMPONENT_TYPE_CAMERA_2D);
+    FrameVector<ComponentView> camera2Ds = scene.get_components(COMPONENT_TYPE_CAMERA_2D);
     ComponentView selectedComp = ctx.get_selected_component_view();
     const float thickness = 2.0f / editorCamera.get_zoom();
     Color hightlightColor;
@@ -1,9 +1,11 @@
+#include <Ludens/Asset/AssetPack.h>
 #include <Ludens/Asset/AssetRegistry.h>
 #include <Ludens/Asset/AssetSchema.h>
 #include <Ludens/Asset/AssetType/FontAsset.h>
 #include <Ludens/Asset/AssetType/TextureCubeAsset.h>
 #include <Ludens/AudioSystem/AudioSystem.h>
 #include <Ludens/Log/Log.h>
+#include <Ludens/Memory/Allocator.h>
 #include <Ludens/Profiler/Profiler.h>
 #include <Ludens/Project/Project.h>
 #include <Ludens/Project/ProjectContext.h>
@@ -82,6 +84,12 @@ bool RuntimeContextObj::startup(const RuntimeContextInfo& info, String err)
     amI.watchAssets = false;
     amI.env.registry = projectCtx.asset_registry();
     amI.env.rootPath = projectRootDir;
+
+    // shipped projects read all asset files from a single pack
+    FS::Path packPath = projectRootDir / FS::Path(LD_ASSET_PACK_DEFAULT_FILE_NAME);
+    if (FS::exists(packPath))
+        amI.packPath = packPath;
+
     AssetManager AM = AssetManager::create(amI);
     AM.begin_load_batch();
     AM.load_all_assets();
@@ -91,6 +99,9 @@ bool RuntimeContextObj::startup(const RuntimeContextInfo& info, String err)
         RDeviceInfo deviceI{};
         deviceI.backend = RDEVICE_BACKEND_VULKAN;
         deviceI.vsync = false; // TODO expose
+        // compiled shaders and pipeline cache data persist across runs
+        std::string cacheDirectory = (FS::temp_directory_path() / FS::Path("LudensCache")).string();
+        deviceI.cacheDirectory = cacheDirectory.c_str();
         renderDevice = RDevice::create(deviceI);
     }
 
@@ -154,6 +165,11 @@ bool RuntimeContextObj::startup(const RuntimeContextInfo& info, String err)
         return false;
     }
 
+    FrameArenaInfo arenaI{};
+    arenaI.usage = MEMORY_USAGE_MISC;
+    arenaI.pageSize = 256 * 1024;
+    FrameArena::create(arenaI);
+
     sLog.info("startup complete");
 
     return true;
@@ -164,6 +180,8 @@ void RuntimeContextObj::cleanup()
     renderDevice.wait_idle();
     scene.cleanup();
 
+    FrameArena::destroy();
+
     Scene::destroy();
     UIFontRegistry::destroy(fontRegistry);
     AudioSystem::destroy(audioSystem);
@@ -204,7 +222,7 @@ void RuntimeContextObj::render_frame(const Vec2& windowExtent)
     Vector<Viewport> screenViewports;
     Vector<Rect> aabbs;
     scene.get_screen_regions(screenViewports, aabbs);
-    Vector<RenderSystemScreenPass::Region> regions(screenViewports.size());
+    FrameVector<RenderSystemScreenPass::Region> regions(screenViewports.size());
     for (size_t i = 0; i < regions.size(); i++)
     {
         regions[i].viewport = screenViewports[i];
@@ -281,6 +299,9 @@ void RuntimeContext::update(float delta)
 {
     LD_PROFILE_SCOPE;
 
+    // transient allocations from two frames ago are recycled
+    FrameArena::get().next_frame();
+
     WindowRegistry reg = WindowRegistry::get();
 
     SceneUpdateTick tick{};
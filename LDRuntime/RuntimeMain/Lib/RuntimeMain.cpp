@@ -1,16 +1,19 @@
 #include <Ludens/CommandLine/ArgParser.h>
 #include <Ludens/Log/Log.h>
+#include <Ludens/Memory/Memory.h>
 #include <Ludens/Project/Project.h>
 #include <Ludens/Project/ProjectContext.h>
 #include <Ludens/Project/ProjectSchema.h>
 #include <Ludens/System/FileSystem.h>
 
 #include <array>
+#include <cstring>
 #include <format>
 
 #include "RuntimeApplication.h"
 
 #define ARGV_PROJECT_SCHEMA_PATH 0
+#define ARGV_HEAP_BACKEND 1
 
 using namespace LD;
 
@@ -41,13 +44,19 @@ private:
 RuntimeArgs::RuntimeArgs(int argc, char** argv)
     : mProjectSchemaPath("./project.toml")
 {
-    std::array<ArgOption, 1> options;
+    std::array<ArgOption, 2> options;
     options[0] = {
         .index = ARGV_PROJECT_SCHEMA_PATH,
         .shortName = "p",
         .longName = "project",
         .payload = ARG_PAYLOAD_REQUIRED,
     };
+    options[1] = {
+        .index = ARGV_HEAP_BACKEND,
+        .shortName = nullptr,
+        .longName = "heap",
+        .payload = ARG_PAYLOAD_REQUIRED,
+    };
 
     mParser = ArgParser::create((int)options.size(), options.data());
     mParser.parse(argc - 1, (const char**)argv + 1);
@@ -63,6 +72,15 @@ RuntimeArgs::RuntimeArgs(int argc, char** argv)
         case ARGV_PROJECT_SCHEMA_PATH:
             mProjectSchemaPath = FS::Path(optPayload).lexically_normal();
             break;
+        case ARGV_HEAP_BACKEND:
+            // select the heap backend before the application allocates, e.g. --heap=slab
+            if (!strcmp(optPayload, "slab"))
+                heap_set_backend(HEAP_BACKEND_SLAB);
+            else if (!strcmp(optPayload, "system"))
+                heap_set_backend(HEAP_BACKEND_SYSTEM);
+            else
+                sLog.warn("unknown heap backend {}", optPayload);
+            break;
         default:
             break;
         }
@@ -105,6 +123,8 @@ int main(int argc, char** argv)
         runtimeApp.cleanup();
     }
 
+    heap_trim();
+
     int count = get_memory_leaks(nullptr);
 
     if (count > 0)